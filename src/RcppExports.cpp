@@ -11,6 +11,73 @@ Rcpp::Rostream<true>&  Rcpp::Rcout = Rcpp::Rcpp_cout_get();
 Rcpp::Rostream<false>& Rcpp::Rcerr = Rcpp::Rcpp_cerr_get();
 #endif
 
+// process_chunks
+SEXP process_chunks(const GDALRaster* const& src_ds, const Rcpp::IntegerVector& src_bands, const Rcpp::NumericMatrix& chunks, const Rcpp::Nullable<Rcpp::Function>& fn, const Rcpp::RObject& dst_ds, const Rcpp::IntegerVector& dst_bands, int queue_depth, bool quiet);
+RcppExport SEXP _gdalraster_process_chunks(SEXP src_dsSEXP, SEXP src_bandsSEXP, SEXP chunksSEXP, SEXP fnSEXP, SEXP dst_dsSEXP, SEXP dst_bandsSEXP, SEXP queue_depthSEXP, SEXP quietSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const GDALRaster* const& >::type src_ds(src_dsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type src_bands(src_bandsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type chunks(chunksSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::Function>& >::type fn(fnSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::RObject& >::type dst_ds(dst_dsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type dst_bands(dst_bandsSEXP);
+    Rcpp::traits::input_parameter< int >::type queue_depth(queue_depthSEXP);
+    Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
+    rcpp_result_gen = Rcpp::wrap(process_chunks(src_ds, src_bands, chunks, fn, dst_ds, dst_bands, queue_depth, quiet));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ds_pool_info
+Rcpp::List ds_pool_info();
+RcppExport SEXP _gdalraster_ds_pool_info() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(ds_pool_info());
+    return rcpp_result_gen;
+END_RCPP
+}
+// ds_pool_set_size
+void ds_pool_set_size(int max_size);
+RcppExport SEXP _gdalraster_ds_pool_set_size(SEXP max_sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type max_size(max_sizeSEXP);
+    ds_pool_set_size(max_size);
+    return R_NilValue;
+END_RCPP
+}
+// ds_pool_clear
+void ds_pool_clear();
+RcppExport SEXP _gdalraster_ds_pool_clear() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    ds_pool_clear();
+    return R_NilValue;
+END_RCPP
+}
+// focal
+bool focal(const GDALRaster* const& src_ds, int band, GDALRaster* const& dst_ds, int dst_band, const Rcpp::IntegerVector& win_size, const std::string& stat, bool na_rm, double nodata_value, int num_threads, bool quiet);
+RcppExport SEXP _gdalraster_focal(SEXP src_dsSEXP, SEXP bandSEXP, SEXP dst_dsSEXP, SEXP dst_bandSEXP, SEXP win_sizeSEXP, SEXP statSEXP, SEXP na_rmSEXP, SEXP nodata_valueSEXP, SEXP num_threadsSEXP, SEXP quietSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const GDALRaster* const& >::type src_ds(src_dsSEXP);
+    Rcpp::traits::input_parameter< int >::type band(bandSEXP);
+    Rcpp::traits::input_parameter< GDALRaster* const& >::type dst_ds(dst_dsSEXP);
+    Rcpp::traits::input_parameter< int >::type dst_band(dst_bandSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type win_size(win_sizeSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type stat(statSEXP);
+    Rcpp::traits::input_parameter< bool >::type na_rm(na_rmSEXP);
+    Rcpp::traits::input_parameter< double >::type nodata_value(nodata_valueSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
+    rcpp_result_gen = Rcpp::wrap(focal(src_ds, band, dst_ds, dst_band, win_size, stat, na_rm, nodata_value, num_threads, quiet));
+    return rcpp_result_gen;
+END_RCPP
+}
 // dt_size
 int dt_size(const std::string& dt, bool as_bytes);
 RcppExport SEXP _gdalraster_dt_size(SEXP dtSEXP, SEXP as_bytesSEXP) {
@@ -538,8 +605,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // fillNodata
-bool fillNodata(const Rcpp::CharacterVector& filename, int band, const Rcpp::CharacterVector& mask_file, double max_dist, int smooth_iterations, bool quiet);
-RcppExport SEXP _gdalraster_fillNodata(SEXP filenameSEXP, SEXP bandSEXP, SEXP mask_fileSEXP, SEXP max_distSEXP, SEXP smooth_iterationsSEXP, SEXP quietSEXP) {
+SEXP fillNodata(const Rcpp::CharacterVector& filename, int band, const Rcpp::CharacterVector& mask_file, double max_dist, int smooth_iterations, const std::string& interpolation, int num_threads, const Rcpp::Nullable<Rcpp::IntegerVector>& tile_size, bool quiet);
+RcppExport SEXP _gdalraster_fillNodata(SEXP filenameSEXP, SEXP bandSEXP, SEXP mask_fileSEXP, SEXP max_distSEXP, SEXP smooth_iterationsSEXP, SEXP interpolationSEXP, SEXP num_threadsSEXP, SEXP tile_sizeSEXP, SEXP quietSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -548,8 +615,11 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type mask_file(mask_fileSEXP);
     Rcpp::traits::input_parameter< double >::type max_dist(max_distSEXP);
     Rcpp::traits::input_parameter< int >::type smooth_iterations(smooth_iterationsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type interpolation(interpolationSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::IntegerVector>& >::type tile_size(tile_sizeSEXP);
     Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
-    rcpp_result_gen = Rcpp::wrap(fillNodata(filename, band, mask_file, max_dist, smooth_iterations, quiet));
+    rcpp_result_gen = Rcpp::wrap(fillNodata(filename, band, mask_file, max_dist, smooth_iterations, interpolation, num_threads, tile_size, quiet));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -651,8 +721,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // sieveFilter
-bool sieveFilter(const Rcpp::CharacterVector& src_filename, int src_band, const Rcpp::CharacterVector& dst_filename, int dst_band, int size_threshold, int connectedness, const Rcpp::CharacterVector& mask_filename, int mask_band, const Rcpp::Nullable<Rcpp::CharacterVector>& options, bool quiet);
-RcppExport SEXP _gdalraster_sieveFilter(SEXP src_filenameSEXP, SEXP src_bandSEXP, SEXP dst_filenameSEXP, SEXP dst_bandSEXP, SEXP size_thresholdSEXP, SEXP connectednessSEXP, SEXP mask_filenameSEXP, SEXP mask_bandSEXP, SEXP optionsSEXP, SEXP quietSEXP) {
+bool sieveFilter(const Rcpp::CharacterVector& src_filename, int src_band, const Rcpp::CharacterVector& dst_filename, int dst_band, int size_threshold, int connectedness, const Rcpp::CharacterVector& mask_filename, int mask_band, const Rcpp::Nullable<Rcpp::CharacterVector>& options, int num_threads, const Rcpp::Nullable<Rcpp::IntegerVector>& tile_size, bool quiet);
+RcppExport SEXP _gdalraster_sieveFilter(SEXP src_filenameSEXP, SEXP src_bandSEXP, SEXP dst_filenameSEXP, SEXP dst_bandSEXP, SEXP size_thresholdSEXP, SEXP connectednessSEXP, SEXP mask_filenameSEXP, SEXP mask_bandSEXP, SEXP optionsSEXP, SEXP num_threadsSEXP, SEXP tile_sizeSEXP, SEXP quietSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -665,8 +735,10 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type mask_filename(mask_filenameSEXP);
     Rcpp::traits::input_parameter< int >::type mask_band(mask_bandSEXP);
     Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::CharacterVector>& >::type options(optionsSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::IntegerVector>& >::type tile_size(tile_sizeSEXP);
     Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
-    rcpp_result_gen = Rcpp::wrap(sieveFilter(src_filename, src_band, dst_filename, dst_band, size_threshold, connectedness, mask_filename, mask_band, options, quiet));
+    rcpp_result_gen = Rcpp::wrap(sieveFilter(src_filename, src_band, dst_filename, dst_band, size_threshold, connectedness, mask_filename, mask_band, options, num_threads, tile_size, quiet));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -847,6 +919,26 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// read_ds_bands
+SEXP read_ds_bands(const GDALRaster* const& ds, const Rcpp::IntegerVector& bands, int xoff, int yoff, int xsize, int ysize, int out_xsize, int out_ysize, const std::string& buf_type, const std::string& interleave);
+RcppExport SEXP _gdalraster_read_ds_bands(SEXP dsSEXP, SEXP bandsSEXP, SEXP xoffSEXP, SEXP yoffSEXP, SEXP xsizeSEXP, SEXP ysizeSEXP, SEXP out_xsizeSEXP, SEXP out_ysizeSEXP, SEXP buf_typeSEXP, SEXP interleaveSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const GDALRaster* const& >::type ds(dsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type bands(bandsSEXP);
+    Rcpp::traits::input_parameter< int >::type xoff(xoffSEXP);
+    Rcpp::traits::input_parameter< int >::type yoff(yoffSEXP);
+    Rcpp::traits::input_parameter< int >::type xsize(xsizeSEXP);
+    Rcpp::traits::input_parameter< int >::type ysize(ysizeSEXP);
+    Rcpp::traits::input_parameter< int >::type out_xsize(out_xsizeSEXP);
+    Rcpp::traits::input_parameter< int >::type out_ysize(out_ysizeSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type buf_type(buf_typeSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type interleave(interleaveSEXP);
+    rcpp_result_gen = Rcpp::wrap(read_ds_bands(ds, bands, xoff, yoff, xsize, ysize, out_xsize, out_ysize, buf_type, interleave));
+    return rcpp_result_gen;
+END_RCPP
+}
 // mdim_info
 std::string mdim_info(const Rcpp::CharacterVector& dsn, const std::string& array_name, bool pretty, bool detailed, int limit, bool stats, const Rcpp::Nullable<Rcpp::CharacterVector>& array_options, const Rcpp::Nullable<Rcpp::CharacterVector>& allowed_drivers, const Rcpp::Nullable<Rcpp::CharacterVector>& open_options, bool cout);
 RcppExport SEXP _gdalraster_mdim_info(SEXP dsnSEXP, SEXP array_nameSEXP, SEXP prettySEXP, SEXP detailedSEXP, SEXP limitSEXP, SEXP statsSEXP, SEXP array_optionsSEXP, SEXP allowed_driversSEXP, SEXP open_optionsSEXP, SEXP coutSEXP) {
@@ -889,6 +981,48 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// mdim_read
+Rcpp::List mdim_read(const Rcpp::CharacterVector& dsn, const std::string& array_name, const std::string& group_name, const Rcpp::Nullable<Rcpp::NumericVector>& start, const Rcpp::Nullable<Rcpp::NumericVector>& count, const Rcpp::Nullable<Rcpp::NumericVector>& step, int num_threads, const Rcpp::Nullable<Rcpp::CharacterVector>& allowed_drivers, const Rcpp::Nullable<Rcpp::CharacterVector>& open_options, bool quiet);
+RcppExport SEXP _gdalraster_mdim_read(SEXP dsnSEXP, SEXP array_nameSEXP, SEXP group_nameSEXP, SEXP startSEXP, SEXP countSEXP, SEXP stepSEXP, SEXP num_threadsSEXP, SEXP allowed_driversSEXP, SEXP open_optionsSEXP, SEXP quietSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type dsn(dsnSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type array_name(array_nameSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type group_name(group_nameSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::NumericVector>& >::type start(startSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::NumericVector>& >::type count(countSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::NumericVector>& >::type step(stepSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::CharacterVector>& >::type allowed_drivers(allowed_driversSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::CharacterVector>& >::type open_options(open_optionsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
+    rcpp_result_gen = Rcpp::wrap(mdim_read(dsn, array_name, group_name, start, count, step, num_threads, allowed_drivers, open_options, quiet));
+    return rcpp_result_gen;
+END_RCPP
+}
+// mdim_reduce
+bool mdim_reduce(const Rcpp::CharacterVector& dsn, const std::string& array_name, const std::string& group_name, int idx_xdim, int idx_ydim, GDALRaster* const& dst_ds, const std::vector<std::string>& stats, double nodata_value, int num_threads, const Rcpp::Nullable<Rcpp::CharacterVector>& allowed_drivers, const Rcpp::Nullable<Rcpp::CharacterVector>& open_options, bool quiet);
+RcppExport SEXP _gdalraster_mdim_reduce(SEXP dsnSEXP, SEXP array_nameSEXP, SEXP group_nameSEXP, SEXP idx_xdimSEXP, SEXP idx_ydimSEXP, SEXP dst_dsSEXP, SEXP statsSEXP, SEXP nodata_valueSEXP, SEXP num_threadsSEXP, SEXP allowed_driversSEXP, SEXP open_optionsSEXP, SEXP quietSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type dsn(dsnSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type array_name(array_nameSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type group_name(group_nameSEXP);
+    Rcpp::traits::input_parameter< int >::type idx_xdim(idx_xdimSEXP);
+    Rcpp::traits::input_parameter< int >::type idx_ydim(idx_ydimSEXP);
+    Rcpp::traits::input_parameter< GDALRaster* const& >::type dst_ds(dst_dsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type stats(statsSEXP);
+    Rcpp::traits::input_parameter< double >::type nodata_value(nodata_valueSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::CharacterVector>& >::type allowed_drivers(allowed_driversSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::CharacterVector>& >::type open_options(open_optionsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
+    rcpp_result_gen = Rcpp::wrap(mdim_reduce(dsn, array_name, group_name, idx_xdim, idx_ydim, dst_ds, stats, nodata_value, num_threads, allowed_drivers, open_options, quiet));
+    return rcpp_result_gen;
+END_RCPP
+}
 // vsi_copy_file
 int vsi_copy_file(const Rcpp::CharacterVector& src_file, const Rcpp::CharacterVector& target_file, bool show_progress);
 RcppExport SEXP _gdalraster_vsi_copy_file(SEXP src_fileSEXP, SEXP target_fileSEXP, SEXP show_progressSEXP) {
@@ -902,6 +1036,24 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// vsi_copy_batch
+Rcpp::DataFrame vsi_copy_batch(const Rcpp::CharacterVector& src_files, const Rcpp::CharacterVector& target_files, int num_threads, double chunk_size, int max_retries, double retry_delay, bool show_progress, const Rcpp::Nullable<Rcpp::CharacterVector>& options);
+RcppExport SEXP _gdalraster_vsi_copy_batch(SEXP src_filesSEXP, SEXP target_filesSEXP, SEXP num_threadsSEXP, SEXP chunk_sizeSEXP, SEXP max_retriesSEXP, SEXP retry_delaySEXP, SEXP show_progressSEXP, SEXP optionsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type src_files(src_filesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type target_files(target_filesSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< double >::type chunk_size(chunk_sizeSEXP);
+    Rcpp::traits::input_parameter< int >::type max_retries(max_retriesSEXP);
+    Rcpp::traits::input_parameter< double >::type retry_delay(retry_delaySEXP);
+    Rcpp::traits::input_parameter< bool >::type show_progress(show_progressSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::CharacterVector>& >::type options(optionsSEXP);
+    rcpp_result_gen = Rcpp::wrap(vsi_copy_batch(src_files, target_files, num_threads, chunk_size, max_retries, retry_delay, show_progress, options));
+    return rcpp_result_gen;
+END_RCPP
+}
 // vsi_curl_clear_cache
 void vsi_curl_clear_cache(bool partial, const Rcpp::CharacterVector& file_prefix, bool quiet);
 RcppExport SEXP _gdalraster_vsi_curl_clear_cache(SEXP partialSEXP, SEXP file_prefixSEXP, SEXP quietSEXP) {
@@ -940,6 +1092,21 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// vsi_list_dir
+Rcpp::DataFrame vsi_list_dir(const Rcpp::CharacterVector& path, int max_depth, std::string pattern, bool all_files, int num_threads);
+RcppExport SEXP _gdalraster_vsi_list_dir(SEXP pathSEXP, SEXP max_depthSEXP, SEXP patternSEXP, SEXP all_filesSEXP, SEXP num_threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< int >::type max_depth(max_depthSEXP);
+    Rcpp::traits::input_parameter< std::string >::type pattern(patternSEXP);
+    Rcpp::traits::input_parameter< bool >::type all_files(all_filesSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(vsi_list_dir(path, max_depth, pattern, all_files, num_threads));
+    return rcpp_result_gen;
+END_RCPP
+}
 // vsi_sync
 bool vsi_sync(const Rcpp::CharacterVector& src, const Rcpp::CharacterVector& target, bool show_progress, const Rcpp::Nullable<Rcpp::CharacterVector>& options);
 RcppExport SEXP _gdalraster_vsi_sync(SEXP srcSEXP, SEXP targetSEXP, SEXP show_progressSEXP, SEXP optionsSEXP) {
@@ -1974,6 +2141,53 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// label_regions_ds
+Rcpp::DataFrame label_regions_ds(const GDALRaster* const& ds, int band, int connectedness, const GDALRaster* const& dst_ds, const Rcpp::IntegerVector& tile_size, int num_threads, bool quiet);
+RcppExport SEXP _gdalraster_label_regions_ds(SEXP dsSEXP, SEXP bandSEXP, SEXP connectednessSEXP, SEXP dst_dsSEXP, SEXP tile_sizeSEXP, SEXP num_threadsSEXP, SEXP quietSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const GDALRaster* const& >::type ds(dsSEXP);
+    Rcpp::traits::input_parameter< int >::type band(bandSEXP);
+    Rcpp::traits::input_parameter< int >::type connectedness(connectednessSEXP);
+    Rcpp::traits::input_parameter< const GDALRaster* const& >::type dst_ds(dst_dsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type tile_size(tile_sizeSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
+    rcpp_result_gen = Rcpp::wrap(label_regions_ds(ds, band, connectedness, dst_ds, tile_size, num_threads, quiet));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ogr_ds_pool_enable
+void ogr_ds_pool_enable(bool enable, double idle_timeout);
+RcppExport SEXP _gdalraster_ogr_ds_pool_enable(SEXP enableSEXP, SEXP idle_timeoutSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< bool >::type enable(enableSEXP);
+    Rcpp::traits::input_parameter< double >::type idle_timeout(idle_timeoutSEXP);
+    ogr_ds_pool_enable(enable, idle_timeout);
+    return R_NilValue;
+END_RCPP
+}
+// ogr_ds_pool_info
+Rcpp::List ogr_ds_pool_info();
+RcppExport SEXP _gdalraster_ogr_ds_pool_info() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(ogr_ds_pool_info());
+    return rcpp_result_gen;
+END_RCPP
+}
+// ogr_ds_pool_clear
+void ogr_ds_pool_clear();
+RcppExport SEXP _gdalraster_ogr_ds_pool_clear() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    ogr_ds_pool_clear();
+    return R_NilValue;
+END_RCPP
+}
 // ogr_ds_exists
 bool ogr_ds_exists(const std::string& dsn, bool with_update);
 RcppExport SEXP _gdalraster_ogr_ds_exists(SEXP dsnSEXP, SEXP with_updateSEXP) {
@@ -2233,6 +2447,27 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// polygonize_tiles
+bool polygonize_tiles(const Rcpp::CharacterVector& src_filename, int src_band, const Rcpp::CharacterVector& out_dsn, const std::string& out_layer, const std::string& fld_name, const Rcpp::CharacterVector& mask_file, bool nomask, int connectedness, const Rcpp::IntegerVector& tile_size, int num_threads, bool quiet);
+RcppExport SEXP _gdalraster_polygonize_tiles(SEXP src_filenameSEXP, SEXP src_bandSEXP, SEXP out_dsnSEXP, SEXP out_layerSEXP, SEXP fld_nameSEXP, SEXP mask_fileSEXP, SEXP nomaskSEXP, SEXP connectednessSEXP, SEXP tile_sizeSEXP, SEXP num_threadsSEXP, SEXP quietSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type src_filename(src_filenameSEXP);
+    Rcpp::traits::input_parameter< int >::type src_band(src_bandSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type out_dsn(out_dsnSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type out_layer(out_layerSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type fld_name(fld_nameSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type mask_file(mask_fileSEXP);
+    Rcpp::traits::input_parameter< bool >::type nomask(nomaskSEXP);
+    Rcpp::traits::input_parameter< int >::type connectedness(connectednessSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type tile_size(tile_sizeSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
+    rcpp_result_gen = Rcpp::wrap(polygonize_tiles(src_filename, src_band, out_dsn, out_layer, fld_name, mask_file, nomask, connectedness, tile_size, num_threads, quiet));
+    return rcpp_result_gen;
+END_RCPP
+}
 // progress_bar_cleanup
 void progress_bar_cleanup();
 RcppExport SEXP _gdalraster_progress_bar_cleanup() {
@@ -2284,6 +2519,21 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// read_windows
+Rcpp::NumericVector read_windows(const GDALRaster* const& ds, const Rcpp::IntegerVector& bands, const Rcpp::IntegerMatrix& windows, int num_threads, bool quiet);
+RcppExport SEXP _gdalraster_read_windows(SEXP dsSEXP, SEXP bandsSEXP, SEXP windowsSEXP, SEXP num_threadsSEXP, SEXP quietSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const GDALRaster* const& >::type ds(dsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type bands(bandsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerMatrix& >::type windows(windowsSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
+    rcpp_result_gen = Rcpp::wrap(read_windows(ds, bands, windows, num_threads, quiet));
+    return rcpp_result_gen;
+END_RCPP
+}
 // epsg_to_wkt
 std::string epsg_to_wkt(int epsg, bool pretty);
 RcppExport SEXP _gdalraster_epsg_to_wkt(SEXP epsgSEXP, SEXP prettySEXP) {
@@ -2571,6 +2821,32 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// srs_query_batch
+Rcpp::DataFrame srs_query_batch(const Rcpp::CharacterVector& srs);
+RcppExport SEXP _gdalraster_srs_query_batch(SEXP srsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type srs(srsSEXP);
+    rcpp_result_gen = Rcpp::wrap(srs_query_batch(srs));
+    return rcpp_result_gen;
+END_RCPP
+}
+// srs_is_same_batch
+Rcpp::LogicalVector srs_is_same_batch(const Rcpp::CharacterVector& srs, const Rcpp::CharacterVector& srs_other, std::string criterion, bool ignore_axis_mapping, bool ignore_coord_epoch);
+RcppExport SEXP _gdalraster_srs_is_same_batch(SEXP srsSEXP, SEXP srs_otherSEXP, SEXP criterionSEXP, SEXP ignore_axis_mappingSEXP, SEXP ignore_coord_epochSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type srs(srsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type srs_other(srs_otherSEXP);
+    Rcpp::traits::input_parameter< std::string >::type criterion(criterionSEXP);
+    Rcpp::traits::input_parameter< bool >::type ignore_axis_mapping(ignore_axis_mappingSEXP);
+    Rcpp::traits::input_parameter< bool >::type ignore_coord_epoch(ignore_coord_epochSEXP);
+    rcpp_result_gen = Rcpp::wrap(srs_is_same_batch(srs, srs_other, criterion, ignore_axis_mapping, ignore_coord_epoch));
+    return rcpp_result_gen;
+END_RCPP
+}
 // srs_info_from_db
 Rcpp::DataFrame srs_info_from_db(const std::string& auth_name);
 RcppExport SEXP _gdalraster_srs_info_from_db(SEXP auth_nameSEXP) {
@@ -2582,6 +2858,35 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// srs_cache_info
+Rcpp::List srs_cache_info();
+RcppExport SEXP _gdalraster_srs_cache_info() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(srs_cache_info());
+    return rcpp_result_gen;
+END_RCPP
+}
+// srs_cache_set_size
+void srs_cache_set_size(int max_size);
+RcppExport SEXP _gdalraster_srs_cache_set_size(SEXP max_sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type max_size(max_sizeSEXP);
+    srs_cache_set_size(max_size);
+    return R_NilValue;
+END_RCPP
+}
+// srs_cache_clear
+void srs_cache_clear();
+RcppExport SEXP _gdalraster_srs_cache_clear() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    srs_cache_clear();
+    return R_NilValue;
+END_RCPP
+}
 // getPROJVersion
 std::vector<int> getPROJVersion();
 RcppExport SEXP _gdalraster_getPROJVersion() {
@@ -2673,6 +2978,66 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// warp_tiles
+Rcpp::DataFrame warp_tiles(const Rcpp::CharacterVector& src_files, GDALRaster* const& dst_ds, const Rcpp::IntegerVector& tile_size, const Rcpp::Nullable<Rcpp::CharacterVector>& cl_arg, int num_threads, bool quiet);
+RcppExport SEXP _gdalraster_warp_tiles(SEXP src_filesSEXP, SEXP dst_dsSEXP, SEXP tile_sizeSEXP, SEXP cl_argSEXP, SEXP num_threadsSEXP, SEXP quietSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type src_files(src_filesSEXP);
+    Rcpp::traits::input_parameter< GDALRaster* const& >::type dst_ds(dst_dsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type tile_size(tile_sizeSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::Nullable<Rcpp::CharacterVector>& >::type cl_arg(cl_argSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
+    rcpp_result_gen = Rcpp::wrap(warp_tiles(src_files, dst_ds, tile_size, cl_arg, num_threads, quiet));
+    return rcpp_result_gen;
+END_RCPP
+}
+// warped_vrt_pool_info
+Rcpp::List warped_vrt_pool_info();
+RcppExport SEXP _gdalraster_warped_vrt_pool_info() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(warped_vrt_pool_info());
+    return rcpp_result_gen;
+END_RCPP
+}
+// warped_vrt_pool_set_size
+void warped_vrt_pool_set_size(int max_idle);
+RcppExport SEXP _gdalraster_warped_vrt_pool_set_size(SEXP max_idleSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type max_idle(max_idleSEXP);
+    warped_vrt_pool_set_size(max_idle);
+    return R_NilValue;
+END_RCPP
+}
+// warped_vrt_pool_clear
+void warped_vrt_pool_clear();
+RcppExport SEXP _gdalraster_warped_vrt_pool_clear() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    warped_vrt_pool_clear();
+    return R_NilValue;
+END_RCPP
+}
+// zonal_stats
+Rcpp::DataFrame zonal_stats(const GDALVector* const& lyr, const GDALRaster* const& ds, int band, int num_threads, bool quiet);
+RcppExport SEXP _gdalraster_zonal_stats(SEXP lyrSEXP, SEXP dsSEXP, SEXP bandSEXP, SEXP num_threadsSEXP, SEXP quietSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const GDALVector* const& >::type lyr(lyrSEXP);
+    Rcpp::traits::input_parameter< const GDALRaster* const& >::type ds(dsSEXP);
+    Rcpp::traits::input_parameter< int >::type band(bandSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< bool >::type quiet(quietSEXP);
+    rcpp_result_gen = Rcpp::wrap(zonal_stats(lyr, ds, band, num_threads, quiet));
+    return rcpp_result_gen;
+END_RCPP
+}
 
 RcppExport SEXP _rcpp_module_boot_mod_cmb_table();
 RcppExport SEXP _rcpp_module_boot_mod_GDALAlg();
@@ -2682,6 +3047,11 @@ RcppExport SEXP _rcpp_module_boot_mod_running_stats();
 RcppExport SEXP _rcpp_module_boot_mod_VSIFile();
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_gdalraster_process_chunks", (DL_FUNC) &_gdalraster_process_chunks, 8},
+    {"_gdalraster_ds_pool_info", (DL_FUNC) &_gdalraster_ds_pool_info, 0},
+    {"_gdalraster_ds_pool_set_size", (DL_FUNC) &_gdalraster_ds_pool_set_size, 1},
+    {"_gdalraster_ds_pool_clear", (DL_FUNC) &_gdalraster_ds_pool_clear, 0},
+    {"_gdalraster_focal", (DL_FUNC) &_gdalraster_focal, 10},
     {"_gdalraster_dt_size", (DL_FUNC) &_gdalraster_dt_size, 2},
     {"_gdalraster_dt_is_complex", (DL_FUNC) &_gdalraster_dt_is_complex, 1},
     {"_gdalraster_dt_is_integer", (DL_FUNC) &_gdalraster_dt_is_integer, 1},
@@ -2727,14 +3097,14 @@ static const R_CallMethodDef CallEntries[] = {
     {"_gdalraster_combine", (DL_FUNC) &_gdalraster_combine, 8},
     {"_gdalraster_value_count", (DL_FUNC) &_gdalraster_value_count, 3},
     {"_gdalraster_dem_proc", (DL_FUNC) &_gdalraster_dem_proc, 6},
-    {"_gdalraster_fillNodata", (DL_FUNC) &_gdalraster_fillNodata, 6},
+    {"_gdalraster_fillNodata", (DL_FUNC) &_gdalraster_fillNodata, 9},
     {"_gdalraster_footprint", (DL_FUNC) &_gdalraster_footprint, 3},
     {"_gdalraster_isLineOfSightVisible", (DL_FUNC) &_gdalraster_isLineOfSightVisible, 9},
     {"_gdalraster_ogr2ogr", (DL_FUNC) &_gdalraster_ogr2ogr, 5},
     {"_gdalraster_ogrinfo", (DL_FUNC) &_gdalraster_ogrinfo, 6},
     {"_gdalraster_polygonize", (DL_FUNC) &_gdalraster_polygonize, 9},
     {"_gdalraster_rasterize", (DL_FUNC) &_gdalraster_rasterize, 5},
-    {"_gdalraster_sieveFilter", (DL_FUNC) &_gdalraster_sieveFilter, 10},
+    {"_gdalraster_sieveFilter", (DL_FUNC) &_gdalraster_sieveFilter, 12},
     {"_gdalraster_translate", (DL_FUNC) &_gdalraster_translate, 4},
     {"_gdalraster_warp", (DL_FUNC) &_gdalraster_warp, 6},
     {"_gdalraster_createColorRamp", (DL_FUNC) &_gdalraster_createColorRamp, 5},
@@ -2748,12 +3118,17 @@ static const R_CallMethodDef CallEntries[] = {
     {"_gdalraster_gdal_get_driver_md", (DL_FUNC) &_gdalraster_gdal_get_driver_md, 2},
     {"_gdalraster_addFileInZip", (DL_FUNC) &_gdalraster_addFileInZip, 6},
     {"_gdalraster_gt_from_dim_bbox_", (DL_FUNC) &_gdalraster_gt_from_dim_bbox_, 2},
+    {"_gdalraster_read_ds_bands", (DL_FUNC) &_gdalraster_read_ds_bands, 10},
     {"_gdalraster_mdim_info", (DL_FUNC) &_gdalraster_mdim_info, 10},
     {"_gdalraster_mdim_translate", (DL_FUNC) &_gdalraster_mdim_translate, 12},
+    {"_gdalraster_mdim_read", (DL_FUNC) &_gdalraster_mdim_read, 10},
+    {"_gdalraster_mdim_reduce", (DL_FUNC) &_gdalraster_mdim_reduce, 12},
     {"_gdalraster_vsi_copy_file", (DL_FUNC) &_gdalraster_vsi_copy_file, 3},
+    {"_gdalraster_vsi_copy_batch", (DL_FUNC) &_gdalraster_vsi_copy_batch, 8},
     {"_gdalraster_vsi_curl_clear_cache", (DL_FUNC) &_gdalraster_vsi_curl_clear_cache, 3},
     {"_gdalraster_vsi_read_dir", (DL_FUNC) &_gdalraster_vsi_read_dir, 4},
     {"_gdalraster_vsi_glob", (DL_FUNC) &_gdalraster_vsi_glob, 2},
+    {"_gdalraster_vsi_list_dir", (DL_FUNC) &_gdalraster_vsi_list_dir, 5},
     {"_gdalraster_vsi_sync", (DL_FUNC) &_gdalraster_vsi_sync, 4},
     {"_gdalraster_vsi_mkdir", (DL_FUNC) &_gdalraster_vsi_mkdir, 3},
     {"_gdalraster_vsi_rmdir", (DL_FUNC) &_gdalraster_vsi_rmdir, 2},
@@ -2834,6 +3209,10 @@ static const R_CallMethodDef CallEntries[] = {
     {"_gdalraster_g_transform", (DL_FUNC) &_gdalraster_g_transform, 9},
     {"_gdalraster_bbox_from_wkt", (DL_FUNC) &_gdalraster_bbox_from_wkt, 3},
     {"_gdalraster_bbox_to_wkt", (DL_FUNC) &_gdalraster_bbox_to_wkt, 3},
+    {"_gdalraster_label_regions_ds", (DL_FUNC) &_gdalraster_label_regions_ds, 7},
+    {"_gdalraster_ogr_ds_pool_enable", (DL_FUNC) &_gdalraster_ogr_ds_pool_enable, 2},
+    {"_gdalraster_ogr_ds_pool_info", (DL_FUNC) &_gdalraster_ogr_ds_pool_info, 0},
+    {"_gdalraster_ogr_ds_pool_clear", (DL_FUNC) &_gdalraster_ogr_ds_pool_clear, 0},
     {"_gdalraster_ogr_ds_exists", (DL_FUNC) &_gdalraster_ogr_ds_exists, 2},
     {"_gdalraster_ogr_ds_format", (DL_FUNC) &_gdalraster_ogr_ds_format, 1},
     {"_gdalraster_ogr_ds_test_cap", (DL_FUNC) &_gdalraster_ogr_ds_test_cap, 2},
@@ -2854,10 +3233,12 @@ static const R_CallMethodDef CallEntries[] = {
     {"_gdalraster_ogr_field_set_domain_name", (DL_FUNC) &_gdalraster_ogr_field_set_domain_name, 4},
     {"_gdalraster_ogr_field_delete", (DL_FUNC) &_gdalraster_ogr_field_delete, 3},
     {"_gdalraster_ogr_execute_sql", (DL_FUNC) &_gdalraster_ogr_execute_sql, 4},
+    {"_gdalraster_polygonize_tiles", (DL_FUNC) &_gdalraster_polygonize_tiles, 11},
     {"_gdalraster_progress_bar_cleanup", (DL_FUNC) &_gdalraster_progress_bar_cleanup, 0},
     {"_gdalraster_rasterize_polygon", (DL_FUNC) &_gdalraster_rasterize_polygon, 8},
     {"_gdalraster_get_data_ptr", (DL_FUNC) &_gdalraster_get_data_ptr, 1},
     {"_gdalraster_equal_within_ulps_r_", (DL_FUNC) &_gdalraster_equal_within_ulps_r_, 3},
+    {"_gdalraster_read_windows", (DL_FUNC) &_gdalraster_read_windows, 5},
     {"_gdalraster_epsg_to_wkt", (DL_FUNC) &_gdalraster_epsg_to_wkt, 2},
     {"_gdalraster_srs_to_wkt", (DL_FUNC) &_gdalraster_srs_to_wkt, 3},
     {"_gdalraster_srs_to_projjson", (DL_FUNC) &_gdalraster_srs_to_projjson, 4},
@@ -2883,7 +3264,12 @@ static const R_CallMethodDef CallEntries[] = {
     {"_gdalraster_srs_epsg_treats_as_lat_long", (DL_FUNC) &_gdalraster_srs_epsg_treats_as_lat_long, 1},
     {"_gdalraster_srs_epsg_treats_as_northing_easting", (DL_FUNC) &_gdalraster_srs_epsg_treats_as_northing_easting, 1},
     {"_gdalraster_srs_get_celestial_body_name", (DL_FUNC) &_gdalraster_srs_get_celestial_body_name, 1},
+    {"_gdalraster_srs_query_batch", (DL_FUNC) &_gdalraster_srs_query_batch, 1},
+    {"_gdalraster_srs_is_same_batch", (DL_FUNC) &_gdalraster_srs_is_same_batch, 5},
     {"_gdalraster_srs_info_from_db", (DL_FUNC) &_gdalraster_srs_info_from_db, 1},
+    {"_gdalraster_srs_cache_info", (DL_FUNC) &_gdalraster_srs_cache_info, 0},
+    {"_gdalraster_srs_cache_set_size", (DL_FUNC) &_gdalraster_srs_cache_set_size, 1},
+    {"_gdalraster_srs_cache_clear", (DL_FUNC) &_gdalraster_srs_cache_clear, 0},
     {"_gdalraster_getPROJVersion", (DL_FUNC) &_gdalraster_getPROJVersion, 0},
     {"_gdalraster_getPROJSearchPaths", (DL_FUNC) &_gdalraster_getPROJSearchPaths, 0},
     {"_gdalraster_setPROJSearchPaths", (DL_FUNC) &_gdalraster_setPROJSearchPaths, 1},
@@ -2892,6 +3278,11 @@ static const R_CallMethodDef CallEntries[] = {
     {"_gdalraster_inv_project", (DL_FUNC) &_gdalraster_inv_project, 3},
     {"_gdalraster_transform_xy", (DL_FUNC) &_gdalraster_transform_xy, 3},
     {"_gdalraster_transform_bounds", (DL_FUNC) &_gdalraster_transform_bounds, 5},
+    {"_gdalraster_warp_tiles", (DL_FUNC) &_gdalraster_warp_tiles, 6},
+    {"_gdalraster_warped_vrt_pool_info", (DL_FUNC) &_gdalraster_warped_vrt_pool_info, 0},
+    {"_gdalraster_warped_vrt_pool_set_size", (DL_FUNC) &_gdalraster_warped_vrt_pool_set_size, 1},
+    {"_gdalraster_warped_vrt_pool_clear", (DL_FUNC) &_gdalraster_warped_vrt_pool_clear, 0},
+    {"_gdalraster_zonal_stats", (DL_FUNC) &_gdalraster_zonal_stats, 5},
     {"_rcpp_module_boot_mod_cmb_table", (DL_FUNC) &_rcpp_module_boot_mod_cmb_table, 0},
     {"_rcpp_module_boot_mod_GDALAlg", (DL_FUNC) &_rcpp_module_boot_mod_GDALAlg, 0},
     {"_rcpp_module_boot_mod_GDALRaster", (DL_FUNC) &_rcpp_module_boot_mod_GDALRaster, 0},
@@ -2902,8 +3293,10 @@ static const R_CallMethodDef CallEntries[] = {
 };
 
 void gdal_init(DllInfo *dll);
+void mmap_altrep_init(DllInfo *dll);
 RcppExport void R_init_gdalraster(DllInfo *dll) {
     R_registerRoutines(dll, NULL, CallEntries, NULL, NULL);
     R_useDynamicSymbols(dll, FALSE);
     gdal_init(dll);
+    mmap_altrep_init(dll);
 }
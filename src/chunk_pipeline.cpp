@@ -0,0 +1,341 @@
+/* Pipelined read-compute-write over the chunks of a raster
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+
+#include <Rcpp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "chunk_pipeline.h"
+#include "gdalraster.h"
+#include "rcpp_util.h"
+#include "thread_util.h"
+
+ChunkPipeline_::ChunkPipeline_(GDALDatasetH hSrcDS,
+                               const std::vector<int> &src_bands,
+                               GDALDatasetH hDstDS,
+                               const std::vector<int> &dst_bands,
+                               const std::vector<ChunkDef_> &chunks,
+                               int queue_depth)
+        : m_hSrcDS(hSrcDS), m_hDstDS(hDstDS), m_src_bands(src_bands),
+          m_dst_bands(dst_bands), m_chunks(chunks),
+          m_queue_depth(static_cast<std::size_t>(std::max(queue_depth, 1))) {}
+
+ChunkPipeline_::~ChunkPipeline_() {
+    stop_();
+}
+
+void ChunkPipeline_::start() {
+    if (m_io_thread.joinable())
+        return;
+    m_io_thread = std::thread(&ChunkPipeline_::ioLoop_, this);
+}
+
+bool ChunkPipeline_::next(std::size_t *chunk_idx, std::vector<double> *data) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_next_consume >= m_chunks.size())
+        return false;
+
+    m_cv.wait(lock, [this] { return m_failed || !m_ready.empty(); });
+    if (m_failed)
+        throw std::runtime_error(m_err_msg);
+
+    *chunk_idx = m_ready.front().idx;
+    data->swap(m_ready.front().data);
+    m_ready.pop_front();
+    ++m_next_consume;
+    lock.unlock();
+    m_cv.notify_all();
+    return true;
+}
+
+void ChunkPipeline_::write(std::size_t chunk_idx, std::vector<double> &&data) {
+    if (m_hDstDS == nullptr)
+        throw std::runtime_error("the pipeline has no destination dataset");
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] {
+        return m_failed || m_pending_writes.size() < m_queue_depth;
+    });
+    if (m_failed)
+        throw std::runtime_error(m_err_msg);
+
+    m_pending_writes.push_back(Item_ {chunk_idx, std::move(data)});
+    lock.unlock();
+    m_cv.notify_all();
+}
+
+void ChunkPipeline_::finish() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_no_more_writes = true;
+    }
+    m_cv.notify_all();
+    if (m_io_thread.joinable())
+        m_io_thread.join();
+    throwIfFailed_();
+}
+
+void ChunkPipeline_::stop_() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_io_thread.joinable())
+        m_io_thread.join();
+}
+
+void ChunkPipeline_::throwIfFailed_() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_failed)
+        throw std::runtime_error(m_err_msg);
+}
+
+void ChunkPipeline_::readChunk_(std::size_t idx, std::vector<double> *data) {
+    const ChunkDef_ &c = m_chunks[idx];
+    const int nbands = static_cast<int>(m_src_bands.size());
+    data->resize(static_cast<std::size_t>(c.xsize) * c.ysize * nbands);
+
+    CPLErr err = GDALDatasetRasterIO(
+        m_hSrcDS, GF_Read, c.xoff, c.yoff, c.xsize, c.ysize, data->data(),
+        c.xsize, c.ysize, GDT_Float64, nbands, m_src_bands.data(), 0, 0, 0);
+
+    if (err != CE_None) {
+        throw std::runtime_error(std::string("read raster failed: ") +
+                                 CPLGetLastErrorMsg());
+    }
+}
+
+void ChunkPipeline_::writeChunk_(std::size_t idx,
+                                 const std::vector<double> &data) {
+    const ChunkDef_ &c = m_chunks[idx];
+    const int nbands = static_cast<int>(m_dst_bands.size());
+
+    CPLErr err = GDALDatasetRasterIO(
+        m_hDstDS, GF_Write, c.xoff, c.yoff, c.xsize, c.ysize,
+        const_cast<double *>(data.data()), c.xsize, c.ysize, GDT_Float64,
+        nbands, const_cast<int *>(m_dst_bands.data()), 0, 0, 0);
+
+    if (err != CE_None) {
+        throw std::runtime_error(std::string("write raster failed: ") +
+                                 CPLGetLastErrorMsg());
+    }
+}
+
+// runs on the I/O thread: must not call into R
+void ChunkPipeline_::ioLoop_() {
+    QuietErrorHandlerGuard_ quiet_errors;
+    const std::size_t num_chunks = m_chunks.size();
+
+    while (true) {
+        bool do_read = false;
+        Item_ item {0, {}};
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto can_read = [&] {
+                return m_next_read < num_chunks &&
+                       m_ready.size() < m_queue_depth;
+            };
+            m_cv.wait(lock, [&] {
+                return m_stop || can_read() || !m_pending_writes.empty() ||
+                       m_no_more_writes;
+            });
+
+            if (m_stop)
+                return;
+
+            // reads take priority when the consumer has nothing ready,
+            // otherwise drain writes first to free their buffers
+            if (can_read() &&
+                    (m_ready.empty() || m_pending_writes.empty())) {
+                do_read = true;
+                item.idx = m_next_read++;
+            }
+            else if (!m_pending_writes.empty()) {
+                item = std::move(m_pending_writes.front());
+                m_pending_writes.pop_front();
+            }
+            else if (m_no_more_writes) {
+                return;
+            }
+            else {
+                continue;
+            }
+        }
+
+        try {
+            if (do_read)
+                readChunk_(item.idx, &item.data);
+            else
+                writeChunk_(item.idx, item.data);
+        }
+        catch (const std::exception &e) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_failed = true;
+                m_err_msg = e.what();
+            }
+            m_cv.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (do_read)
+                m_ready.push_back(std::move(item));
+        }
+        m_cv.notify_all();
+    }
+}
+
+//' Process the chunks of a raster with pipelined I/O
+//'
+//' Called from and documented in R/process_chunks.R
+//' @noRd
+// [[Rcpp::export(name = ".process_chunks")]]
+SEXP process_chunks(const GDALRaster* const &src_ds,
+                    const Rcpp::IntegerVector &src_bands,
+                    const Rcpp::NumericMatrix &chunks,
+                    const Rcpp::Nullable<Rcpp::Function> &fn,
+                    const Rcpp::RObject &dst_ds,
+                    const Rcpp::IntegerVector &dst_bands,
+                    int queue_depth, bool quiet) {
+
+    src_ds->checkAccess_(GA_ReadOnly);
+
+    if (chunks.ncol() < 6)
+        Rcpp::stop("'chunks' must be a matrix as returned by "
+                   "make_chunk_index()");
+
+    std::vector<int> bands_in(src_bands.begin(), src_bands.end());
+    std::vector<double> nodata(bands_in.size());
+    std::vector<bool> has_nodata(bands_in.size());
+    for (std::size_t i = 0; i < bands_in.size(); ++i) {
+        GDALRasterBandH hBand = src_ds->getBand_(bands_in[i]);
+        int has = FALSE;
+        nodata[i] = GDALGetRasterNoDataValue(hBand, &has);
+        has_nodata[i] = has && !std::isnan(nodata[i]);
+    }
+
+    GDALRaster *dst = nullptr;
+    std::vector<int> bands_out;
+    if (!dst_ds.isNULL()) {
+        dst = Rcpp::as<GDALRaster *>(dst_ds);
+        dst->checkAccess_(GA_Update);
+        bands_out.assign(dst_bands.begin(), dst_bands.end());
+        for (int b : bands_out)
+            dst->getBand_(b);
+    }
+
+    const bool has_fn = fn.isNotNull();
+    if (!has_fn && dst == nullptr)
+        Rcpp::stop("'fn' is required if there is no destination dataset");
+    if (!has_fn && bands_out.size() != bands_in.size())
+        Rcpp::stop("the number of source and destination bands must be the "
+                   "same to copy without 'fn'");
+
+    std::vector<ChunkDef_> chunk_defs(chunks.nrow());
+    for (int i = 0; i < chunks.nrow(); ++i) {
+        chunk_defs[i] = ChunkDef_ {static_cast<int>(chunks(i, 2)),
+                                   static_cast<int>(chunks(i, 3)),
+                                   static_cast<int>(chunks(i, 4)),
+                                   static_cast<int>(chunks(i, 5))};
+        if (chunk_defs[i].xsize < 1 || chunk_defs[i].ysize < 1)
+            Rcpp::stop("invalid chunk size in row %d of 'chunks'", i + 1);
+    }
+
+    const std::size_t num_chunks = chunk_defs.size();
+    Rcpp::List results;
+    if (has_fn && dst == nullptr)
+        results = Rcpp::List(num_chunks);
+
+    GDALDatasetH hDstDS = dst ? dst->getGDALDatasetH_() : nullptr;
+    ChunkPipeline_ pipeline(src_ds->getGDALDatasetH_(), bands_in, hDstDS,
+                            bands_out, chunk_defs, queue_depth);
+
+    if (!quiet)
+        GDALTermProgressR(0.0, nullptr, nullptr);
+
+    try {
+        pipeline.start();
+        std::size_t idx = 0;
+        std::vector<double> data;
+        while (pipeline.next(&idx, &data)) {
+            if (!has_fn) {
+                pipeline.write(idx, std::move(data));
+            }
+            else {
+                const ChunkDef_ &c = chunk_defs[idx];
+                const std::size_t band_len =
+                    static_cast<std::size_t>(c.xsize) * c.ysize;
+                Rcpp::NumericVector x(data.begin(), data.end());
+                for (std::size_t b = 0; b < bands_in.size(); ++b) {
+                    if (!has_nodata[b])
+                        continue;
+                    double *p = x.begin() + b * band_len;
+                    for (std::size_t j = 0; j < band_len; ++j) {
+                        if (p[j] == nodata[b])
+                            p[j] = NA_REAL;
+                    }
+                }
+
+                Rcpp::NumericVector chunk_def = chunks(idx, Rcpp::_);
+                chunk_def.names() = Rcpp::colnames(chunks);
+                Rcpp::Function f(fn.get());
+                Rcpp::RObject res = f(x, chunk_def);
+
+                if (dst != nullptr) {
+                    if (!Rcpp::is<Rcpp::NumericVector>(res) &&
+                            !Rcpp::is<Rcpp::IntegerVector>(res) &&
+                            !Rcpp::is<Rcpp::LogicalVector>(res)) {
+                        Rcpp::stop("'fn' must return a numeric vector");
+                    }
+                    Rcpp::NumericVector v = Rcpp::as<Rcpp::NumericVector>(res);
+                    if (static_cast<std::size_t>(v.size()) !=
+                            band_len * bands_out.size()) {
+                        Rcpp::stop("length of the vector returned by 'fn' "
+                                   "does not match the chunk size");
+                    }
+                    pipeline.write(idx, std::vector<double>(v.begin(),
+                                                            v.end()));
+                }
+                else {
+                    results[idx] = res;
+                }
+            }
+
+            if (!quiet) {
+                GDALTermProgressR(static_cast<double>(idx + 1) / num_chunks,
+                                  nullptr, nullptr);
+            }
+            Rcpp::checkUserInterrupt();
+        }
+        pipeline.finish();
+    }
+    catch (const std::runtime_error &e) {
+        Rcpp::stop(e.what());
+    }
+
+    if (!quiet && num_chunks == 0)
+        GDALTermProgressR(1.0, nullptr, nullptr);
+
+    if (dst == nullptr)
+        return results;
+    else
+        return Rcpp::wrap(true);
+}
@@ -0,0 +1,101 @@
+/* Pipelined read-compute-write over the chunks of a raster
+
+   ChunkPipeline_ runs all GDAL I/O for a sequence of chunks on one background
+   I/O thread. It reads ahead up to queue_depth chunks while the caller
+   computes on the current chunk, and writes computed chunks behind, with
+   bounded queues in both directions. The caller (normally the main thread,
+   so that R callbacks can be used) consumes chunks in order with next(),
+   and hands back output with write(). Native compute can itself be split
+   across a worker pool with parallel_for_() in src/thread_util.h.
+
+   Since one thread performs all of the I/O, the source and destination may
+   be the same dataset (update in place). The dataset handles must not be
+   used by any other thread while the pipeline is running.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef CHUNK_PIPELINE_H_
+#define CHUNK_PIPELINE_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gdalraster.h"
+
+struct ChunkDef_ {
+    int xoff;
+    int yoff;
+    int xsize;
+    int ysize;
+};
+
+class ChunkPipeline_ {
+ public:
+    // hDstDS may be nullptr for read-only pipelines (no write stage)
+    // pixel data are Float64, band sequential within a chunk
+    ChunkPipeline_(GDALDatasetH hSrcDS, const std::vector<int> &src_bands,
+                   GDALDatasetH hDstDS, const std::vector<int> &dst_bands,
+                   const std::vector<ChunkDef_> &chunks, int queue_depth);
+    ~ChunkPipeline_();
+    ChunkPipeline_(const ChunkPipeline_ &) = delete;
+    ChunkPipeline_ &operator=(const ChunkPipeline_ &) = delete;
+
+    void start();
+
+    // Blocks until the next chunk (in order) has been read. Returns false
+    // when all chunks have been consumed. Throws std::runtime_error if the
+    // I/O thread failed.
+    bool next(std::size_t *chunk_idx, std::vector<double> *data);
+
+    // Queue output data for a chunk to be written. Blocks while the write
+    // queue is full. Throws std::runtime_error if the I/O thread failed.
+    void write(std::size_t chunk_idx, std::vector<double> &&data);
+
+    // Wait for pending writes to complete and stop the I/O thread. Throws
+    // std::runtime_error if the I/O thread failed.
+    void finish();
+
+    std::size_t numChunks() const { return m_chunks.size(); }
+    const ChunkDef_ &chunk(std::size_t i) const { return m_chunks[i]; }
+
+ private:
+    struct Item_ {
+        std::size_t idx;
+        std::vector<double> data;
+    };
+
+    void ioLoop_();
+    void readChunk_(std::size_t idx, std::vector<double> *data);
+    void writeChunk_(std::size_t idx, const std::vector<double> &data);
+    void stop_();
+    void throwIfFailed_();
+
+    GDALDatasetH m_hSrcDS {nullptr};
+    GDALDatasetH m_hDstDS {nullptr};
+    std::vector<int> m_src_bands {};
+    std::vector<int> m_dst_bands {};
+    std::vector<ChunkDef_> m_chunks {};
+    std::size_t m_queue_depth {1};
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Item_> m_ready {};
+    std::deque<Item_> m_pending_writes {};
+    std::size_t m_next_read {0};
+    std::size_t m_next_consume {0};
+    bool m_no_more_writes {false};
+    bool m_stop {false};
+    bool m_failed {false};
+    std::string m_err_msg {};
+    std::thread m_io_thread;
+};
+
+#endif  // CHUNK_PIPELINE_H_
@@ -0,0 +1,269 @@
+/* Process-wide pool of raster dataset handles
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include "dataset_pool.h"
+
+#include <gdal.h>
+
+#include <Rcpp.h>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+static long current_pid_() {
+#ifdef _WIN32
+    return static_cast<long>(_getpid());
+#else
+    return static_cast<long>(getpid());
+#endif
+}
+
+DatasetPool_::DatasetPool_() : m_pid(current_pid_()) {}
+
+DatasetPool_ &DatasetPool_::instance() {
+    // never destroyed, handles are closed by clear() at package unload
+    static DatasetPool_ *pool = new DatasetPool_();
+    return *pool;
+}
+
+// handles inherited from the parent process share file descriptors with it,
+// so a forked child forgets them without closing
+void DatasetPool_::checkFork_() {
+    const long pid = current_pid_();
+    if (pid == m_pid)
+        return;
+    m_pool.forgetAll();
+    m_pid = pid;
+}
+
+GDALDatasetH DatasetPool_::acquire(
+        const std::string &filename, bool read_only,
+        const std::string &allowed_driver,
+        const std::vector<std::string> &open_options) {
+
+    // the driver is not part of the key, see dataset_pool.h
+    std::string key = filename + "\n" + (read_only ? "r" : "u");
+    for (const std::string &opt : open_options)
+        key += "\n" + opt;
+
+    bool track = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        checkFork_();
+        if (m_max_size > 0) {
+            GDALDatasetH hDS = m_pool.takeIdle(key, allowed_driver);
+            if (hDS != nullptr) {
+                m_hits += 1;
+                return hDS;
+            }
+            track = true;
+        }
+        m_misses += 1;
+    }
+
+    std::vector<const char *> oo_in;
+    for (const std::string &opt : open_options)
+        oo_in.push_back(opt.c_str());
+    oo_in.push_back(nullptr);
+
+    const char *const allowed_drivers[] = {allowed_driver.c_str(), nullptr};
+
+    // open without the lock held, other threads may be opening too
+    GDALDatasetH hDS = GDALOpenEx(
+        filename.c_str(),
+        GDAL_OF_RASTER | (read_only ? GDAL_OF_READONLY : GDAL_OF_UPDATE),
+        allowed_driver.empty() ? nullptr : allowed_drivers,
+        oo_in.data(), nullptr);
+
+    if (hDS == nullptr || !track)
+        return hDS;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_evictions += m_pool.trimTotal(m_max_size - 1);
+    if (m_pool.size() >= m_max_size) {
+        // all pooled handles are in use, this one is closed on release
+        return hDS;
+    }
+
+    HandlePoolEntry_ entry;
+    entry.key = key;
+    entry.group = filename;
+    GDALDriverH hDriver = GDALGetDatasetDriver(hDS);
+    if (hDriver != nullptr)
+        entry.driver = GDALGetDriverShortName(hDriver);
+    entry.hDS = hDS;
+    entry.update = !read_only;
+    m_pool.add(std::move(entry));
+    return hDS;
+}
+
+void DatasetPool_::release(GDALDatasetH hDS) {
+    if (hDS == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    checkFork_();
+    HandlePoolEntry_ *entry = m_pool.find(hDS);
+    if (entry == nullptr) {
+        GDALReleaseDataset(hDS);
+        return;
+    }
+
+    m_pool.giveBack(entry);
+
+    if (entry->update) {
+        // drop the idle handles that may have cached the previous content
+        GDALFlushCache(hDS);
+        const std::string filename = entry->group;
+        m_evictions += m_pool.closeIdleInGroup(filename, hDS);
+    }
+
+    m_evictions += m_pool.trimTotal(m_max_size);
+}
+
+void DatasetPool_::evict(const std::string &filename) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    checkFork_();
+    m_evictions += m_pool.closeIdleInGroup(filename);
+}
+
+void DatasetPool_::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    checkFork_();
+    m_pool.clear(true);
+}
+
+void DatasetPool_::setMaxSize(std::size_t max_size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    checkFork_();
+    m_max_size = max_size;
+    m_evictions += m_pool.trimTotal(m_max_size);
+}
+
+DatasetPoolStats_ DatasetPool_::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DatasetPoolStats_ s;
+    if (current_pid_() == m_pid) {
+        s.size = m_pool.size();
+        s.in_use = m_pool.inUse();
+    }
+    s.max_size = m_max_size;
+    s.hits = m_hits;
+    s.misses = m_misses;
+    s.evictions = m_evictions;
+    return s;
+}
+
+
+//' Manage the pool of raster dataset handles
+//'
+//' Multi-threaded functions in gdalraster open one handle on the raster
+//' dataset for each worker thread. When the dataset pool is enabled, these
+//' handles are kept open after use in a pool for the R session, and reused
+//' by later calls on the same file along with their cached raster blocks.
+//' `ds_pool_acquire()` returns a `GDALRaster` object on a handle from the
+//' pool, so that R code reading the same files repeatedly (e.g., the
+//' workers of `parallel::mclapply()`) can also reuse open handles. The pool
+//' is disabled by default.
+//'
+//' @name ds_pool
+//'
+//' @details
+//' Pooled handles are keyed by the filename, the access mode (read-only or
+//' update) and the open options. The format driver that opened a handle is
+//' recorded with it: a request restricted to a driver (as made for the worker
+//' threads, using the driver of the original dataset) only gets a handle
+//' opened by that driver, while `ds_pool_acquire()` can get any pooled handle
+//' on the file, so the two share handles. A handle is used by one
+//' holder at a time: the worker threads of a function such as
+//' [read_windows()] or [zonal_stats()] get separate handles, and a handle
+//' taken by `ds_pool_acquire()` is in use until its `GDALRaster` object is
+//' closed.
+//'
+//' `ds_pool_set_size()` sets the maximum number of dataset handles kept open
+//' by the pool. `0` (the default) disables the pool, in which case handles
+//' are opened for each use and closed afterwards. Once the pool is full, the
+//' least recently used idle handles are closed to make room for new ones. If
+//' all pooled handles are in use, further handles are opened outside the pool
+//' and closed after use.
+//'
+//' A pooled read-only handle does not see modifications made to the file
+//' through other handles after its blocks were cached. Closing a `GDALRaster`
+//' object opened for update, or returning a pooled update handle, closes the
+//' idle pooled handles on the same file. Call `ds_pool_clear()` after writing
+//' to a file through an object that stays open or by other means, and before
+//' deleting or overwriting it.
+//' A forked child process (e.g., a worker of `parallel::mclapply()`) starts
+//' with an empty pool, handles are not shared between processes.
+//'
+//' `ds_pool_info()` returns information about the pool.
+//'
+//' `ds_pool_clear()` closes all idle handles and empties the pool.
+//' Handles in use remain valid until they are returned, and are then closed.
+//'
+//' @param max_size Integer maximum number of dataset handles kept open by the
+//' pool. `0` disables the pool.
+//' @returns
+//' `ds_pool_info()` returns a list with elements `size` (number of pooled
+//' handles), `in_use` (number of pooled handles currently held), `max_size`
+//' (the pool capacity), `hits` (number of requests served by an idle pooled
+//' handle), `misses` (number of requests that opened a new handle) and
+//' `evictions` (number of idle handles closed to make room or after an
+//' update).
+//'
+//' `ds_pool_acquire()` returns an object of class `GDALRaster`.
+//'
+//' `ds_pool_set_size()` and `ds_pool_clear()` return `NULL` invisibly.
+//'
+//' @seealso
+//' [`GDALRaster-class`][GDALRaster], [read_windows()], [zonal_stats()]
+//'
+//' @examples
+//' elev_file <- system.file("extdata/storml_elev.tif", package="gdalraster")
+//'
+//' ds_pool_set_size(8)
+//' for (i in 1:3) {
+//'   ds <- ds_pool_acquire(elev_file)
+//'   v <- ds$read(1, 0, i * 10, 143, 10, 143, 10)
+//'   ds$close()
+//' }
+//' ds_pool_info()
+//'
+//' ds_pool_set_size(0)
+// [[Rcpp::export]]
+Rcpp::List ds_pool_info() {
+    const DatasetPoolStats_ s = DatasetPool_::instance().stats();
+    return Rcpp::List::create(
+        Rcpp::Named("size") = static_cast<double>(s.size),
+        Rcpp::Named("in_use") = static_cast<double>(s.in_use),
+        Rcpp::Named("max_size") = static_cast<double>(s.max_size),
+        Rcpp::Named("hits") = static_cast<double>(s.hits),
+        Rcpp::Named("misses") = static_cast<double>(s.misses),
+        Rcpp::Named("evictions") = static_cast<double>(s.evictions));
+}
+
+//' @rdname ds_pool
+// [[Rcpp::export(invisible = true)]]
+void ds_pool_set_size(int max_size) {
+    if (max_size == NA_INTEGER || max_size < 0)
+        Rcpp::stop("'max_size' must be a single value >= 0");
+    DatasetPool_::instance().setMaxSize(static_cast<std::size_t>(max_size));
+}
+
+//' @rdname ds_pool
+// [[Rcpp::export(invisible = true)]]
+void ds_pool_clear() {
+    DatasetPool_::instance().clear();
+}
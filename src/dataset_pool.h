@@ -0,0 +1,98 @@
+/* Process-wide pool of raster dataset handles
+
+   A GDAL dataset handle must not be used concurrently from more than one
+   thread, so native multi-threaded code needs one handle per worker on the
+   same file (see WorkerDatasets_ in thread_util.h). Opening a handle has a
+   cost (parsing the file header, connection setup for remote files), and a
+   freshly opened handle also starts with a cold block cache. DatasetPool_
+   keeps the handles it has opened, keyed by filename, access mode and open
+   options, and hands idle ones out again instead of opening a new handle.
+   The driver is resolved when a handle is opened and recorded with it: a
+   request that names an allowed driver is served by a pooled handle opened
+   by that driver, and a request without one by any handle on the key, so
+   handles are shared between worker threads (which name the driver of the
+   original dataset) and ds_pool_acquire() (which does not).
+
+   Each handle is used by one holder at a time: acquire() marks it in use and
+   release() returns it to the pool, so concurrent requests for the same key
+   get separate handles. The pool keeps at most m_max_size handles open. The
+   least recently used idle handles are closed to make room for new ones. If
+   all pooled handles are in use, the handle is opened outside the pool and
+   closed on release. On release of a handle opened for update, the dataset
+   is flushed and the other idle handles on the same file are closed.
+
+   The pool is disabled by default (maximum size 0), in which case acquire()
+   and release() open and close the dataset. Pool operations are guarded by
+   a mutex and may be called from worker threads. Handles inherited by a
+   forked child process (e.g., with parallel::mclapply()) are not used by the
+   child, which starts with an empty pool. The bookkeeping of the pooled
+   handles is done by HandlePool_ (handle_pool.h).
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef DATASET_POOL_H_
+#define DATASET_POOL_H_
+
+#include <gdal.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "handle_pool.h"
+
+struct DatasetPoolStats_ {
+    std::size_t size = 0;
+    std::size_t in_use = 0;
+    std::size_t max_size = 0;
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t evictions = 0;
+};
+
+class DatasetPool_ {
+ public:
+    static DatasetPool_ &instance();
+
+    // Returns a handle on the raster dataset, either an idle pooled handle or
+    // a newly opened one (nullptr on error). allowed_driver may be empty. The
+    // handle must be given back with release().
+    GDALDatasetH acquire(const std::string &filename, bool read_only,
+                         const std::string &allowed_driver,
+                         const std::vector<std::string> &open_options);
+
+    // Gives back a handle obtained from acquire(). Handles not held by the
+    // pool are closed.
+    void release(GDALDatasetH hDS);
+
+    // Closes the idle handles on filename, e.g., after it has been modified
+    // through another handle.
+    void evict(const std::string &filename);
+
+    // Closes all idle handles. Handles in use are closed on release.
+    void clear();
+
+    void setMaxSize(std::size_t max_size);
+    DatasetPoolStats_ stats() const;
+
+ private:
+    DatasetPool_();
+    DatasetPool_(const DatasetPool_ &) = delete;
+    DatasetPool_ &operator=(const DatasetPool_ &) = delete;
+
+    void checkFork_();
+
+    mutable std::mutex m_mutex;
+    HandlePool_<InUseFlag_> m_pool {};
+    std::size_t m_max_size {0};
+    long m_pid {0};
+    int64_t m_hits {0};
+    int64_t m_misses {0};
+    int64_t m_evictions {0};
+};
+
+#endif  // DATASET_POOL_H_
@@ -0,0 +1,621 @@
+/* Tiled multi-threaded fill of nodata pixels
+
+   The band is processed in tiles, each read with a halo of
+   ceil(max_dist) + smooth_iterations pixels so that the search for valid
+   pixels, and the smoothing of filled pixels, see the same data as when
+   processing the whole band at once. Tiles are read and filled concurrently
+   on worker threads, and the output is written on the main thread.
+
+   Two interpolation modes are supported:
+
+   - inverse distance: for each nodata pixel, the nearest valid pixel along
+     each of the eight principal directions (within max_dist) is found, and
+     the value is the average of those weighted by inverse squared distance.
+     The nearest hits in each direction are found for all pixels of the
+     window with one sweep per direction.
+
+   - nearest: the value of the nearest valid pixel (Euclidean distance,
+     within max_dist), found with a separable exact distance transform
+     (Felzenszwalb and Huttenlocher 2012) that keeps the nearest pixel.
+     Among equally near valid pixels, the one in the leftmost column is
+     used, then the one in the top row. All of them lie within max_dist, so
+     inside the window, and the choice does not depend on the tile.
+
+   Smoothing iterations apply a 3x3 average to the filled pixels, over their
+   neighbours that are valid or filled.
+
+   The band is updated in place, so the halo of a tile must not include
+   pixels already written. The output of a tile is therefore kept until all
+   tiles whose window overlaps the rows of its blocks have been read, which
+   bounds memory use by about (halo / tile ysize + 1) rows of tiles, and
+   only tiles containing filled pixels are written. Timing of the read, fill
+   and write of each tile and the size of its buffers are returned.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+
+#include <Rcpp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gdalraster.h"
+#include "rcpp_util.h"
+#include "thread_util.h"
+
+struct FillTile_ {
+    int xoff {0};
+    int yoff {0};
+    int xsize {0};
+    int ysize {0};
+    int64_t num_nodata {0};
+    int64_t num_filled {0};
+    double read_time {0};
+    double fill_time {0};
+    double write_time {0};
+    double buffer_bytes {0};
+    std::vector<double> out {};  // tile values, if any pixel was filled
+};
+
+// Window of the band around a tile, with values, validity, and the fill
+// results for the whole window.
+struct FillWindow_ {
+    int xsize {0};
+    int ysize {0};
+    std::vector<double> values {};
+    std::vector<unsigned char> valid {};
+    std::vector<unsigned char> filled {};
+
+    double bytes() const {
+        return static_cast<double>(values.capacity()) * sizeof(double) +
+               valid.capacity() + filled.capacity();
+    }
+};
+
+// Inverse distance weighting of the nearest valid pixel along each of the
+// eight principal directions.
+static double fill_inv_dist_(FillWindow_ *w, double max_dist) {
+    const int W = w->xsize;
+    const int H = w->ysize;
+    const std::size_t n = static_cast<std::size_t>(W) * H;
+
+    std::vector<double> num(n, 0);
+    std::vector<double> den(n, 0);
+    // nearest hit along the current direction: steps (0 if none), value
+    std::vector<int32_t> steps(n);
+    std::vector<double> hit(n);
+
+    const int dirs[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1},
+                            {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+
+    for (const auto &d : dirs) {
+        const int dx = d[0];
+        const int dy = d[1];
+        const double step_len = (dx != 0 && dy != 0) ? std::sqrt(2.0) : 1.0;
+        const int max_steps = static_cast<int>(std::floor(max_dist /
+                                                          step_len));
+        if (max_steps < 1)
+            continue;
+
+        // visit p + d before p
+        for (int yi = 0; yi < H; ++yi) {
+            const int y = dy > 0 ? H - 1 - yi : yi;
+            for (int xi = 0; xi < W; ++xi) {
+                const int x = dx > 0 ? W - 1 - xi : xi;
+                const std::size_t i = static_cast<std::size_t>(y) * W + x;
+                steps[i] = 0;
+                const int xn = x + dx;
+                const int yn = y + dy;
+                if (xn < 0 || yn < 0 || xn >= W || yn >= H)
+                    continue;
+                const std::size_t j = static_cast<std::size_t>(yn) * W + xn;
+                if (w->valid[j]) {
+                    steps[i] = 1;
+                    hit[i] = w->values[j];
+                }
+                else if (steps[j] > 0 && steps[j] < max_steps) {
+                    steps[i] = steps[j] + 1;
+                    hit[i] = hit[j];
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            if (w->valid[i] || steps[i] == 0)
+                continue;
+            const double dist = steps[i] * step_len;
+            const double wt = 1.0 / (dist * dist);
+            num[i] += wt * hit[i];
+            den[i] += wt;
+        }
+    }
+
+    double bytes = static_cast<double>(n) * (2 * sizeof(double) +
+                                             sizeof(int32_t) + sizeof(double));
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!w->valid[i] && den[i] > 0) {
+            w->values[i] = num[i] / den[i];
+            w->filled[i] = 1;
+        }
+    }
+    return bytes;
+}
+
+// Value of the nearest valid pixel, by exact Euclidean distance transform.
+static double fill_nearest_(FillWindow_ *w, double max_dist) {
+    const int W = w->xsize;
+    const int H = w->ysize;
+    const std::size_t n = static_cast<std::size_t>(W) * H;
+    constexpr int64_t INF = std::numeric_limits<int64_t>::max() / 4;
+
+    // nearest valid row in the same column (-1 if none), ties to the top
+    std::vector<int32_t> col_site(n, -1);
+    for (int x = 0; x < W; ++x) {
+        int last = -1;
+        for (int y = 0; y < H; ++y) {
+            const std::size_t i = static_cast<std::size_t>(y) * W + x;
+            if (w->valid[i])
+                last = y;
+            col_site[i] = last;
+        }
+        last = -1;
+        for (int y = H - 1; y >= 0; --y) {
+            const std::size_t i = static_cast<std::size_t>(y) * W + x;
+            if (w->valid[i])
+                last = y;
+            if (last >= 0 && (col_site[i] < 0 || last - y < y - col_site[i]))
+                col_site[i] = last;
+        }
+    }
+
+    // lower envelope of the parabolas (x - q)^2 + f(q) along each row
+    const double max_d2 = max_dist * max_dist;
+    std::vector<int> v(W);
+    std::vector<double> z(W + 1);
+    std::vector<int64_t> f(W);
+    std::vector<double> fill_value(n);
+    std::vector<unsigned char> has_value(n, 0);
+
+    for (int y = 0; y < H; ++y) {
+        const std::size_t row = static_cast<std::size_t>(y) * W;
+        for (int q = 0; q < W; ++q) {
+            const int32_t s = col_site[row + q];
+            f[q] = (s < 0) ? INF : static_cast<int64_t>(y - s) * (y - s);
+        }
+
+        int k = -1;
+        for (int q = 0; q < W; ++q) {
+            if (f[q] >= INF)
+                continue;
+            double s = -std::numeric_limits<double>::infinity();
+            while (k >= 0) {
+                const int p = v[k];
+                s = (static_cast<double>(f[q] + static_cast<int64_t>(q) * q) -
+                     static_cast<double>(f[p] + static_cast<int64_t>(p) * p)) /
+                    (2.0 * (q - p));
+                if (s > z[k])
+                    break;
+                --k;
+            }
+            ++k;
+            v[k] = q;
+            z[k] = (k == 0) ? -std::numeric_limits<double>::infinity() : s;
+            z[k + 1] = std::numeric_limits<double>::infinity();
+        }
+        if (k < 0)
+            continue;
+
+        // at an intersection the parabola to the left is kept, so ties go
+        // to the leftmost column (equal intersections give equal doubles,
+        // as the division of the integer terms is correctly rounded)
+        int j = 0;
+        for (int x = 0; x < W; ++x) {
+            while (z[j + 1] < x)
+                ++j;
+            const std::size_t i = row + x;
+            if (w->valid[i])
+                continue;
+            const int q = v[j];
+            const double d2 = static_cast<double>(x - q) * (x - q) +
+                              static_cast<double>(f[q]);
+            if (d2 <= max_d2) {
+                const std::size_t site =
+                    static_cast<std::size_t>(col_site[row + q]) * W + q;
+                fill_value[i] = w->values[site];
+                has_value[i] = 1;
+            }
+        }
+    }
+
+    double bytes = static_cast<double>(n) * (sizeof(int32_t) +
+                                             sizeof(double) + 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (has_value[i]) {
+            w->values[i] = fill_value[i];
+            w->filled[i] = 1;
+        }
+    }
+    return bytes;
+}
+
+// 3x3 average of the filled pixels over valid or filled neighbours
+static void smooth_filled_(FillWindow_ *w, int iterations) {
+    const int W = w->xsize;
+    const int H = w->ysize;
+    std::vector<double> prev;
+    for (int it = 0; it < iterations; ++it) {
+        prev = w->values;
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) {
+                const std::size_t i = static_cast<std::size_t>(y) * W + x;
+                if (!w->filled[i])
+                    continue;
+                double sum = 0;
+                int count = 0;
+                for (int yy = std::max(y - 1, 0);
+                        yy <= std::min(y + 1, H - 1); ++yy) {
+                    for (int xx = std::max(x - 1, 0);
+                            xx <= std::min(x + 1, W - 1); ++xx) {
+                        const std::size_t j =
+                            static_cast<std::size_t>(yy) * W + xx;
+                        if (w->valid[j] || w->filled[j]) {
+                            sum += prev[j];
+                            count += 1;
+                        }
+                    }
+                }
+                w->values[i] = sum / count;
+            }
+        }
+    }
+}
+
+SEXP fill_nodata_tiles_(const Rcpp::CharacterVector &filename, int band,
+                        const Rcpp::CharacterVector &mask_file,
+                        double max_dist, int smooth_iterations,
+                        const std::string &interpolation,
+                        const Rcpp::IntegerVector &tile_size,
+                        int num_threads, bool quiet) {
+
+    if (tile_size.size() != 2 || tile_size[0] < 1 || tile_size[1] < 1)
+        Rcpp::stop("'tile_size' must contain two values > 0");
+    if (static_cast<double>(tile_size[0]) * tile_size[1] > INT32_MAX)
+        Rcpp::stop("'tile_size' is too large");
+    if (!(max_dist > 0) || max_dist > 1e6)
+        Rcpp::stop("'max_dist' must be > 0 and <= 1e6");
+    if (smooth_iterations < 0)
+        Rcpp::stop("'smooth_iterations' must be >= 0");
+    if (interpolation != "inv_dist" && interpolation != "nearest")
+        Rcpp::stop("'interpolation' must be \"inv_dist\" or \"nearest\"");
+    const bool nearest = (interpolation == "nearest");
+
+    const std::string mask_file_in =
+        Rcpp::as<std::string>(check_gdal_filename(mask_file));
+
+    GDALRaster ds(filename, false, R_NilValue, false, R_NilValue);
+    GDALDatasetH hDS = ds.getGDALDatasetH_();
+    GDALRasterBandH hBand = GDALGetRasterBand(hDS, band);
+    if (hBand == nullptr)
+        Rcpp::stop("failed to access the requested band");
+
+    const int nx = GDALGetRasterXSize(hDS);
+    const int ny = GDALGetRasterYSize(hDS);
+    int block_xsize = 0;
+    int block_ysize = 0;
+    GDALGetBlockSize(hBand, &block_xsize, &block_ysize);
+    block_ysize = std::max(block_ysize, 1);
+
+    std::unique_ptr<GDALRaster> mask_ds = nullptr;
+    if (mask_file_in != "") {
+        mask_ds = std::make_unique<GDALRaster>(mask_file, true, R_NilValue,
+                                               false, R_NilValue);
+        if (GDALGetRasterXSize(mask_ds->getGDALDatasetH_()) != nx ||
+                GDALGetRasterYSize(mask_ds->getGDALDatasetH_()) != ny) {
+            Rcpp::stop("the mask raster must have the same dimensions as "
+                       "the input raster");
+        }
+    }
+
+    const int halo = static_cast<int>(std::ceil(max_dist)) +
+                     smooth_iterations;
+
+    // tile grid
+    const int ntx = (nx + tile_size[0] - 1) / tile_size[0];
+    const int nty = (ny + tile_size[1] - 1) / tile_size[1];
+    const std::size_t num_tiles = static_cast<std::size_t>(ntx) * nty;
+
+    int nthreads = resolve_num_threads_(num_threads, num_tiles);
+    std::unique_ptr<WorkerDatasets_> worker_ds = nullptr;
+    std::unique_ptr<WorkerDatasets_> worker_mask = nullptr;
+    if (nthreads > 1) {
+        worker_ds = std::make_unique<WorkerDatasets_>(&ds, nthreads);
+        if (mask_ds) {
+            worker_mask = std::make_unique<WorkerDatasets_>(mask_ds.get(),
+                                                            nthreads);
+        }
+        if (worker_ds->empty() || (worker_mask && worker_mask->empty())) {
+            if (!quiet)
+                cli_alert_info_("the raster cannot be reopened for "
+                                "multi-threaded read, using one thread");
+            nthreads = 1;
+        }
+    }
+
+    std::vector<FillTile_> tiles(num_tiles);
+    for (std::size_t t = 0; t < num_tiles; ++t) {
+        tiles[t].xoff = static_cast<int>(t % ntx) * tile_size[0];
+        tiles[t].yoff = static_cast<int>(t / ntx) * tile_size[1];
+        tiles[t].xsize = std::min(tile_size[0], nx - tiles[t].xoff);
+        tiles[t].ysize = std::min(tile_size[1], ny - tiles[t].yoff);
+    }
+
+    // runs on worker threads: must not call into R
+    auto fill_tile = [&](FillTile_ *tile, int thread_idx) {
+        using clock = std::chrono::steady_clock;
+        const auto t0 = clock::now();
+
+        GDALDatasetH hWorkerDS = nthreads > 1 ? worker_ds->get(thread_idx)
+                                              : hDS;
+        GDALRasterBandH hWorkerBand = GDALGetRasterBand(hWorkerDS, band);
+        GDALRasterBandH hMaskBand = GDALGetMaskBand(hWorkerBand);
+        if (mask_ds) {
+            GDALDatasetH hMaskDS = nthreads > 1 ? worker_mask->get(thread_idx)
+                                                : mask_ds->getGDALDatasetH_();
+            hMaskBand = GDALGetRasterBand(hMaskDS, 1);
+        }
+
+        // window with the halo, clipped to the raster
+        const int wx0 = std::max(tile->xoff - halo, 0);
+        const int wy0 = std::max(tile->yoff - halo, 0);
+        const int wx1 = std::min(tile->xoff + tile->xsize + halo, nx);
+        const int wy1 = std::min(tile->yoff + tile->ysize + halo, ny);
+        FillWindow_ w;
+        w.xsize = wx1 - wx0;
+        w.ysize = wy1 - wy0;
+        const std::size_t n = static_cast<std::size_t>(w.xsize) * w.ysize;
+        w.values.resize(n);
+        w.valid.resize(n);
+        w.filled.assign(n, 0);
+
+        CPLErr err = GDALRasterIO(hWorkerBand, GF_Read, wx0, wy0, w.xsize,
+                                  w.ysize, w.values.data(), w.xsize, w.ysize,
+                                  GDT_Float64, 0, 0);
+        if (err == CE_None && mask_ds) {
+            std::vector<double> mask_values(n);
+            err = GDALRasterIO(hMaskBand, GF_Read, wx0, wy0, w.xsize,
+                               w.ysize, mask_values.data(), w.xsize, w.ysize,
+                               GDT_Float64, 0, 0);
+            for (std::size_t i = 0; i < n; ++i)
+                w.valid[i] = (mask_values[i] != 0) ? 1 : 0;
+        }
+        else if (err == CE_None) {
+            err = GDALRasterIO(hMaskBand, GF_Read, wx0, wy0, w.xsize,
+                               w.ysize, w.valid.data(), w.xsize, w.ysize,
+                               GDT_Byte, 0, 0);
+        }
+        if (err != CE_None) {
+            throw std::runtime_error(std::string("read raster failed: ") +
+                                     CPLGetLastErrorMsg());
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (std::isnan(w.values[i]))
+                w.valid[i] = 0;
+        }
+
+        const auto t1 = clock::now();
+        tile->read_time = std::chrono::duration<double>(t1 - t0).count();
+
+        const int dx = tile->xoff - wx0;
+        const int dy = tile->yoff - wy0;
+        auto tile_index = [&](int x, int y) {
+            return static_cast<std::size_t>(y + dy) * w.xsize + x + dx;
+        };
+        for (int y = 0; y < tile->ysize; ++y) {
+            for (int x = 0; x < tile->xsize; ++x)
+                tile->num_nodata += !w.valid[tile_index(x, y)];
+        }
+
+        double work_bytes = 0;
+        if (tile->num_nodata > 0) {
+            work_bytes = nearest ? fill_nearest_(&w, max_dist)
+                                 : fill_inv_dist_(&w, max_dist);
+            if (smooth_iterations > 0) {
+                smooth_filled_(&w, smooth_iterations);
+                work_bytes = std::max(work_bytes,
+                    static_cast<double>(n) * sizeof(double));
+            }
+
+            for (int y = 0; y < tile->ysize; ++y) {
+                for (int x = 0; x < tile->xsize; ++x)
+                    tile->num_filled += w.filled[tile_index(x, y)];
+            }
+        }
+
+        if (tile->num_filled > 0) {
+            tile->out.resize(static_cast<std::size_t>(tile->xsize) *
+                             tile->ysize);
+            for (int y = 0; y < tile->ysize; ++y) {
+                std::copy_n(w.values.begin() + tile_index(0, y),
+                            tile->xsize,
+                            tile->out.begin() +
+                                static_cast<std::size_t>(y) * tile->xsize);
+            }
+        }
+
+        tile->buffer_bytes = w.bytes() + work_bytes;
+        tile->fill_time =
+            std::chrono::duration<double>(clock::now() - t1).count();
+    };
+
+    if (!quiet) {
+        cli_alert_info_("filling " + std::to_string(num_tiles) +
+                        " tile(s) using " + std::to_string(nthreads) +
+                        " thread(s)...");
+        GDALTermProgressR(0.0, nullptr, nullptr);
+    }
+
+    // tiles are written once no tile left to read has a window overlapping
+    // the rows of their blocks
+    std::vector<std::size_t> pending;
+    double pending_bytes = 0;
+    double peak_pending_bytes = 0;
+
+    auto write_ready = [&](std::size_t next_tile) {
+        const int next_top = next_tile < num_tiles
+            ? std::max(tiles[next_tile].yoff - halo, 0) : ny;
+        std::vector<std::size_t> still_pending;
+        for (std::size_t t : pending) {
+            FillTile_ &tile = tiles[t];
+            const int block_rows_end = std::min(
+                ((tile.yoff + tile.ysize + block_ysize - 1) / block_ysize) *
+                block_ysize, ny);
+            if (block_rows_end > next_top) {
+                still_pending.push_back(t);
+                continue;
+            }
+            const auto t0 = std::chrono::steady_clock::now();
+            if (GDALRasterIO(hBand, GF_Write, tile.xoff, tile.yoff,
+                             tile.xsize, tile.ysize, tile.out.data(),
+                             tile.xsize, tile.ysize, GDT_Float64, 0, 0)
+                    != CE_None) {
+                Rcpp::stop("write raster failed");
+            }
+            tile.write_time = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - t0).count();
+            pending_bytes -= static_cast<double>(tile.out.size()) *
+                             sizeof(double);
+            std::vector<double>().swap(tile.out);
+        }
+        pending.swap(still_pending);
+    };
+
+    for (std::size_t batch_start = 0; batch_start < num_tiles;
+            batch_start += nthreads) {
+
+        const std::size_t batch_size =
+            std::min(static_cast<std::size_t>(nthreads),
+                     num_tiles - batch_start);
+
+        try {
+            parallel_for_(batch_size, std::min(nthreads,
+                                               static_cast<int>(batch_size)),
+                [&](std::size_t i, int thread_idx) {
+                    fill_tile(&tiles[batch_start + i], thread_idx);
+                });
+        }
+        catch (const std::exception &e) {
+            Rcpp::stop(e.what());
+        }
+
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const std::size_t t = batch_start + i;
+            if (tiles[t].num_filled > 0) {
+                pending.push_back(t);
+                pending_bytes += static_cast<double>(tiles[t].out.size()) *
+                                 sizeof(double);
+            }
+        }
+        peak_pending_bytes = std::max(peak_pending_bytes, pending_bytes);
+        write_ready(batch_start + batch_size);
+
+        if (!quiet) {
+            GDALTermProgressR(
+                static_cast<double>(batch_start + batch_size) / num_tiles,
+                nullptr, nullptr);
+        }
+        Rcpp::checkUserInterrupt();
+    }
+
+    // give the worker handles back before closing the updated dataset, which
+    // drops idle pooled handles on the file
+    worker_ds.reset();
+    worker_mask.reset();
+    ds.close();
+
+    Rcpp::IntegerVector tile_id = Rcpp::no_init(num_tiles);
+    Rcpp::IntegerVector xoff = Rcpp::no_init(num_tiles);
+    Rcpp::IntegerVector yoff = Rcpp::no_init(num_tiles);
+    Rcpp::IntegerVector xsize = Rcpp::no_init(num_tiles);
+    Rcpp::IntegerVector ysize = Rcpp::no_init(num_tiles);
+    Rcpp::NumericVector num_nodata = Rcpp::no_init(num_tiles);
+    Rcpp::NumericVector num_filled = Rcpp::no_init(num_tiles);
+    Rcpp::NumericVector read_time = Rcpp::no_init(num_tiles);
+    Rcpp::NumericVector fill_time = Rcpp::no_init(num_tiles);
+    Rcpp::NumericVector write_time = Rcpp::no_init(num_tiles);
+    Rcpp::NumericVector buffer_mb = Rcpp::no_init(num_tiles);
+
+    double total_nodata = 0, total_filled = 0;
+    double total_read = 0, total_fill = 0, total_write = 0;
+    double peak_buffer = 0;
+    for (std::size_t t = 0; t < num_tiles; ++t) {
+        const FillTile_ &tile = tiles[t];
+        tile_id[t] = static_cast<int>(t + 1);
+        xoff[t] = tile.xoff;
+        yoff[t] = tile.yoff;
+        xsize[t] = tile.xsize;
+        ysize[t] = tile.ysize;
+        num_nodata[t] = static_cast<double>(tile.num_nodata);
+        num_filled[t] = static_cast<double>(tile.num_filled);
+        read_time[t] = tile.read_time;
+        fill_time[t] = tile.fill_time;
+        write_time[t] = tile.write_time;
+        buffer_mb[t] = tile.buffer_bytes / (1024.0 * 1024.0);
+
+        total_nodata += num_nodata[t];
+        total_filled += num_filled[t];
+        total_read += tile.read_time;
+        total_fill += tile.fill_time;
+        total_write += tile.write_time;
+        peak_buffer = std::max(peak_buffer, buffer_mb[t]);
+    }
+
+    if (!quiet) {
+        auto fmt = [](double x) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.2f", x);
+            return std::string(buf);
+        };
+        cli_alert_info_(
+            "filled " + std::to_string(static_cast<int64_t>(total_filled)) +
+            " of " + std::to_string(static_cast<int64_t>(total_nodata)) +
+            " nodata pixel(s); time (s, summed over tiles): read " +
+            fmt(total_read) + ", fill " + fmt(total_fill) + ", write " +
+            fmt(total_write));
+        cli_alert_info_(
+            "peak buffer memory per tile: " + fmt(peak_buffer) +
+            " MB; peak output held for writing: " +
+            fmt(peak_pending_bytes / (1024.0 * 1024.0)) + " MB");
+    }
+
+    Rcpp::DataFrame df_out = Rcpp::DataFrame::create();
+    df_out.push_back(tile_id, "tile");
+    df_out.push_back(xoff, "xoff");
+    df_out.push_back(yoff, "yoff");
+    df_out.push_back(xsize, "xsize");
+    df_out.push_back(ysize, "ysize");
+    df_out.push_back(num_nodata, "num_nodata");
+    df_out.push_back(num_filled, "num_filled");
+    df_out.push_back(read_time, "read_time");
+    df_out.push_back(fill_time, "fill_time");
+    df_out.push_back(write_time, "write_time");
+    df_out.push_back(buffer_mb, "buffer_mb");
+
+    Rcpp::LogicalVector ret = Rcpp::LogicalVector::create(true);
+    ret.attr("tile_stats") = df_out;
+    return ret;
+}
@@ -0,0 +1,431 @@
+/* Focal (moving window) statistics for a raster band
+
+   The raster is processed in strips of full rows. Each strip is read with
+   the halo rows needed by the window, into a buffer padded with NaN on all
+   sides so that cells outside the raster are treated as missing. Window sums
+   (sum, mean, sd) are computed as separable horizontal then vertical passes,
+   and min/max use a monotonic deque along rows followed by a vertical pass.
+   The inner loops run over contiguous memory so the compiler can vectorize
+   them. Majority uses a sliding histogram along each row.
+
+   Strips are computed on a pool of worker threads, each using its own
+   read-only handle on the source dataset. Output for each batch of strips is
+   written on the main thread with GDALRaster::write().
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+
+#include <Rcpp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gdalraster.h"
+#include "rcpp_util.h"
+#include "thread_util.h"
+
+// target number of output pixels per strip
+constexpr int64_t FOCAL_STRIP_PIXELS_ = 1048576;
+// the raster is split in at least this many strips (if it has enough rows),
+// so that small rasters can also use several threads
+constexpr int FOCAL_MIN_STRIPS_ = 16;
+
+enum class FocalStat_ { SUM, MEAN, SD, MIN, MAX, MAJORITY };
+
+// per-thread work buffers
+struct FocalScratch_ {
+    std::vector<double> in {};    // padded input for one strip
+    std::vector<double> h1 {};    // horizontal pass: sum or min/max
+    std::vector<double> h2 {};    // horizontal pass: sum of squares
+    std::vector<double> hc {};    // horizontal pass: count of valid values
+    std::vector<int> dq {};       // deque storage for sliding min/max
+};
+
+// sliding window minimum (or maximum) of width k for n output positions,
+// over src[0, n + k - 1), using a monotonic deque of indices
+// NaN are ignored, and dst is +Inf (or -Inf) if a window has no valid values
+template <bool IS_MAX>
+static void sliding_extreme_(const double *src, int n, int k, double *dst,
+                             std::vector<int> *dq) {
+
+    const int len = n + k - 1;
+    if (static_cast<int>(dq->size()) < len)
+        dq->resize(len);
+    int *q = dq->data();
+    int head = 0;
+    int tail = 0;
+    constexpr double empty = IS_MAX ? -std::numeric_limits<double>::infinity()
+                                    : std::numeric_limits<double>::infinity();
+
+    for (int i = 0; i < len; ++i) {
+        const double v = src[i];
+        if (!std::isnan(v)) {
+            if (IS_MAX) {
+                while (tail > head && src[q[tail - 1]] <= v)
+                    --tail;
+            }
+            else {
+                while (tail > head && src[q[tail - 1]] >= v)
+                    --tail;
+            }
+            q[tail++] = i;
+        }
+        const int x = i - k + 1;
+        if (x >= 0) {
+            while (tail > head && q[head] < x)
+                ++head;
+            dst[x] = tail > head ? src[q[head]] : empty;
+        }
+    }
+}
+
+// compute the focal statistic for output rows [y0, y0 + nrows) of the band
+// runs on a worker thread: must not call into R
+static void focal_strip_(GDALRasterBandH hBand, int nx, int ny, int y0,
+                         int nrows, int kx, int ky, FocalStat_ stat,
+                         bool na_rm, FocalScratch_ *scr, double *out) {
+
+    const int hx = kx / 2;
+    const int hy = ky / 2;
+    const int w = nx + 2 * hx;
+    const int prows = nrows + 2 * hy;
+    const std::size_t w_sz = static_cast<std::size_t>(w);
+    const std::size_t nx_sz = static_cast<std::size_t>(nx);
+
+    // read the strip plus halo rows into the padded buffer
+    scr->in.assign(w_sz * prows, std::numeric_limits<double>::quiet_NaN());
+    const int r0 = std::max(0, y0 - hy);
+    const int r1 = std::min(ny, y0 + nrows + hy);
+    double *in_start = scr->in.data() + (r0 - (y0 - hy)) * w_sz + hx;
+    CPLErr err = GDALRasterIO(hBand, GF_Read, 0, r0, nx, r1 - r0, in_start,
+                              nx, r1 - r0, GDT_Float64, 0,
+                              static_cast<GSpacing>(w_sz * sizeof(double)));
+    if (err != CE_None) {
+        throw std::runtime_error(std::string("read raster failed: ") +
+                                 CPLGetLastErrorMsg());
+    }
+
+    int has_nodata = FALSE;
+    const double nodata = GDALGetRasterNoDataValue(hBand, &has_nodata);
+    if (has_nodata && !std::isnan(nodata)) {
+        for (double &v : scr->in) {
+            if (v == nodata)
+                v = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    const double full_count = static_cast<double>(kx) * ky;
+
+    if (stat == FocalStat_::MAJORITY) {
+        std::map<double, int> hist;
+        for (int y = 0; y < nrows; ++y) {
+            hist.clear();
+            int count = 0;
+            auto add_col = [&](int col, int incr) {
+                for (int i = 0; i < ky; ++i) {
+                    const double v = scr->in[(y + i) * w_sz + col];
+                    if (std::isnan(v))
+                        continue;
+                    count += incr;
+                    auto it = hist.emplace(v, 0).first;
+                    it->second += incr;
+                    if (it->second == 0)
+                        hist.erase(it);
+                }
+            };
+            for (int col = 0; col < kx - 1; ++col)
+                add_col(col, 1);
+
+            double *out_row = out + y * nx_sz;
+            for (int x = 0; x < nx; ++x) {
+                add_col(x + kx - 1, 1);
+                if (count == 0 || (!na_rm && count < full_count)) {
+                    out_row[x] = NA_REAL;
+                }
+                else {
+                    // ties resolve to the smallest value
+                    auto mode = hist.begin();
+                    for (auto it = hist.begin(); it != hist.end(); ++it) {
+                        if (it->second > mode->second)
+                            mode = it;
+                    }
+                    out_row[x] = mode->first;
+                }
+                add_col(x, -1);
+            }
+        }
+        return;
+    }
+
+    // shift values by the first valid one for numerical stability of sd
+    double shift = 0.0;
+    if (stat == FocalStat_::SD) {
+        for (const double v : scr->in) {
+            if (!std::isnan(v)) {
+                shift = v;
+                break;
+            }
+        }
+        if (shift != 0.0) {
+            for (double &v : scr->in)
+                v -= shift;
+        }
+    }
+
+    const bool need_sq = (stat == FocalStat_::SD);
+    const bool is_minmax = (stat == FocalStat_::MIN ||
+                            stat == FocalStat_::MAX);
+
+    // horizontal pass over all padded rows
+    scr->h1.assign(nx_sz * prows, 0.0);
+    scr->hc.assign(nx_sz * prows, 0.0);
+    if (need_sq)
+        scr->h2.assign(nx_sz * prows, 0.0);
+
+    for (int r = 0; r < prows; ++r) {
+        const double *in_row = scr->in.data() + r * w_sz;
+        double *c = scr->hc.data() + r * nx_sz;
+        for (int j = 0; j < kx; ++j) {
+            const double *p = in_row + j;
+            for (int x = 0; x < nx; ++x)
+                c[x] += std::isnan(p[x]) ? 0.0 : 1.0;
+        }
+
+        double *s = scr->h1.data() + r * nx_sz;
+        if (stat == FocalStat_::MIN) {
+            sliding_extreme_<false>(in_row, nx, kx, s, &scr->dq);
+        }
+        else if (stat == FocalStat_::MAX) {
+            sliding_extreme_<true>(in_row, nx, kx, s, &scr->dq);
+        }
+        else {
+            double *s2 = need_sq ? scr->h2.data() + r * nx_sz : nullptr;
+            for (int j = 0; j < kx; ++j) {
+                const double *p = in_row + j;
+                for (int x = 0; x < nx; ++x)
+                    s[x] += std::isnan(p[x]) ? 0.0 : p[x];
+                if (need_sq) {
+                    for (int x = 0; x < nx; ++x)
+                        s2[x] += std::isnan(p[x]) ? 0.0 : p[x] * p[x];
+                }
+            }
+        }
+    }
+
+    // vertical pass
+    std::vector<double> vs(nx_sz), vs2, vc(nx_sz);
+    if (need_sq)
+        vs2.resize(nx_sz);
+
+    for (int y = 0; y < nrows; ++y) {
+        std::fill(vc.begin(), vc.end(), 0.0);
+        if (stat == FocalStat_::MIN)
+            std::fill(vs.begin(), vs.end(),
+                      std::numeric_limits<double>::infinity());
+        else if (stat == FocalStat_::MAX)
+            std::fill(vs.begin(), vs.end(),
+                      -std::numeric_limits<double>::infinity());
+        else
+            std::fill(vs.begin(), vs.end(), 0.0);
+        if (need_sq)
+            std::fill(vs2.begin(), vs2.end(), 0.0);
+
+        for (int i = 0; i < ky; ++i) {
+            const std::size_t off = (y + i) * nx_sz;
+            const double *c = scr->hc.data() + off;
+            const double *s = scr->h1.data() + off;
+            for (int x = 0; x < nx; ++x)
+                vc[x] += c[x];
+            if (stat == FocalStat_::MIN) {
+                for (int x = 0; x < nx; ++x)
+                    vs[x] = std::min(vs[x], s[x]);
+            }
+            else if (stat == FocalStat_::MAX) {
+                for (int x = 0; x < nx; ++x)
+                    vs[x] = std::max(vs[x], s[x]);
+            }
+            else {
+                for (int x = 0; x < nx; ++x)
+                    vs[x] += s[x];
+            }
+            if (need_sq) {
+                const double *s2 = scr->h2.data() + off;
+                for (int x = 0; x < nx; ++x)
+                    vs2[x] += s2[x];
+            }
+        }
+
+        double *out_row = out + y * nx_sz;
+        for (int x = 0; x < nx; ++x) {
+            const double n = vc[x];
+            if (n == 0 || (!na_rm && n < full_count)) {
+                out_row[x] = NA_REAL;
+                continue;
+            }
+            if (is_minmax || stat == FocalStat_::SUM) {
+                out_row[x] = vs[x];
+            }
+            else if (stat == FocalStat_::MEAN) {
+                out_row[x] = vs[x] / n;
+            }
+            else {
+                if (n < 2) {
+                    out_row[x] = NA_REAL;
+                }
+                else {
+                    const double var = (vs2[x] - vs[x] * vs[x] / n) / (n - 1);
+                    out_row[x] = var > 0 ? std::sqrt(var) : 0.0;
+                }
+            }
+        }
+    }
+}
+
+//' Compute focal (moving window) statistics for a raster band
+//'
+//' Called from and documented in R/focal.R
+//' @noRd
+// [[Rcpp::export(name = ".focal")]]
+bool focal(const GDALRaster* const &src_ds, int band,
+           GDALRaster* const &dst_ds, int dst_band,
+           const Rcpp::IntegerVector &win_size, const std::string &stat,
+           bool na_rm, double nodata_value, int num_threads, bool quiet) {
+
+    src_ds->checkAccess_(GA_ReadOnly);
+    dst_ds->checkAccess_(GA_Update);
+    GDALRasterBandH hSrcBand = src_ds->getBand_(band);
+    dst_ds->getBand_(dst_band);
+
+    const int nx = static_cast<int>(src_ds->getRasterXSize());
+    const int ny = static_cast<int>(src_ds->getRasterYSize());
+    if (dst_ds->getRasterXSize() != nx || dst_ds->getRasterYSize() != ny)
+        Rcpp::stop("source and destination rasters must have the same size");
+
+    if (win_size.size() < 1 || win_size.size() > 2)
+        Rcpp::stop("'win_size' must be a vector of length 1 or 2");
+    const int kx = win_size[0];
+    const int ky = win_size.size() == 2 ? win_size[1] : win_size[0];
+    if (kx == NA_INTEGER || ky == NA_INTEGER || kx < 1 || ky < 1 ||
+            kx % 2 == 0 || ky % 2 == 0) {
+        Rcpp::stop("'win_size' must contain odd integers >= 1");
+    }
+
+    FocalStat_ focal_stat = FocalStat_::MEAN;
+    if (EQUAL(stat.c_str(), "sum"))
+        focal_stat = FocalStat_::SUM;
+    else if (EQUAL(stat.c_str(), "mean"))
+        focal_stat = FocalStat_::MEAN;
+    else if (EQUAL(stat.c_str(), "sd"))
+        focal_stat = FocalStat_::SD;
+    else if (EQUAL(stat.c_str(), "min"))
+        focal_stat = FocalStat_::MIN;
+    else if (EQUAL(stat.c_str(), "max"))
+        focal_stat = FocalStat_::MAX;
+    else if (EQUAL(stat.c_str(), "majority"))
+        focal_stat = FocalStat_::MAJORITY;
+    else
+        Rcpp::stop("unknown 'stat': " + stat);
+
+    // strips of full rows, aligned to the block height where possible
+    // the strips do not depend on the number of threads, since the shift
+    // used for sd is taken per strip, so the output does not either
+    int nthreads = resolve_num_threads_(num_threads, ny);
+    int block_xsize = 0;
+    int block_ysize = 0;
+    GDALGetBlockSize(hSrcBand, &block_xsize, &block_ysize);
+    if (block_ysize < 1)
+        block_ysize = 1;
+
+    int strip_rows = static_cast<int>(std::max<int64_t>(
+        1, std::min<int64_t>(ny, FOCAL_STRIP_PIXELS_ / nx)));
+    strip_rows = std::min(strip_rows, (ny + FOCAL_MIN_STRIPS_ - 1) /
+                                      FOCAL_MIN_STRIPS_);
+    if (strip_rows > block_ysize)
+        strip_rows -= strip_rows % block_ysize;
+    strip_rows = std::max(strip_rows, 1);
+
+    const int num_strips = (ny + strip_rows - 1) / strip_rows;
+    nthreads = std::min(nthreads, num_strips);
+
+    std::unique_ptr<WorkerDatasets_> worker_ds = nullptr;
+    if (nthreads > 1) {
+        worker_ds = std::make_unique<WorkerDatasets_>(src_ds, nthreads);
+        if (worker_ds->empty()) {
+            if (!quiet)
+                cli_alert_info_("the source raster cannot be reopened for "
+                                "multi-threaded read, using one thread");
+            nthreads = 1;
+        }
+    }
+
+    std::vector<FocalScratch_> scratch(nthreads);
+    std::vector<std::vector<double>> out_bufs(nthreads);
+
+    if (!quiet)
+        GDALTermProgressR(0.0, nullptr, nullptr);
+
+    for (int batch_start = 0; batch_start < num_strips;
+            batch_start += nthreads) {
+
+        const int batch_size = std::min(nthreads, num_strips - batch_start);
+
+        auto process_strip = [&](std::size_t i, int thread_idx) {
+            const int strip = batch_start + static_cast<int>(i);
+            const int y0 = strip * strip_rows;
+            const int nrows = std::min(strip_rows, ny - y0);
+            GDALRasterBandH hBand = hSrcBand;
+            if (nthreads > 1) {
+                hBand = GDALGetRasterBand(worker_ds->get(thread_idx), band);
+                if (hBand == nullptr)
+                    throw std::runtime_error(
+                        "failed to access the requested band");
+            }
+            out_bufs[i].resize(static_cast<std::size_t>(nx) * nrows);
+            focal_strip_(hBand, nx, ny, y0, nrows, kx, ky, focal_stat, na_rm,
+                         &scratch[thread_idx], out_bufs[i].data());
+        };
+
+        try {
+            parallel_for_(batch_size, std::min(nthreads, batch_size),
+                          process_strip);
+        }
+        catch (const std::exception &e) {
+            Rcpp::stop(e.what());
+        }
+
+        for (int i = 0; i < batch_size; ++i) {
+            const int y0 = (batch_start + i) * strip_rows;
+            const int nrows = std::min(strip_rows, ny - y0);
+            Rcpp::NumericVector v(out_bufs[i].begin(), out_bufs[i].end());
+            if (!std::isnan(nodata_value)) {
+                for (double &x : v) {
+                    if (std::isnan(x))
+                        x = nodata_value;
+                }
+            }
+            dst_ds->write(dst_band, 0, y0, nx, nrows, v);
+        }
+
+        if (!quiet) {
+            GDALTermProgressR(
+                static_cast<double>(batch_start + batch_size) / num_strips,
+                nullptr, nullptr);
+        }
+        Rcpp::checkUserInterrupt();
+    }
+
+    return true;
+}
@@ -33,6 +33,7 @@
 #include "srs_api.h"
 #include "rcpp_util.h"
 #include "transform.h"
+#include "warped_vrt_pool.h"
 
 using std::string_literals::operator""s;
 
@@ -1481,12 +1482,14 @@ Rcpp::NumericVector flip_vertical(const Rcpp::NumericVector &v,
 // Unique function signature based on number of parameters.
 // Called in R with `ds <- new(GDALRaster, ...)` giving all 8 parameters,
 // as in R/gdal_create.R.
+// If use_pool is true, the warped dataset is taken from WarpedVRTPool_ (see
+// src/warped_vrt_pool.h) and returned there when the object is closed.
 GDALRaster *autoCreateWarpedVRT(const GDALRaster* const &src_ds,
                                 const std::string &dst_wkt,
                                 const std::string &resample_alg,
                                 const std::string &src_wkt,
                                 double max_err, bool alpha_band,
-                                bool reserved1, bool reserved2) {
+                                bool use_pool, bool reserved) {
 
     GDALDatasetH hSrcDS = src_ds->getGDALDatasetH_();
     if (hSrcDS == nullptr)
@@ -1520,18 +1523,57 @@ GDALRaster *autoCreateWarpedVRT(const GDALRaster* const &src_ds,
     if (src_wkt != "")
         pszSrcWKT = src_wkt.c_str();
 
-    GDALWarpOptions *psOptions = nullptr;
-    if (alpha_band) {
-        psOptions = GDALCreateWarpOptions();
-        psOptions->nDstAlphaBand = src_ds->getRasterCount() + 1;
-    }
+    auto create_warped = [&](GDALDatasetH hDS) -> GDALDatasetH {
+        GDALWarpOptions *psOptions = nullptr;
+        if (alpha_band) {
+            psOptions = GDALCreateWarpOptions();
+            psOptions->nDstAlphaBand = GDALGetRasterCount(hDS) + 1;
+        }
 
-    GDALDatasetH hWarpedDS = nullptr;
-    hWarpedDS = GDALAutoCreateWarpedVRT(hSrcDS, pszSrcWKT, pszDstWKT,
-                                        eResampleAlg, max_err, psOptions);
+        GDALDatasetH hWarpedDS = GDALAutoCreateWarpedVRT(
+            hDS, pszSrcWKT, pszDstWKT, eResampleAlg, max_err, psOptions);
+
+        if (psOptions != nullptr)
+            GDALDestroyWarpOptions(psOptions);
 
-    if (psOptions != nullptr)
-        GDALDestroyWarpOptions(psOptions);
+        return hWarpedDS;
+    };
+
+    GDALDatasetH hWarpedDS = nullptr;
+    if (use_pool) {
+        // the pooled dataset warps its own handle on the source, so that it
+        // does not depend on src_ds staying open
+        const std::string src_filename = src_ds->getFilename();
+        if (src_filename.empty())
+            Rcpp::stop("'use_pool' requires a source dataset with a filename");
+
+        const std::vector<std::string> oo = src_ds->getOpenOptions_();
+        std::vector<const char *> oo_in;
+        std::string key = src_filename + "\n" + dst_wkt + "\n" + src_wkt +
+                          "\n" + resample_alg + "\n" +
+                          CPLSPrintf("%.17g", max_err) + "\n" +
+                          (alpha_band ? "alpha" : "");
+        for (const std::string &opt : oo) {
+            oo_in.push_back(opt.c_str());
+            key += "\n" + opt;
+        }
+        oo_in.push_back(nullptr);
+
+        hWarpedDS = WarpedVRTPool_::instance().acquire(key, [&]() {
+            GDALDatasetH hPoolSrcDS = GDALOpenEx(
+                src_filename.c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY,
+                nullptr, oo_in.data(), nullptr);
+            if (hPoolSrcDS == nullptr)
+                return static_cast<GDALDatasetH>(nullptr);
+            GDALDatasetH h = create_warped(hPoolSrcDS);
+            // the warped dataset holds its own reference on the source
+            GDALReleaseDataset(hPoolSrcDS);
+            return h;
+        });
+    }
+    else {
+        hWarpedDS = create_warped(hSrcDS);
+    }
 
     if (hWarpedDS == nullptr)
         Rcpp::stop("GDALAutoCreateWarpedVRT() returned NULL on error");
@@ -1539,6 +1581,7 @@ GDALRaster *autoCreateWarpedVRT(const GDALRaster* const &src_ds,
     auto ds = std::make_unique<GDALRaster>();
     ds->setFilename("");
     ds->setGDALDatasetH_(hWarpedDS);
+    ds->setPooled_(use_pool);
     return ds.release();
 }
 
@@ -1914,6 +1957,33 @@ bool dem_proc(const std::string &mode,
 //' (3x3 average filters on interpolated pixels) are applied to smooth out
 //' artifacts.
 //'
+//' A tiled mode is used if `tile_size` is given or `num_threads` is not `1`.
+//' The band is processed in tiles, each read with a halo of
+//' `ceiling(max_dist) + smooth_iterations` pixels, and tiles are filled
+//' concurrently on `num_threads` worker threads. Memory use is bounded by
+//' the size of the tiles with their halo times the number of threads, plus
+//' the filled tiles held until no tile left to read overlaps them (since the
+//' band is updated in place), instead of the size of the band. The result
+//' does not depend on the tile size. In this mode, the search for values to
+//' interpolate from is done along the eight principal directions from each
+//' nodata pixel (the nearest valid pixel in each direction within
+//' `max_dist`, weighted by inverse squared distance), so the output is
+//' similar to, but not the same as, the output of the standard mode. A nodata
+//' pixel whose valid pixels within `max_dist` all lie off these directions is
+//' not filled, while the standard mode may fill it.
+//' Pixels having the value `NaN` are also treated as nodata. The return
+//' value carries an attribute `"tile_stats"`, a data frame with the offset
+//' and size of each tile, its number of nodata and filled pixels, the time
+//' in seconds spent reading, filling and writing it, and the size of its
+//' buffers in MB.
+//'
+//' With `interpolation = "nearest"`, each nodata pixel takes the value of the
+//' nearest valid pixel within `max_dist` (by Euclidean distance). This
+//' requires GDAL >= 3.9 in the standard mode (`INTERPOLATION=NEAREST`
+//' option of `GDALFillNodata()`), and is computed with an exact distance
+//' transform in the tiled mode. When several valid pixels are equally near,
+//' the tiled mode uses the one in the leftmost column, then in the top row.
+//'
 //' @note
 //' The input raster will be modified in place. It should not be open in a
 //' `GDALRaster` object while processing with `fillNodata()`.
@@ -1927,9 +1997,20 @@ bool dem_proc(const std::string &mode,
 //' @param smooth_iterations The number of 3x3 average filter smoothing
 //' iterations to run after the interpolation to dampen artifacts
 //' (0 by default).
+//' @param interpolation Character string, the interpolation method. Either
+//' `"inv_dist"` (the default) for inverse distance weighting, or `"nearest"`
+//' for the value of the nearest valid pixel (see Details).
+//' @param num_threads Integer scalar, the number of worker threads for tiled
+//' processing (see Details). Defaults to `1`. A value `< 1` uses the
+//' number of available CPU cores.
+//' @param tile_size Optional integer vector of length two (or one, used for
+//' both dimensions) giving the tile size in pixels as `c(xsize, ysize)` for
+//' tiled processing. Defaults to `c(1024, 1024)` when `num_threads` is not
+//' `1`.
 //' @param quiet Logical scalar. If `TRUE`, a progress bar will not be
 //' displayed. Defaults to `FALSE`.
-//' @returns Logical indicating success (invisible \code{TRUE}).
+//' @returns Logical indicating success (invisible \code{TRUE}), with
+//' attribute `"tile_stats"` in the tiled mode (see Details).
 //' An error is raised if the operation fails.
 //' @examples
 //' ## fill nodata edge pixels
@@ -1957,11 +2038,20 @@ bool dem_proc(const std::string &mode,
 //' ds <- new(GDALRaster, mod_file)
 //' plot_raster(ds, legend = TRUE)
 //' ds$close()
+//'
+//' ## tiled, using two threads
+//' file.copy(f,  mod_file, overwrite = TRUE)
+//' res <- fillNodata(mod_file, band = 1, num_threads = 2, tile_size = 64)
+//' attr(res, "tile_stats")
 //' \dontshow{deleteDataset(mod_file)}
 // [[Rcpp::export(invisible = true)]]
-bool fillNodata(const Rcpp::CharacterVector &filename, int band,
+SEXP fillNodata(const Rcpp::CharacterVector &filename, int band,
                 const Rcpp::CharacterVector &mask_file = "",
                 double max_dist = 100, int smooth_iterations = 0,
+                const std::string &interpolation = "inv_dist",
+                int num_threads = 1,
+                const Rcpp::Nullable<Rcpp::IntegerVector> &tile_size =
+                       R_NilValue,
                 bool quiet = false) {
 
     GDALDatasetH hDS = nullptr;
@@ -1976,6 +2066,39 @@ bool fillNodata(const Rcpp::CharacterVector &filename, int band,
     const std::string mask_file_in =
         Rcpp::as<std::string>(check_gdal_filename(mask_file));
 
+    if (interpolation != "inv_dist" && interpolation != "nearest")
+        Rcpp::stop("'interpolation' must be \"inv_dist\" or \"nearest\"");
+
+    if (tile_size.isNotNull() || num_threads != 1) {
+        Rcpp::IntegerVector tile_size_in = Rcpp::IntegerVector::create(1024,
+                                                                       1024);
+        if (tile_size.isNotNull()) {
+            tile_size_in = Rcpp::as<Rcpp::IntegerVector>(tile_size);
+            if (tile_size_in.size() == 1)
+                tile_size_in = Rcpp::IntegerVector::create(tile_size_in[0],
+                                                           tile_size_in[0]);
+        }
+        if (tile_size_in.size() != 2 ||
+                Rcpp::is_true(Rcpp::any(Rcpp::is_na(tile_size_in)))) {
+            Rcpp::stop("'tile_size' must be a numeric vector of one or two "
+                       "values > 0");
+        }
+        return fill_nodata_tiles_(filename, band, mask_file, max_dist,
+                                  smooth_iterations, interpolation,
+                                  tile_size_in, num_threads, quiet);
+    }
+
+    std::vector<char *> opt_list;
+    if (interpolation == "nearest") {
+#if GDAL_VERSION_NUM < GDAL_COMPUTE_VERSION(3, 9, 0)
+        Rcpp::stop("interpolation = \"nearest\" requires GDAL >= 3.9 "
+                   "(or the tiled mode)");
+#else
+        opt_list.push_back((char *) "INTERPOLATION=NEAREST");
+#endif
+    }
+    opt_list.push_back(nullptr);
+
     hDS = GDALOpenShared(filename_in.c_str(), GA_Update);
     if (hDS == nullptr)
         Rcpp::stop("open raster failed");
@@ -2001,8 +2124,8 @@ bool fillNodata(const Rcpp::CharacterVector &filename, int band,
     }
 
     err = GDALFillNodata(hBand, hMaskBand, max_dist, 0, smooth_iterations,
-                         nullptr, quiet ? nullptr : GDALTermProgressR,
-                         nullptr);
+                         opt_list.data(),
+                         quiet ? nullptr : GDALTermProgressR, nullptr);
 
     GDALClose(hDS);
     if (hMaskDS != nullptr)
@@ -2011,7 +2134,7 @@ bool fillNodata(const Rcpp::CharacterVector &filename, int band,
     if (err != CE_None)
         Rcpp::stop("error in GDALFillNodata()");
 
-    return true;
+    return Rcpp::wrap(true);
 }
 
 
@@ -2846,6 +2969,20 @@ bool rasterize(const std::string &src_dsn, const std::string &dst_filename,
 //' The input dataset is read as integer data which means that floating point
 //' values are rounded to integers.
 //'
+//' A tiled mode is used if `tile_size` is given or `num_threads` is not `1`.
+//' Tiles are read and labeled into connected regions concurrently on
+//' `num_threads` worker threads, and regions continuing across tile edges are
+//' merged, so that region sizes and neighbours are those of the whole raster.
+//' The source is read twice, but memory use is bounded by the tile size times
+//' the number of threads, plus about 50 bytes per region and 16 bytes per pair
+//' of adjacent regions (pairs are counted once in each tile where the two
+//' regions touch, typically a few per region). When several
+//' neighbours of a small region have the same size, the tiled mode uses the
+//' one whose first pixel comes first in raster scan order, so the output may
+//' differ from the standard mode in the case of ties, but does not depend on
+//' the tile size. The destination raster must have the same dimensions as
+//' the source.
+//'
 //' @param src_filename Filename of the source raster to be processed.
 //' @param src_band Band number in the source raster to be processed.
 //' @param dst_filename Filename of the output raster. It may be the same as
@@ -2863,6 +3000,13 @@ bool rasterize(const std::string &src_dsn, const std::string &dst_filename,
 //' suitable for inclusion in polygons.
 //' @param options Algorithm options as a character vector of name=value pairs.
 //' None currently supported.
+//' @param num_threads Integer scalar, the number of worker threads for tiled
+//' processing (see Details). Defaults to `1`. A value `< 1` uses the
+//' number of available CPU cores.
+//' @param tile_size Optional integer vector of length two (or one, used for
+//' both dimensions) giving the tile size in pixels as `c(xsize, ysize)` for
+//' tiled processing. Defaults to `c(1024, 1024)` when `num_threads` is not
+//' `1`.
 //' @param quiet Logical scalar. If `TRUE`, a progress bar will not be
 //' displayed. Defaults to `FALSE`.
 //' @returns Logical indicating success (invisible \code{TRUE}).
@@ -2894,6 +3038,18 @@ bool rasterize(const std::string &src_dsn, const std::string &dst_filename,
 //'             connectedness = 8,
 //'             mask_filename = mask_file,
 //'             mask_band = 1)
+//'
+//' # tiled, using two threads
+//' sieveFilter(src_filename = evt_file,
+//'             src_band = 1,
+//'             dst_filename = evt_mmu_file,
+//'             dst_band = 1,
+//'             size_threshold = 2,
+//'             connectedness = 8,
+//'             mask_filename = mask_file,
+//'             mask_band = 1,
+//'             num_threads = 2,
+//'             tile_size = 64)
 //' \dontshow{deleteDataset(mask_file)}
 //' \dontshow{deleteDataset(evt_mmu_file)}
 // [[Rcpp::export(invisible = true)]]
@@ -2904,6 +3060,9 @@ bool sieveFilter(const Rcpp::CharacterVector &src_filename, int src_band,
                  int mask_band = 0,
                  const Rcpp::Nullable<Rcpp::CharacterVector> &options =
                         R_NilValue,
+                 int num_threads = 1,
+                 const Rcpp::Nullable<Rcpp::IntegerVector> &tile_size =
+                        R_NilValue,
                  bool quiet = false) {
 
     GDALDatasetH hSrcDS = nullptr;
@@ -2930,6 +3089,26 @@ bool sieveFilter(const Rcpp::CharacterVector &src_filename, int src_band,
     if (connectedness != 4 && connectedness != 8)
         Rcpp::stop("'connectedness' must be 4 or 8");
 
+    if (tile_size.isNotNull() || num_threads != 1) {
+        Rcpp::IntegerVector tile_size_in = Rcpp::IntegerVector::create(1024,
+                                                                       1024);
+        if (tile_size.isNotNull()) {
+            tile_size_in = Rcpp::as<Rcpp::IntegerVector>(tile_size);
+            if (tile_size_in.size() == 1)
+                tile_size_in = Rcpp::IntegerVector::create(tile_size_in[0],
+                                                           tile_size_in[0]);
+        }
+        if (tile_size_in.size() != 2 ||
+                Rcpp::is_true(Rcpp::any(Rcpp::is_na(tile_size_in)))) {
+            Rcpp::stop("'tile_size' must be a numeric vector of one or two "
+                       "values > 0");
+        }
+        return sieve_filter_tiles_(src_filename, src_band, dst_filename,
+                                   dst_band, size_threshold, connectedness,
+                                   mask_filename, mask_band, tile_size_in,
+                                   num_threads, quiet);
+    }
+
     if (src_filename_in == dst_filename_in && src_band == dst_band)
         in_place = true;
 
@@ -3949,3 +4128,139 @@ Rcpp::NumericVector gt_from_dim_bbox_(const Rcpp::NumericVector &dim,
 }
 
 
+//' Read multiple bands of a raster region in a single RasterIO call
+//'
+//' Called from and documented in R/gdalraster_proc.R (read_ds()).
+//' 'buf_type' is one of "raw", "integer", "double" or "complex", and
+//' 'interleave' is one of "band", "pixel" or "line".
+//' @noRd
+// [[Rcpp::export(name = ".read_ds_bands")]]
+SEXP read_ds_bands(const GDALRaster* const &ds,
+                   const Rcpp::IntegerVector &bands,
+                   int xoff, int yoff, int xsize, int ysize,
+                   int out_xsize, int out_ysize,
+                   const std::string &buf_type,
+                   const std::string &interleave) {
+
+    if (!ds->isOpen())
+        Rcpp::stop("dataset is not open");
+
+    if (out_xsize < 1 || out_ysize < 1)
+        Rcpp::stop("'out_xsize' and 'out_ysize' must be > 0");
+
+    if (bands.size() < 1)
+        Rcpp::stop("'bands' must contain at least one band number");
+
+    std::vector<int> band_list(bands.begin(), bands.end());
+    for (int b : band_list)
+        ds->getBand_(b);
+
+    const int nbands = static_cast<int>(band_list.size());
+    const R_xlen_t npixels = static_cast<R_xlen_t>(out_xsize) * out_ysize;
+    const R_xlen_t buf_size = npixels * nbands;
+
+    Rcpp::RObject out;
+    void *buf = nullptr;
+    GDALDataType eBufType = GDT_Unknown;
+    if (buf_type == "raw") {
+        Rcpp::RawVector v = Rcpp::no_init(buf_size);
+        buf = v.begin();
+        out = v;
+        eBufType = GDT_Byte;
+    }
+    else if (buf_type == "integer") {
+        Rcpp::IntegerVector v = Rcpp::no_init(buf_size);
+        buf = v.begin();
+        out = v;
+        eBufType = GDT_Int32;
+    }
+    else if (buf_type == "double") {
+        Rcpp::NumericVector v = Rcpp::no_init(buf_size);
+        buf = v.begin();
+        out = v;
+        eBufType = GDT_Float64;
+    }
+    else if (buf_type == "complex") {
+        Rcpp::ComplexVector v = Rcpp::no_init(buf_size);
+        buf = v.begin();
+        out = v;
+        eBufType = GDT_CFloat64;
+    }
+    else {
+        Rcpp::stop("invalid 'buf_type'");
+    }
+
+    // spacing in number of elements of the output buffer
+    R_xlen_t pixel_space = 1;
+    R_xlen_t line_space = out_xsize;
+    R_xlen_t band_space = npixels;
+    if (interleave == "pixel") {
+        pixel_space = nbands;
+        line_space = static_cast<R_xlen_t>(out_xsize) * nbands;
+        band_space = 1;
+    }
+    else if (interleave == "line") {
+        pixel_space = 1;
+        line_space = static_cast<R_xlen_t>(out_xsize) * nbands;
+        band_space = out_xsize;
+    }
+    else if (interleave != "band") {
+        Rcpp::stop("'interleave' must be one of \"band\", \"pixel\" or "
+                   "\"line\"");
+    }
+
+    const GSpacing elem_size = GDALGetDataTypeSizeBytes(eBufType);
+
+    CPLErr err = GDALDatasetRasterIO(
+        ds->getGDALDatasetH_(), GF_Read, xoff, yoff, xsize, ysize, buf,
+        out_xsize, out_ysize, eBufType, nbands, band_list.data(),
+        pixel_space * elem_size, line_space * elem_size,
+        band_space * elem_size);
+
+    if (err == CE_Failure)
+        Rcpp::stop("read raster failed");
+
+    // nodata to NA, consistent with GDALRaster::read()
+    if (eBufType == GDT_Int32 || eBufType == GDT_Float64) {
+        for (int i = 0; i < nbands; ++i) {
+            GDALRasterBandH hBand = ds->getBand_(band_list[i]);
+            const GDALDataType eDT = GDALGetRasterDataType(hBand);
+            int has_nodata = FALSE;
+            const double nodata = GDALGetRasterNoDataValue(hBand,
+                                                           &has_nodata);
+
+            if (eBufType == GDT_Int32) {
+                if (!has_nodata)
+                    continue;
+                const int int_nodata = static_cast<int>(nodata);
+                int *v = static_cast<int *>(buf) + band_space * i;
+                for (int row = 0; row < out_ysize; ++row) {
+                    int *p = v + line_space * row;
+                    for (int col = 0; col < out_xsize; ++col) {
+                        if (p[pixel_space * col] == int_nodata)
+                            p[pixel_space * col] = NA_INTEGER;
+                    }
+                }
+            }
+            else {
+                const bool check_nodata = has_nodata && !std::isnan(nodata);
+                const bool check_nan = GDALDataTypeIsFloating(eDT);
+                if (!check_nodata && !check_nan)
+                    continue;
+                double *v = static_cast<double *>(buf) + band_space * i;
+                for (int row = 0; row < out_ysize; ++row) {
+                    double *p = v + line_space * row;
+                    for (int col = 0; col < out_xsize; ++col) {
+                        double &val = p[pixel_space * col];
+                        if ((check_nan && std::isnan(val)) ||
+                                (check_nodata && val == nodata)) {
+                            val = NA_REAL;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return out;
+}
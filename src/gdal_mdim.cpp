@@ -9,12 +9,18 @@
 
 #include <Rcpp.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include "gdalraster.h"
 #include "rcpp_util.h"
+#include "running_stats.h"
+#include "thread_util.h"
 
 
 // Return a view of an MDArray as a "classic" GDALDataset (i.e., 2D)
@@ -662,3 +668,771 @@ bool mdim_translate(
     return ret;
 #endif
 }
+
+
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 2, 0)
+
+// maximum memory per piece read by mdim_read(), in bytes
+constexpr std::size_t MDIM_READ_MAX_CHUNK_MEMORY_ = 64 * 1024 * 1024;
+// maximum number of cells accumulated per tile by mdim_reduce()
+constexpr std::size_t MDIM_REDUCE_TILE_CELLS_ = 1024 * 1024;
+// maximum memory of the output buffers for a batch of rows in mdim_reduce()
+constexpr std::size_t MDIM_REDUCE_BATCH_MEMORY_ = 256 * 1024 * 1024;
+
+enum class MDimStat_ { COUNT, MEAN, SD, MIN, MAX, SUM };
+
+// Open an MDArray read-only from the root group or a sub-group given by
+// its fully qualified name. Returns nullptr on failure with err_msg set.
+static GDALMDArrayH open_mdarray_(const std::string &dsn,
+                                  const std::string &array_name,
+                                  const std::string &group_name,
+                                  const std::vector<char *> &allowed_drivers,
+                                  const std::vector<char *> &open_options,
+                                  std::string *err_msg) {
+
+    GDALDatasetH hDS = GDALOpenEx(
+        dsn.c_str(), GDAL_OF_MULTIDIM_RASTER | GDAL_OF_READONLY |
+                     GDAL_OF_VERBOSE_ERROR,
+        allowed_drivers.empty() ? nullptr : allowed_drivers.data(),
+        open_options.empty() ? nullptr : open_options.data(), nullptr);
+
+    if (!hDS) {
+        *err_msg = "failed to open multidim raster dataset";
+        return nullptr;
+    }
+
+    GDALGroupH hRootGroup = GDALDatasetGetRootGroup(hDS);
+    GDALReleaseDataset(hDS);
+    if (!hRootGroup) {
+        *err_msg = "failed to get object for the root group";
+        return nullptr;
+    }
+
+    GDALMDArrayH hVar = nullptr;
+    if (group_name == "") {
+        hVar = GDALGroupOpenMDArray(hRootGroup, array_name.c_str(), nullptr);
+    }
+    else {
+        GDALGroupH hSubGroup = GDALGroupOpenGroupFromFullname(
+            hRootGroup, group_name.c_str(), nullptr);
+        if (hSubGroup) {
+            hVar = GDALGroupOpenMDArray(hSubGroup, array_name.c_str(),
+                                        nullptr);
+            GDALGroupRelease(hSubGroup);
+        }
+        else {
+            *err_msg = "failed to get object for the sub-group";
+        }
+    }
+    GDALGroupRelease(hRootGroup);
+
+    if (!hVar && err_msg->empty())
+        *err_msg = "failed to get object for the MDArray";
+
+    return hVar;
+}
+
+// A hyperslab of an MDArray: start, count and step for each dimension.
+struct MDimRegion_ {
+    std::vector<GUInt64> start {};
+    std::vector<std::size_t> count {};
+    std::vector<GInt64> step {};
+};
+
+// One piece of a region. out_start is the offset of the piece in the
+// output index space of the region.
+struct MDimPiece_ {
+    std::vector<GUInt64> start {};
+    std::vector<std::size_t> count {};
+    std::vector<std::size_t> out_start {};
+};
+
+// Split a region into pieces aligned to the processing chunks of the array,
+// so that each piece decodes a set of whole chunks.
+static std::vector<MDimPiece_> plan_mdim_pieces_(
+        const MDimRegion_ &region, const std::vector<std::size_t> &chunk) {
+
+    const std::size_t ndims = region.count.size();
+
+    // (output offset, count) segments along each dimension
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> segs(ndims);
+    for (std::size_t d = 0; d < ndims; ++d) {
+        const GUInt64 step = static_cast<GUInt64>(region.step[d]);
+        const GUInt64 cs = std::max<GUInt64>(chunk[d], 1);
+        std::size_t k = 0;
+        while (k < region.count[d]) {
+            const GUInt64 src = region.start[d] + k * step;
+            const GUInt64 chunk_end = (src / cs + 1) * cs;
+            std::size_t n = static_cast<std::size_t>(
+                (chunk_end - src + step - 1) / step);
+            n = std::min(n, region.count[d] - k);
+            segs[d].emplace_back(k, n);
+            k += n;
+        }
+    }
+
+    std::vector<MDimPiece_> pieces;
+    std::vector<std::size_t> idx(ndims, 0);
+    while (true) {
+        MDimPiece_ p;
+        for (std::size_t d = 0; d < ndims; ++d) {
+            const auto &seg = segs[d][idx[d]];
+            p.out_start.push_back(seg.first);
+            p.count.push_back(seg.second);
+            p.start.push_back(region.start[d] + seg.first * region.step[d]);
+        }
+        pieces.push_back(std::move(p));
+
+        // odometer increment, last dimension fastest
+        std::size_t d = ndims;
+        while (d > 0) {
+            --d;
+            if (++idx[d] < segs[d].size())
+                break;
+            idx[d] = 0;
+            if (d == 0)
+                return pieces;
+        }
+        if (ndims == 0)
+            return pieces;
+    }
+}
+
+// Values of the indexing variable of a dimension over a range, as double or
+// character, or R NULL if there is no indexing variable.
+static SEXP read_mdim_coords_(GDALDimensionH hDim, GUInt64 start,
+                              std::size_t count, GInt64 step) {
+
+    GDALMDArrayH hIdxVar = GDALDimensionGetIndexingVariable(hDim);
+    if (!hIdxVar)
+        return R_NilValue;
+
+    Rcpp::RObject out = R_NilValue;
+    std::size_t nvardims = 0;
+    GDALDimensionH *pahVarDims = GDALMDArrayGetDimensions(hIdxVar, &nvardims);
+    GDALReleaseDimensions(pahVarDims, nvardims);
+    GDALExtendedDataTypeH hVarDT = GDALMDArrayGetDataType(hIdxVar);
+
+    if (nvardims == 1 && hVarDT) {
+        const GDALExtendedDataTypeClass cls =
+            GDALExtendedDataTypeGetClass(hVarDT);
+        const GPtrDiff_t stride = 1;
+        if (cls == GEDTC_NUMERIC) {
+            std::vector<double> v(count);
+            GDALExtendedDataTypeH hDT =
+                GDALExtendedDataTypeCreate(GDT_Float64);
+            if (GDALMDArrayRead(hIdxVar, &start, &count, &step, &stride, hDT,
+                                v.data(), nullptr, 0)) {
+                out = Rcpp::wrap(v);
+            }
+            GDALExtendedDataTypeRelease(hDT);
+        }
+        else if (cls == GEDTC_STRING) {
+            std::vector<char *> v(count, nullptr);
+            GDALExtendedDataTypeH hDT = GDALExtendedDataTypeCreateString(0);
+            if (GDALMDArrayRead(hIdxVar, &start, &count, &step, &stride, hDT,
+                                v.data(), nullptr, 0)) {
+                Rcpp::CharacterVector sv(count);
+                for (std::size_t i = 0; i < count; ++i)
+                    sv[i] = v[i] ? Rcpp::String(v[i]) : NA_STRING;
+                out = sv;
+            }
+            for (char *str : v)
+                CPLFree(str);
+            GDALExtendedDataTypeRelease(hDT);
+        }
+    }
+
+    if (hVarDT)
+        GDALExtendedDataTypeRelease(hVarDT);
+    GDALMDArrayRelease(hIdxVar);
+    return out;
+}
+
+#endif  // GDAL >= 3.2
+
+
+//' Read a hyperslab of an MDArray into an N-D array
+//'
+//' Called from and documented in R/gdal_mdim.R
+//' @noRd
+// [[Rcpp::export(name = ".mdim_read")]]
+Rcpp::List mdim_read(
+    const Rcpp::CharacterVector &dsn, const std::string &array_name,
+    const std::string &group_name,
+    const Rcpp::Nullable<Rcpp::NumericVector> &start,
+    const Rcpp::Nullable<Rcpp::NumericVector> &count,
+    const Rcpp::Nullable<Rcpp::NumericVector> &step,
+    int num_threads,
+    const Rcpp::Nullable<Rcpp::CharacterVector> &allowed_drivers,
+    const Rcpp::Nullable<Rcpp::CharacterVector> &open_options,
+    bool quiet) {
+
+#if GDAL_VERSION_NUM < GDAL_COMPUTE_VERSION(3, 2, 0)
+    Rcpp::stop("mdim_read() requires GDAL >= 3.2");
+#else
+    const std::string dsn_in = Rcpp::as<std::string>(check_gdal_filename(dsn));
+
+    std::vector<char *> oAllowedDrivers = {};
+    if (allowed_drivers.isNotNull()) {
+        Rcpp::CharacterVector allowed_drivers_in(allowed_drivers);
+        if (allowed_drivers_in.size() > 0) {
+            for (R_xlen_t i = 0; i < allowed_drivers_in.size(); ++i) {
+                oAllowedDrivers.push_back((char *) allowed_drivers_in[i]);
+            }
+        }
+        oAllowedDrivers.push_back(nullptr);
+    }
+
+    std::vector<char *> oOpenOptions = {};
+    if (open_options.isNotNull()) {
+        Rcpp::CharacterVector open_options_in(open_options);
+        if (open_options_in.size() > 0) {
+            for (R_xlen_t i = 0; i < open_options_in.size(); ++i) {
+                oOpenOptions.push_back((char *) open_options_in[i]);
+            }
+        }
+        oOpenOptions.push_back(nullptr);
+    }
+
+    std::string err_msg;
+    GDALMDArrayH hVar = open_mdarray_(dsn_in, array_name, group_name,
+                                      oAllowedDrivers, oOpenOptions,
+                                      &err_msg);
+    if (!hVar)
+        Rcpp::stop(err_msg);
+
+    // one array handle per worker thread, released on exit
+    std::vector<GDALMDArrayH> worker_vars = {hVar};
+    struct ReleaseArrays_ {
+        std::vector<GDALMDArrayH> &v;
+        ~ReleaseArrays_() {
+            for (GDALMDArrayH h : v)
+                GDALMDArrayRelease(h);
+        }
+    } release_arrays {worker_vars};
+
+    GDALExtendedDataTypeH hVarDT = GDALMDArrayGetDataType(hVar);
+    const bool is_numeric = hVarDT &&
+        GDALExtendedDataTypeGetClass(hVarDT) == GEDTC_NUMERIC &&
+        !GDALDataTypeIsComplex(GDALExtendedDataTypeGetNumericDataType(hVarDT));
+    if (hVarDT)
+        GDALExtendedDataTypeRelease(hVarDT);
+    if (!is_numeric)
+        Rcpp::stop("only arrays of a real numeric data type are supported");
+
+    std::size_t ndims = 0;
+    GDALDimensionH *pahDims = GDALMDArrayGetDimensions(hVar, &ndims);
+    std::vector<GUInt64> dim_size(ndims);
+    Rcpp::CharacterVector dim_names(ndims);
+    for (std::size_t d = 0; d < ndims; ++d) {
+        dim_size[d] = GDALDimensionGetSize(pahDims[d]);
+        dim_names[d] = GDALDimensionGetName(pahDims[d]);
+    }
+
+    auto stop_ = [&](const std::string &msg) {
+        GDALReleaseDimensions(pahDims, ndims);
+        Rcpp::stop(msg);
+    };
+
+    if (ndims == 0)
+        stop_("the MDArray has no dimensions");
+
+    MDimRegion_ region;
+    region.start.assign(ndims, 0);
+    region.step.assign(ndims, 1);
+    if (start.isNotNull()) {
+        Rcpp::NumericVector v(start);
+        if (static_cast<std::size_t>(v.size()) != ndims)
+            stop_("'start' must have one value per dimension");
+        for (std::size_t d = 0; d < ndims; ++d) {
+            if (Rcpp::NumericVector::is_na(v[d]) || v[d] < 0 ||
+                    static_cast<GUInt64>(v[d]) >= dim_size[d]) {
+                stop_("'start' is out of range for dimension " +
+                      std::to_string(d));
+            }
+            region.start[d] = static_cast<GUInt64>(v[d]);
+        }
+    }
+    if (step.isNotNull()) {
+        Rcpp::NumericVector v(step);
+        if (static_cast<std::size_t>(v.size()) != ndims)
+            stop_("'step' must have one value per dimension");
+        for (std::size_t d = 0; d < ndims; ++d) {
+            if (Rcpp::NumericVector::is_na(v[d]) || v[d] < 1)
+                stop_("'step' values must be >= 1");
+            region.step[d] = static_cast<GInt64>(v[d]);
+        }
+    }
+    region.count.resize(ndims);
+    for (std::size_t d = 0; d < ndims; ++d) {
+        const GUInt64 avail = dim_size[d] - region.start[d];
+        region.count[d] = static_cast<std::size_t>(
+            (avail + region.step[d] - 1) / region.step[d]);
+    }
+    if (count.isNotNull()) {
+        Rcpp::NumericVector v(count);
+        if (static_cast<std::size_t>(v.size()) != ndims)
+            stop_("'count' must have one value per dimension");
+        for (std::size_t d = 0; d < ndims; ++d) {
+            if (Rcpp::NumericVector::is_na(v[d]) || v[d] < 1 ||
+                    static_cast<std::size_t>(v[d]) > region.count[d]) {
+                stop_("'count' is out of range for dimension " +
+                      std::to_string(d));
+            }
+            region.count[d] = static_cast<std::size_t>(v[d]);
+        }
+    }
+
+    double total = 1;
+    for (std::size_t n : region.count)
+        total *= static_cast<double>(n);
+    if (total > static_cast<double>(R_XLEN_T_MAX))
+        stop_("the requested region is too large for an R vector");
+
+    // coordinate values of the region from the indexing variables
+    Rcpp::List coords(ndims);
+    for (std::size_t d = 0; d < ndims; ++d) {
+        coords[d] = read_mdim_coords_(pahDims[d], region.start[d],
+                                      region.count[d], region.step[d]);
+    }
+    GDALReleaseDimensions(pahDims, ndims);
+
+    // pieces aligned to the processing chunk size of the array
+    std::vector<std::size_t> chunk(ndims);
+    std::size_t nchunk_dims = 0;
+    std::size_t *panChunk = GDALMDArrayGetProcessingChunkSize(
+        hVar, &nchunk_dims, MDIM_READ_MAX_CHUNK_MEMORY_);
+    for (std::size_t d = 0; d < ndims; ++d) {
+        chunk[d] = (panChunk && d < nchunk_dims && panChunk[d] > 0)
+                   ? panChunk[d] : static_cast<std::size_t>(dim_size[d]);
+    }
+    CPLFree(panChunk);
+
+    const std::vector<MDimPiece_> pieces = plan_mdim_pieces_(region, chunk);
+
+    int nthreads = resolve_num_threads_(num_threads, pieces.size());
+    for (int t = 1; t < nthreads; ++t) {
+        std::string msg;
+        GDALMDArrayH h = open_mdarray_(dsn_in, array_name, group_name,
+                                       oAllowedDrivers, oOpenOptions, &msg);
+        if (!h) {
+            if (!quiet)
+                cli_alert_info_("the MDArray cannot be reopened for "
+                                "multi-threaded read, using one thread");
+            for (std::size_t i = 1; i < worker_vars.size(); ++i)
+                GDALMDArrayRelease(worker_vars[i]);
+            worker_vars.resize(1);
+            nthreads = 1;
+            break;
+        }
+        worker_vars.push_back(h);
+    }
+
+    int has_nodata = FALSE;
+    double nodata = GDALMDArrayGetNoDataValueAsDouble(hVar, &has_nodata);
+    const bool check_nodata = has_nodata && !std::isnan(nodata);
+
+    Rcpp::NumericVector values = Rcpp::no_init(static_cast<R_xlen_t>(total));
+    double *out_data = values.begin();
+    const std::size_t out_bytes = static_cast<std::size_t>(total) *
+                                  sizeof(double);
+
+    // element strides of the output in C order (last dimension fastest)
+    std::vector<GPtrDiff_t> out_stride(ndims);
+    GPtrDiff_t stride = 1;
+    for (std::size_t d = ndims; d > 0; --d) {
+        out_stride[d - 1] = stride;
+        stride *= static_cast<GPtrDiff_t>(region.count[d - 1]);
+    }
+
+    // runs on worker threads: must not call into R
+    auto read_piece = [&](std::size_t i, int thread_idx) {
+        const MDimPiece_ &p = pieces[i];
+        std::size_t offset = 0;
+        for (std::size_t d = 0; d < ndims; ++d)
+            offset += p.out_start[d] * out_stride[d];
+
+        GDALExtendedDataTypeH hDT = GDALExtendedDataTypeCreate(GDT_Float64);
+        const bool ok = GDALMDArrayRead(
+            worker_vars[thread_idx], p.start.data(), p.count.data(),
+            region.step.data(), out_stride.data(), hDT, out_data + offset,
+            out_data, out_bytes);
+        GDALExtendedDataTypeRelease(hDT);
+
+        if (!ok) {
+            throw std::runtime_error(std::string("read MDArray failed: ") +
+                                     CPLGetLastErrorMsg());
+        }
+    };
+
+    if (!quiet) {
+        cli_alert_info_("reading " + std::to_string(pieces.size()) +
+                        " chunk(s) using " + std::to_string(nthreads) +
+                        " thread(s)...");
+        GDALTermProgressR(0.0, nullptr, nullptr);
+    }
+
+    try {
+        parallel_for_(pieces.size(), nthreads, read_piece,
+            [quiet](double frac) {
+                if (!quiet)
+                    GDALTermProgressR(frac, nullptr, nullptr);
+            });
+    }
+    catch (const std::exception &e) {
+        Rcpp::stop(e.what());
+    }
+
+    for (double &val : values) {
+        if (std::isnan(val) || (check_nodata && val == nodata))
+            val = NA_REAL;
+    }
+
+    std::vector<double> count_out(region.count.begin(), region.count.end());
+    return Rcpp::List::create(
+        Rcpp::Named("values") = values,
+        Rcpp::Named("count") = Rcpp::wrap(count_out),
+        Rcpp::Named("dim_names") = dim_names,
+        Rcpp::Named("coords") = coords);
+#endif
+}
+
+
+//' Per-cell statistics of an MDArray reduced over all but two dimensions
+//'
+//' Called from and documented in R/gdal_mdim.R
+//' @noRd
+// [[Rcpp::export(name = ".mdim_reduce")]]
+bool mdim_reduce(
+    const Rcpp::CharacterVector &dsn, const std::string &array_name,
+    const std::string &group_name, int idx_xdim, int idx_ydim,
+    GDALRaster* const &dst_ds, const std::vector<std::string> &stats,
+    double nodata_value, int num_threads,
+    const Rcpp::Nullable<Rcpp::CharacterVector> &allowed_drivers,
+    const Rcpp::Nullable<Rcpp::CharacterVector> &open_options,
+    bool quiet) {
+
+#if GDAL_VERSION_NUM < GDAL_COMPUTE_VERSION(3, 2, 0)
+    Rcpp::stop("mdim_reduce() requires GDAL >= 3.2");
+#else
+    dst_ds->checkAccess_(GA_Update);
+
+    if (stats.empty())
+        Rcpp::stop("'stats' must contain at least one statistic");
+
+    std::vector<MDimStat_> stat_list;
+    for (const std::string &stat : stats) {
+        if (EQUAL(stat.c_str(), "count"))
+            stat_list.push_back(MDimStat_::COUNT);
+        else if (EQUAL(stat.c_str(), "mean"))
+            stat_list.push_back(MDimStat_::MEAN);
+        else if (EQUAL(stat.c_str(), "sd"))
+            stat_list.push_back(MDimStat_::SD);
+        else if (EQUAL(stat.c_str(), "min"))
+            stat_list.push_back(MDimStat_::MIN);
+        else if (EQUAL(stat.c_str(), "max"))
+            stat_list.push_back(MDimStat_::MAX);
+        else if (EQUAL(stat.c_str(), "sum"))
+            stat_list.push_back(MDimStat_::SUM);
+        else
+            Rcpp::stop("unknown stat: " + stat);
+    }
+    const std::size_t nstats = stat_list.size();
+    for (std::size_t i = 0; i < nstats; ++i)
+        dst_ds->getBand_(static_cast<int>(i) + 1);
+
+    const std::string dsn_in = Rcpp::as<std::string>(check_gdal_filename(dsn));
+
+    std::vector<char *> oAllowedDrivers = {};
+    if (allowed_drivers.isNotNull()) {
+        Rcpp::CharacterVector allowed_drivers_in(allowed_drivers);
+        if (allowed_drivers_in.size() > 0) {
+            for (R_xlen_t i = 0; i < allowed_drivers_in.size(); ++i) {
+                oAllowedDrivers.push_back((char *) allowed_drivers_in[i]);
+            }
+        }
+        oAllowedDrivers.push_back(nullptr);
+    }
+
+    std::vector<char *> oOpenOptions = {};
+    if (open_options.isNotNull()) {
+        Rcpp::CharacterVector open_options_in(open_options);
+        if (open_options_in.size() > 0) {
+            for (R_xlen_t i = 0; i < open_options_in.size(); ++i) {
+                oOpenOptions.push_back((char *) open_options_in[i]);
+            }
+        }
+        oOpenOptions.push_back(nullptr);
+    }
+
+    std::string err_msg;
+    GDALMDArrayH hVar = open_mdarray_(dsn_in, array_name, group_name,
+                                      oAllowedDrivers, oOpenOptions,
+                                      &err_msg);
+    if (!hVar)
+        Rcpp::stop(err_msg);
+
+    // one array handle per worker thread, released on exit
+    std::vector<GDALMDArrayH> worker_vars = {hVar};
+    struct ReleaseArrays_ {
+        std::vector<GDALMDArrayH> &v;
+        ~ReleaseArrays_() {
+            for (GDALMDArrayH h : v)
+                GDALMDArrayRelease(h);
+        }
+    } release_arrays {worker_vars};
+
+    GDALExtendedDataTypeH hVarDT = GDALMDArrayGetDataType(hVar);
+    const bool is_numeric = hVarDT &&
+        GDALExtendedDataTypeGetClass(hVarDT) == GEDTC_NUMERIC &&
+        !GDALDataTypeIsComplex(GDALExtendedDataTypeGetNumericDataType(hVarDT));
+    if (hVarDT)
+        GDALExtendedDataTypeRelease(hVarDT);
+    if (!is_numeric)
+        Rcpp::stop("only arrays of a real numeric data type are supported");
+
+    std::size_t ndims = 0;
+    GDALDimensionH *pahDims = GDALMDArrayGetDimensions(hVar, &ndims);
+    std::vector<GUInt64> dim_size(ndims);
+    for (std::size_t d = 0; d < ndims; ++d)
+        dim_size[d] = GDALDimensionGetSize(pahDims[d]);
+    GDALReleaseDimensions(pahDims, ndims);
+
+    if (ndims < 2)
+        Rcpp::stop("the MDArray must have at least two dimensions");
+    if (idx_xdim < 0 || static_cast<std::size_t>(idx_xdim) >= ndims ||
+            idx_ydim < 0 || static_cast<std::size_t>(idx_ydim) >= ndims ||
+            idx_xdim == idx_ydim) {
+        Rcpp::stop("'idx_xdim' and 'idx_ydim' must be distinct dimension "
+                   "indices");
+    }
+    const std::size_t ix = static_cast<std::size_t>(idx_xdim);
+    const std::size_t iy = static_cast<std::size_t>(idx_ydim);
+
+    const int nx = static_cast<int>(dim_size[ix]);
+    const int ny = static_cast<int>(dim_size[iy]);
+    if (dst_ds->getRasterXSize() != nx || dst_ds->getRasterYSize() != ny) {
+        Rcpp::stop("the destination raster must have the size of the X and "
+                   "Y dimensions");
+    }
+
+    std::vector<std::size_t> chunk(ndims);
+    std::size_t nchunk_dims = 0;
+    std::size_t *panChunk = GDALMDArrayGetProcessingChunkSize(
+        hVar, &nchunk_dims, MDIM_READ_MAX_CHUNK_MEMORY_);
+    for (std::size_t d = 0; d < ndims; ++d) {
+        chunk[d] = (panChunk && d < nchunk_dims && panChunk[d] > 0)
+                   ? panChunk[d] : static_cast<std::size_t>(dim_size[d]);
+    }
+    CPLFree(panChunk);
+
+    // tiles of the X/Y plane, aligned to chunks where possible and limited in
+    // size since each tile holds one accumulator per cell
+    int nthreads = resolve_num_threads_(num_threads, 0);
+    int tile_xsize = static_cast<int>(std::min<std::size_t>(chunk[ix], nx));
+    int tile_ysize = static_cast<int>(std::min<std::size_t>(chunk[iy], ny));
+    if (static_cast<std::size_t>(tile_xsize) > MDIM_REDUCE_TILE_CELLS_) {
+        tile_xsize = static_cast<int>(MDIM_REDUCE_TILE_CELLS_);
+        tile_ysize = 1;
+    }
+    if (static_cast<std::size_t>(tile_xsize) * tile_ysize >
+            MDIM_REDUCE_TILE_CELLS_) {
+        tile_ysize = static_cast<int>(MDIM_REDUCE_TILE_CELLS_ / tile_xsize);
+    }
+    const int ntiles_x = (nx + tile_xsize - 1) / tile_xsize;
+    if (ntiles_x * ((ny + tile_ysize - 1) / tile_ysize) < nthreads)
+        tile_ysize = std::max(1, (ny + nthreads - 1) / nthreads);
+    const int ntiles_y = (ny + tile_ysize - 1) / tile_ysize;
+
+    // batches of tile rows, with output buffers for the batch written from
+    // the main thread
+    const std::size_t row_bytes = static_cast<std::size_t>(nx) * nstats *
+                                  sizeof(double);
+    int batch_tile_rows = static_cast<int>(std::max<std::size_t>(
+        1, MDIM_REDUCE_BATCH_MEMORY_ / (row_bytes * tile_ysize)));
+    batch_tile_rows = std::min(batch_tile_rows, ntiles_y);
+    const int batch_rows = batch_tile_rows * tile_ysize;
+
+    nthreads = std::min(nthreads, ntiles_x * batch_tile_rows);
+    for (int t = 1; t < nthreads; ++t) {
+        std::string msg;
+        GDALMDArrayH h = open_mdarray_(dsn_in, array_name, group_name,
+                                       oAllowedDrivers, oOpenOptions, &msg);
+        if (!h) {
+            if (!quiet)
+                cli_alert_info_("the MDArray cannot be reopened for "
+                                "multi-threaded read, using one thread");
+            for (std::size_t i = 1; i < worker_vars.size(); ++i)
+                GDALMDArrayRelease(worker_vars[i]);
+            worker_vars.resize(1);
+            nthreads = 1;
+            break;
+        }
+        worker_vars.push_back(h);
+    }
+
+    int has_nodata = FALSE;
+    const double src_nodata = GDALMDArrayGetNoDataValueAsDouble(hVar,
+                                                                &has_nodata);
+    const bool check_nodata = has_nodata && !std::isnan(src_nodata);
+
+    std::vector<std::vector<double>> out_bufs(nstats);
+    std::vector<std::vector<double>> read_bufs(nthreads);
+    std::vector<std::vector<RunningStatsAccum_>> accums(nthreads);
+    const std::size_t ntiles = static_cast<std::size_t>(ntiles_x) * ntiles_y;
+    std::size_t tiles_done = 0;
+
+    if (!quiet)
+        GDALTermProgressR(0.0, nullptr, nullptr);
+
+    for (int batch_y0 = 0; batch_y0 < ny; batch_y0 += batch_rows) {
+        const int batch_nrows = std::min(batch_rows, ny - batch_y0);
+        const int batch_ntiles_y = (batch_nrows + tile_ysize - 1) /
+                                   tile_ysize;
+        const std::size_t batch_ntiles =
+            static_cast<std::size_t>(batch_ntiles_y) * ntiles_x;
+        for (auto &buf : out_bufs)
+            buf.resize(static_cast<std::size_t>(batch_nrows) * nx);
+
+        // runs on worker threads: must not call into R
+        auto reduce_tile = [&](std::size_t i, int thread_idx) {
+            const int tile_row = static_cast<int>(i) / ntiles_x;
+            const int tile_col = static_cast<int>(i) % ntiles_x;
+            const int y0 = batch_y0 + tile_row * tile_ysize;
+            const int x0 = tile_col * tile_xsize;
+            const int tny = std::min(tile_ysize, ny - y0);
+            const int tnx = std::min(tile_xsize, nx - x0);
+
+            MDimRegion_ region;
+            region.step.assign(ndims, 1);
+            for (std::size_t d = 0; d < ndims; ++d) {
+                region.start.push_back(0);
+                region.count.push_back(static_cast<std::size_t>(dim_size[d]));
+            }
+            region.start[iy] = y0;
+            region.count[iy] = tny;
+            region.start[ix] = x0;
+            region.count[ix] = tnx;
+
+            std::vector<RunningStatsAccum_> &acc = accums[thread_idx];
+            acc.assign(static_cast<std::size_t>(tny) * tnx,
+                       RunningStatsAccum_());
+            std::vector<double> &buf = read_bufs[thread_idx];
+
+            GDALExtendedDataTypeH hDT = GDALExtendedDataTypeCreate(
+                GDT_Float64);
+
+            for (const MDimPiece_ &p : plan_mdim_pieces_(region, chunk)) {
+                // buffer layout: reduced dimensions outermost, then Y, then X
+                std::vector<GPtrDiff_t> buf_stride(ndims);
+                buf_stride[ix] = 1;
+                buf_stride[iy] = static_cast<GPtrDiff_t>(p.count[ix]);
+                const std::size_t plane = p.count[ix] * p.count[iy];
+                std::size_t nplanes = 1;
+                for (std::size_t d = ndims; d > 0; --d) {
+                    if (d - 1 == ix || d - 1 == iy)
+                        continue;
+                    buf_stride[d - 1] =
+                        static_cast<GPtrDiff_t>(plane * nplanes);
+                    nplanes *= p.count[d - 1];
+                }
+                buf.resize(plane * nplanes);
+
+                if (!GDALMDArrayRead(worker_vars[thread_idx], p.start.data(),
+                                     p.count.data(), region.step.data(),
+                                     buf_stride.data(), hDT, buf.data(),
+                                     buf.data(), buf.size() * sizeof(double))) {
+                    GDALExtendedDataTypeRelease(hDT);
+                    throw std::runtime_error(
+                        std::string("read MDArray failed: ") +
+                        CPLGetLastErrorMsg());
+                }
+
+                for (std::size_t k = 0; k < nplanes; ++k) {
+                    const double *v = buf.data() + k * plane;
+                    for (std::size_t yy = 0; yy < p.count[iy]; ++yy) {
+                        RunningStatsAccum_ *acc_row = acc.data() +
+                            (p.out_start[iy] + yy) * tnx + p.out_start[ix];
+                        const double *v_row = v + yy * p.count[ix];
+                        for (std::size_t xx = 0; xx < p.count[ix]; ++xx) {
+                            const double x = v_row[xx];
+                            if (std::isnan(x) ||
+                                    (check_nodata && x == src_nodata)) {
+                                continue;
+                            }
+                            acc_row[xx].update(x);
+                        }
+                    }
+                }
+            }
+            GDALExtendedDataTypeRelease(hDT);
+
+            for (int yy = 0; yy < tny; ++yy) {
+                const std::size_t out_off =
+                    static_cast<std::size_t>(y0 - batch_y0 + yy) * nx + x0;
+                for (int xx = 0; xx < tnx; ++xx) {
+                    const RunningStatsAccum_ &a =
+                        acc[static_cast<std::size_t>(yy) * tnx + xx];
+                    for (std::size_t s = 0; s < nstats; ++s) {
+                        double val = nodata_value;
+                        switch (stat_list[s]) {
+                            case MDimStat_::COUNT:
+                                val = static_cast<double>(a.count);
+                                break;
+                            case MDimStat_::MEAN:
+                                if (a.count > 0)
+                                    val = a.mean;
+                                break;
+                            case MDimStat_::SD:
+                                if (a.count > 1)
+                                    val = std::sqrt(a.var());
+                                break;
+                            case MDimStat_::MIN:
+                                if (a.count > 0)
+                                    val = a.min;
+                                break;
+                            case MDimStat_::MAX:
+                                if (a.count > 0)
+                                    val = a.max;
+                                break;
+                            case MDimStat_::SUM:
+                                if (a.count > 0)
+                                    val = a.sum;
+                                break;
+                        }
+                        out_bufs[s][out_off + xx] = val;
+                    }
+                }
+            }
+        };
+
+        try {
+            parallel_for_(batch_ntiles, std::min<int>(nthreads, batch_ntiles),
+                reduce_tile,
+                [&](double frac) {
+                    if (!quiet) {
+                        GDALTermProgressR(
+                            (tiles_done + frac * batch_ntiles) / ntiles,
+                            nullptr, nullptr);
+                    }
+                });
+        }
+        catch (const std::exception &e) {
+            Rcpp::stop(e.what());
+        }
+        tiles_done += batch_ntiles;
+
+        for (std::size_t s = 0; s < nstats; ++s) {
+            GDALRasterBandH hBand = dst_ds->getBand_(static_cast<int>(s) + 1);
+            CPLErr err = GDALRasterIO(hBand, GF_Write, 0, batch_y0, nx,
+                                      batch_nrows, out_bufs[s].data(), nx,
+                                      batch_nrows, GDT_Float64, 0, 0);
+            if (err == CE_Failure)
+                Rcpp::stop("write to output raster failed");
+        }
+    }
+
+    return true;
+#endif
+}
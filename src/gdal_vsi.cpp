@@ -9,16 +9,26 @@
 #include <RcppInt64>
 
 #include <gdal.h>
+#include <cpl_error.h>
 #include <cpl_port.h>
 #include <cpl_string.h>
 #include <cpl_vsi.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "gdalraster.h"
 #include "rcpp_util.h"
+#include "thread_util.h"
 
 
 //' Copy a source file to a target filename
@@ -95,6 +105,266 @@ int vsi_copy_file(const Rcpp::CharacterVector &src_file,
 }
 
 
+// per-file progress of vsi_copy_batch(): keeps the highest fraction reported
+// across retries, read by the main thread to aggregate progress by bytes
+static int CPL_STDCALL copy_batch_progress_(double dfComplete,
+                                            CPL_UNUSED const char *pszMessage,
+                                            void *pProgressArg) {
+    auto *frac = static_cast<std::atomic<double> *>(pProgressArg);
+    if (dfComplete > frac->load())
+        frac->store(dfComplete);
+    return TRUE;
+}
+
+//' Copy a batch of files concurrently
+//'
+//' `vsi_copy_batch()` copies each file in a vector of source filenames to the
+//' corresponding target filename, running the copies concurrently on a pool
+//' of worker threads. Each copy is made with `VSISync()` in the GDAL Common
+//' Portability Library (see [vsi_sync()]), and is retried with exponential
+//' backoff if it fails. This is intended for staging large numbers of files
+//' between local storage and cloud object storage (e.g., /vsis3/, /vsigs/,
+//' /vsiaz/), where copying the files one at a time is dominated by request
+//' latency.
+//'
+//' @details
+//' Copies run on `num_threads` worker threads. A failed copy is retried up
+//' to `max_retries` times, waiting `retry_delay * 2^(k - 1)` seconds before
+//' the k-th retry, which covers transient errors such as network timeouts or
+//' throttling by the server. A copy is not attempted if the source file does
+//' not exist. The outcome of each copy is reported in the returned data frame
+//' and does not stop the other copies.
+//'
+//' `chunk_size` sets the `CHUNK_SIZE` option of `VSISync()`: the maximum
+//' size of chunk (in bytes) used to split large objects when downloading them
+//' from /vsis3/, /vsigs/, /vsiaz/ or /vsiadls/ to the local file system, or
+//' for upload to /vsis3/, /vsiaz/ or /vsiadls/ from the local file system
+//' (at least 5 MB for upload to /vsis3/). Other options of `VSISync()` can be
+//' given in `options` as described for [vsi_sync()]. Note that the
+//' `NUM_THREADS` option of `VSISync()` applies within each copy, in addition
+//' to the `num_threads` concurrent copies. With the default `TIMESTAMP`
+//' strategy, a target file that is up to date is not copied again (set
+//' `"SYNC_STRATEGY=OVERWRITE"` in `options` to always copy).
+//'
+//' If `show_progress = TRUE`, progress is reported as the fraction of the
+//' total bytes of the source files copied, followed by a summary of the
+//' number of files copied and the aggregate throughput.
+//'
+//' @param src_files Character vector of source filenames.
+//' @param target_files Character vector of target filenames, the same length
+//' as `src_files`. Target filenames must be unique.
+//' @param num_threads Integer number of files to copy concurrently. Defaults
+//' to `4`. Values < 1 request all available CPUs.
+//' @param chunk_size Numeric value. Chunk size in bytes to use for large
+//' objects on network file systems (see Details). The default `0` uses the
+//' GDAL default.
+//' @param max_retries Integer maximum number of times a failed copy is
+//' retried. Defaults to `3`.
+//' @param retry_delay Numeric value. Delay in seconds before the first retry
+//' of a failed copy, doubled for each further retry. Defaults to `1`.
+//' @param show_progress Logical scalar. If `TRUE`, a progress bar will be
+//' displayed. Defaults to `FALSE`.
+//' @param options Optional character vector of `NAME=VALUE` pairs passed to
+//' `VSISync()` (see Details of [vsi_sync()]).
+//' @returns A data frame with one row per file and columns `src_file`,
+//' `target_file`, `success` (logical), `attempts` (number of copy attempts
+//' made), `bytes` (size of the source file, or `NA` if it does not exist),
+//' `elapsed` (seconds spent on the file including retries), `mb_per_sec`
+//' (throughput of the successful attempt, `NA` on failure) and `error`
+//' (the last error message, `""` on success).
+//'
+//' @seealso
+//' [vsi_copy_file()], [vsi_sync()]
+//'
+//' @examples
+//' elev_file <- system.file("extdata/storml_elev.tif", package="gdalraster")
+//' lcp_file <- system.file("extdata/storm_lake.lcp", package="gdalraster")
+//' src <- c(elev_file, lcp_file)
+//' target <- file.path("/vsimem/copy_batch", basename(src))
+//' vsi_mkdir("/vsimem/copy_batch")
+//'
+//' res <- vsi_copy_batch(src, target, num_threads = 2)
+//' res[, c("target_file", "success", "bytes")]
+//'
+//' vsi_rmdir("/vsimem/copy_batch", recursive = TRUE)
+// [[Rcpp::export()]]
+Rcpp::DataFrame vsi_copy_batch(const Rcpp::CharacterVector &src_files,
+                               const Rcpp::CharacterVector &target_files,
+                               int num_threads = 4,
+                               double chunk_size = 0,
+                               int max_retries = 3,
+                               double retry_delay = 1.0,
+                               bool show_progress = false,
+                               const Rcpp::Nullable<Rcpp::CharacterVector>
+                                    &options = R_NilValue) {
+
+    if (src_files.size() != target_files.size())
+        Rcpp::stop("'src_files' and 'target_files' must have the same length");
+    if (max_retries == NA_INTEGER || max_retries < 0)
+        Rcpp::stop("'max_retries' must be a single value >= 0");
+    if (Rcpp::NumericVector::is_na(retry_delay) || retry_delay < 0)
+        Rcpp::stop("'retry_delay' must be a single value >= 0");
+    if (Rcpp::NumericVector::is_na(chunk_size) || chunk_size < 0)
+        Rcpp::stop("'chunk_size' must be a single value >= 0");
+
+    const std::size_t num_files = static_cast<std::size_t>(src_files.size());
+    std::vector<std::string> src_in(num_files);
+    std::vector<std::string> target_in(num_files);
+    std::set<std::string> targets_seen;
+    for (std::size_t i = 0; i < num_files; ++i) {
+        src_in[i] = Rcpp::as<std::string>(
+            check_gdal_filename(Rcpp::CharacterVector(1, src_files[i])));
+        target_in[i] = Rcpp::as<std::string>(
+            check_gdal_filename(Rcpp::CharacterVector(1, target_files[i])));
+        if (!targets_seen.insert(target_in[i]).second)
+            Rcpp::stop("duplicate target filename: " + target_in[i]);
+    }
+
+    CPLStringList sync_options;
+    if (options.isNotNull()) {
+        Rcpp::CharacterVector options_in(options);
+        for (R_xlen_t i = 0; i < options_in.size(); ++i)
+            sync_options.AddString(Rcpp::as<std::string>(options_in[i]).c_str());
+    }
+    if (chunk_size > 0) {
+        sync_options.SetNameValue(
+            "CHUNK_SIZE",
+            std::to_string(static_cast<int64_t>(chunk_size)).c_str());
+    }
+
+    // source sizes are obtained on the main thread so that progress can be
+    // aggregated by bytes from the start
+    std::vector<double> bytes(num_files, NA_REAL);
+    double total_bytes = 0;
+    for (std::size_t i = 0; i < num_files; ++i) {
+        VSIStatBufL sStat;
+        if (VSIStatExL(src_in[i].c_str(), &sStat,
+                       VSI_STAT_EXISTS_FLAG | VSI_STAT_SIZE_FLAG) == 0) {
+            bytes[i] = static_cast<double>(sStat.st_size);
+            total_bytes += bytes[i];
+        }
+    }
+
+    std::unique_ptr<std::atomic<double>[]> frac_done(
+        new std::atomic<double>[num_files]);
+    for (std::size_t i = 0; i < num_files; ++i)
+        frac_done[i].store(0.0);
+
+    std::vector<int> success(num_files, FALSE);
+    std::vector<int> attempts(num_files, 0);
+    std::vector<double> elapsed(num_files, 0);
+    std::vector<double> mb_per_sec(num_files, NA_REAL);
+    std::vector<std::string> errors(num_files);
+
+    // runs on worker threads: must not call into R, and must not throw since
+    // each failure is recorded for its file
+    auto copy_file = [&](std::size_t i, int) {
+        QuietErrorHandlerGuard_ quiet_errors;
+        const auto t_start = std::chrono::steady_clock::now();
+        if (std::isnan(bytes[i])) {
+            errors[i] = "source file not found";
+            return;
+        }
+
+        for (int k = 0; k <= max_retries; ++k) {
+            if (k > 0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(
+                    retry_delay * std::pow(2.0, k - 1)));
+            }
+            attempts[i] += 1;
+            CPLErrorReset();
+            const auto t_attempt = std::chrono::steady_clock::now();
+            const int result = VSISync(src_in[i].c_str(), target_in[i].c_str(),
+                                       sync_options.List(),
+                                       copy_batch_progress_, &frac_done[i],
+                                       nullptr);
+            if (result) {
+                const double secs = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - t_attempt).count();
+                success[i] = TRUE;
+                frac_done[i].store(1.0);
+                if (secs > 0)
+                    mb_per_sec[i] = bytes[i] / 1e6 / secs;
+                errors[i].clear();
+                break;
+            }
+            errors[i] = CPLGetLastErrorMsg();
+            if (errors[i].empty())
+                errors[i] = "copy failed";
+        }
+        elapsed[i] = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_start).count();
+    };
+
+    const int nthreads = resolve_num_threads_(num_threads, num_files);
+    double last_reported = 0.0;
+    std::function<void(double)> progress = nullptr;
+    if (show_progress) {
+        progress = [&](double frac_files) {
+            double frac = frac_files;
+            if (total_bytes > 0) {
+                double bytes_done = 0;
+                for (std::size_t i = 0; i < num_files; ++i) {
+                    if (!std::isnan(bytes[i]))
+                        bytes_done += bytes[i] * frac_done[i].load();
+                }
+                frac = bytes_done / total_bytes;
+            }
+            if (frac_files >= 1.0)
+                frac = 1.0;
+            if (frac > last_reported) {
+                GDALTermProgressR(frac, nullptr, nullptr);
+                last_reported = frac;
+            }
+        };
+        GDALTermProgressR(0.0, nullptr, nullptr);
+    }
+
+    const auto t_start = std::chrono::steady_clock::now();
+    parallel_for_(num_files, nthreads, copy_file, progress);
+    const double total_secs = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t_start).count();
+
+    if (show_progress) {
+        std::size_t num_copied = 0;
+        double bytes_copied = 0;
+        for (std::size_t i = 0; i < num_files; ++i) {
+            if (success[i]) {
+                num_copied += 1;
+                bytes_copied += bytes[i];
+            }
+        }
+        cli_alert_info_(
+            "copied " + std::to_string(num_copied) + " of " +
+            std::to_string(num_files) + " file(s), " +
+            CPLSPrintf("%.1f MB at %.1f MB/s", bytes_copied / 1e6,
+                       total_secs > 0 ? bytes_copied / 1e6 / total_secs : 0));
+    }
+
+    Rcpp::LogicalVector success_out(num_files);
+    Rcpp::CharacterVector errors_out(num_files);
+    for (std::size_t i = 0; i < num_files; ++i) {
+        success_out[i] = success[i];
+        errors_out[i] = errors[i];
+    }
+
+    Rcpp::IntegerVector attempts_out = Rcpp::wrap(attempts);
+    Rcpp::NumericVector bytes_out = Rcpp::wrap(bytes);
+    Rcpp::NumericVector elapsed_out = Rcpp::wrap(elapsed);
+    Rcpp::NumericVector mb_per_sec_out = Rcpp::wrap(mb_per_sec);
+
+    return Rcpp::DataFrame::create(
+        Rcpp::Named("src_file") = Rcpp::wrap(src_in),
+        Rcpp::Named("target_file") = Rcpp::wrap(target_in),
+        Rcpp::Named("success") = success_out,
+        Rcpp::Named("attempts") = attempts_out,
+        Rcpp::Named("bytes") = bytes_out,
+        Rcpp::Named("elapsed") = elapsed_out,
+        Rcpp::Named("mb_per_sec") = mb_per_sec_out,
+        Rcpp::Named("error") = errors_out);
+}
+
+
 //' Clean cache associated with /vsicurl/ and related file systems
 //'
 //' `vsi_curl_clear_cache()` cleans the local cache associated with /vsicurl/
@@ -348,6 +618,270 @@ Rcpp::CharacterVector vsi_glob(const Rcpp::CharacterVector &pattern,
 }
 
 
+// wildcard matching of a name as in vsi_glob(): '*', '?' and '[...]' with
+// '!' for negation (no path separators are involved)
+static bool glob_match_(const char *pattern, const char *name) {
+    const char *star_p = nullptr;
+    const char *star_n = nullptr;
+    while (*name) {
+        bool matched = false;
+        const char *next_p = pattern + 1;
+        if (*pattern == '[') {
+            const char *p = pattern + 1;
+            const bool negate = (*p == '!');
+            if (negate)
+                ++p;
+            bool in_class = false;
+            bool first = true;
+            while (*p && (first || *p != ']')) {
+                if (p[1] == '-' && p[2] && p[2] != ']') {
+                    if (*name >= p[0] && *name <= p[2])
+                        in_class = true;
+                    p += 3;
+                }
+                else {
+                    if (*name == *p)
+                        in_class = true;
+                    ++p;
+                }
+                first = false;
+            }
+            if (*p == ']') {
+                matched = (in_class != negate);
+                next_p = p + 1;
+            }
+            else {
+                // unterminated class, '[' is a literal character
+                matched = (*name == '[');
+            }
+        }
+        else if (*pattern == '*') {
+            star_p = pattern++;
+            star_n = name;
+            continue;
+        }
+        else if (*pattern != '\0') {
+            matched = (*pattern == '?' || *pattern == *name);
+        }
+
+        if (matched) {
+            pattern = next_p;
+            ++name;
+        }
+        else if (star_p) {
+            pattern = star_p + 1;
+            name = ++star_n;
+        }
+        else {
+            return false;
+        }
+    }
+    while (*pattern == '*')
+        ++pattern;
+    return *pattern == '\0';
+}
+
+struct DirEntry_ {
+    std::string name {};
+    int type {NA_INTEGER};  // 0 = file, 1 = directory, 2 = other
+    double size {NA_REAL};
+    double mtime {NA_REAL};
+};
+
+// list the entries under dir with VSIOpenDir()/VSIGetNextDirEntry(), names
+// prefixed by prefix. May run on a worker thread: must not call into R.
+static bool list_dir_entries_(const std::string &dir, const std::string &prefix,
+                              int max_depth, bool all_files,
+                              std::vector<DirEntry_> *entries) {
+
+    VSIDIR *psDir = VSIOpenDir(dir.c_str(), max_depth, nullptr);
+    if (psDir == nullptr)
+        return false;
+
+    const VSIDIREntry *psEntry = nullptr;
+    while ((psEntry = VSIGetNextDirEntry(psDir)) != nullptr) {
+        const std::string name = psEntry->pszName;
+        if (name.empty() || name == "." || name == "..")
+            continue;
+        if (!all_files && (name[0] == '.' || name.find("/.") !=
+                                             std::string::npos)) {
+            continue;
+        }
+
+        DirEntry_ entry;
+        entry.name = prefix + name;
+        if (psEntry->bModeKnown) {
+            if (VSI_ISDIR(psEntry->nMode))
+                entry.type = 1;
+            else if (VSI_ISREG(psEntry->nMode))
+                entry.type = 0;
+            else
+                entry.type = 2;
+        }
+        if (psEntry->bSizeKnown)
+            entry.size = static_cast<double>(psEntry->nSize);
+        if (psEntry->bMTimeKnown)
+            entry.mtime = static_cast<double>(psEntry->nMTime);
+        entries->push_back(std::move(entry));
+    }
+    VSICloseDir(psDir);
+    return true;
+}
+
+//' List a directory with file size, modification time and type
+//'
+//' `vsi_list_dir()` lists the entries of a directory, optionally recursing
+//' into subdirectories, and returns the type, size and modification time of
+//' each entry obtained in the same pass. It is a wrapper for `VSIOpenDir()`
+//' and `VSIGetNextDirEntry()` in the GDAL Common Portability Library.
+//' This avoids a separate [vsi_stat()] request per file, which matters on
+//' network file systems. On /vsis3/, /vsigs/, /vsiaz/ and /vsiadls/, a
+//' recursive listing is obtained with a small number of requests to the server
+//' regardless of the directory structure.
+//'
+//' @details
+//' If `pattern` is given, only entries whose file name (the last component of
+//' the path) matches the wildcard pattern are returned. The wildcards are
+//' `*` (any string), `?` (any single character) and `[...]` (a character class
+//' or range, with `!` immediately after `[` for negation), as for
+//' [vsi_glob()]. Subdirectories are searched regardless of whether their
+//' names match.
+//'
+//' If `num_threads` is greater than 1 and `path` is on a local file system
+//' (see [vsi_is_local()], requires GDAL >= 3.6), the subdirectories of `path`
+//' are listed concurrently on worker threads. Network file systems are always
+//' listed in a single pass since their recursive listing is already done in
+//' bulk.
+//'
+//' @param path Character string. The path of the directory to list.
+//' @param max_depth Integer scalar. The maximum depth of subdirectories to
+//' list: `0` lists only the entries of `path`, `1` also lists the entries of
+//' its subdirectories, and so on. The default `-1` lists all subdirectories
+//' recursively.
+//' @param pattern Optional character string. A wildcard pattern that file
+//' names must match (see Details). The default `""` returns all entries.
+//' @param all_files Logical scalar. If `FALSE` (the default), entries whose
+//' name or any parent directory name starts with a dot are omitted. If `TRUE`,
+//' all entries are returned.
+//' @param num_threads Integer scalar. Number of threads for listing the
+//' subdirectories of `path` concurrently on local file systems. Defaults to
+//' `1`. Values < 1 request all available CPUs.
+//' @returns A data frame with one row per entry, sorted by name, and columns
+//' `name` (path relative to `path`, using `/` as separator), `type`
+//' (`"file"`, `"dir"` or `"other"`), `size` (in bytes) and `mtime`
+//' (modification time as `POSIXct`). Values not known for an entry are `NA`.
+//' Some file systems do not report the size or modification time of
+//' directories. An error is raised if `path` cannot be opened as a directory.
+//'
+//' @seealso
+//' [vsi_glob()], [vsi_read_dir()], [vsi_stat()]
+//'
+//' @examples
+//' data_dir <- system.file("extdata", package="gdalraster")
+//' vsi_list_dir(data_dir, pattern = "*.tif") |> head()
+// [[Rcpp::export()]]
+Rcpp::DataFrame vsi_list_dir(const Rcpp::CharacterVector &path,
+                             int max_depth = -1,
+                             std::string pattern = "",
+                             bool all_files = false,
+                             int num_threads = 1) {
+
+    const std::string path_in =
+        Rcpp::as<std::string>(check_gdal_filename(path));
+
+    if (max_depth == NA_INTEGER)
+        Rcpp::stop("'max_depth' must be a single integer value");
+    if (max_depth < 0)
+        max_depth = -1;
+
+    bool is_local = false;
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 6, 0)
+    is_local = VSIIsLocal(path_in.c_str());
+#endif
+
+    std::vector<DirEntry_> entries;
+    if (num_threads == 1 || max_depth == 0 || !is_local) {
+        if (!list_dir_entries_(path_in, "", max_depth, all_files, &entries))
+            Rcpp::stop("failed to open directory: " + path_in);
+    }
+    else {
+        if (!list_dir_entries_(path_in, "", 0, all_files, &entries))
+            Rcpp::stop("failed to open directory: " + path_in);
+
+        std::vector<std::string> subdirs;
+        for (const DirEntry_ &entry : entries) {
+            if (entry.type == 1)
+                subdirs.push_back(entry.name);
+        }
+
+        const int nthreads = resolve_num_threads_(num_threads, subdirs.size());
+        const int sub_depth = max_depth < 0 ? -1 : max_depth - 1;
+        std::vector<std::vector<DirEntry_>> sub_entries(subdirs.size());
+        const std::string sep = path_in.back() == '/' ? "" : "/";
+
+        // runs on worker threads: must not call into R
+        auto list_subdir = [&](std::size_t i, int) {
+            // a subdirectory that cannot be opened (e.g., no permission) is
+            // listed without its content, as in the single pass
+            list_dir_entries_(path_in + sep + subdirs[i], subdirs[i] + "/",
+                              sub_depth, all_files, &sub_entries[i]);
+        };
+        parallel_for_(subdirs.size(), nthreads, list_subdir);
+
+        for (auto &v : sub_entries) {
+            entries.insert(entries.end(), std::make_move_iterator(v.begin()),
+                           std::make_move_iterator(v.end()));
+        }
+    }
+
+    if (!pattern.empty()) {
+        entries.erase(
+            std::remove_if(entries.begin(), entries.end(),
+                [&pattern](const DirEntry_ &entry) {
+                    const std::size_t pos = entry.name.find_last_of('/');
+                    const std::string basename =
+                        pos == std::string::npos ? entry.name
+                                                 : entry.name.substr(pos + 1);
+                    return !glob_match_(pattern.c_str(), basename.c_str());
+                }),
+            entries.end());
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const DirEntry_ &a, const DirEntry_ &b) {
+                  return a.name < b.name;
+              });
+
+    const R_xlen_t n = static_cast<R_xlen_t>(entries.size());
+    Rcpp::CharacterVector name_out(n);
+    Rcpp::CharacterVector type_out(n);
+    Rcpp::NumericVector size_out(n);
+    Rcpp::NumericVector mtime_out(n);
+    for (R_xlen_t i = 0; i < n; ++i) {
+        const DirEntry_ &entry = entries[i];
+        name_out[i] = entry.name;
+        if (entry.type == 0)
+            type_out[i] = "file";
+        else if (entry.type == 1)
+            type_out[i] = "dir";
+        else if (entry.type == 2)
+            type_out[i] = "other";
+        else
+            type_out[i] = NA_STRING;
+        size_out[i] = entry.size;
+        mtime_out[i] = entry.mtime;
+    }
+    Rcpp::CharacterVector classes = {"POSIXct", "POSIXt"};
+    mtime_out.attr("class") = classes;
+
+    return Rcpp::DataFrame::create(
+        Rcpp::Named("name") = name_out,
+        Rcpp::Named("type") = type_out,
+        Rcpp::Named("size") = size_out,
+        Rcpp::Named("mtime") = mtime_out);
+}
+
+
 //' Synchronize a source file/directory with a target file/directory
 //'
 //' `vsi_sync()` is a wrapper for `VSISync()` in the GDAL Common Portability
@@ -14,6 +14,14 @@ int vsi_copy_file(const Rcpp::CharacterVector &src_file,
                   const Rcpp::CharacterVector &target_file,
                   bool show_progess);
 
+Rcpp::DataFrame vsi_copy_batch(const Rcpp::CharacterVector &src_files,
+                               const Rcpp::CharacterVector &target_files,
+                               int num_threads, double chunk_size,
+                               int max_retries, double retry_delay,
+                               bool show_progress,
+                               const Rcpp::Nullable<Rcpp::CharacterVector>
+                                    &options);
+
 void vsi_curl_clear_cache(bool partial,
                           const Rcpp::CharacterVector &file_prefix,
                           bool quiet);
@@ -25,6 +33,10 @@ Rcpp::CharacterVector vsi_read_dir(const Rcpp::CharacterVector &path,
 Rcpp::CharacterVector vsi_glob(const Rcpp::CharacterVector &pattern,
                                bool show_progress);
 
+Rcpp::DataFrame vsi_list_dir(const Rcpp::CharacterVector &path,
+                             int max_depth, std::string pattern,
+                             bool all_files, int num_threads);
+
 bool vsi_sync(const Rcpp::CharacterVector &src,
               const Rcpp::CharacterVector &target,
               bool show_progess,
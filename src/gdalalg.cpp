@@ -15,6 +15,7 @@
 #include <Rcpp.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <memory>
 #include <sstream>
@@ -23,6 +24,7 @@
 
 #include "gdalraster.h"
 #include "rcpp_util.h"
+#include "thread_util.h"
 
 using std::string_literals::operator""s;
 
@@ -48,6 +50,15 @@ struct GDALAlgorithmArgHS
 #endif  // GDAL < 3.12
 #endif  // GDALALG_MIN_GDAL_
 
+// is this a GDALAlg object (whose output dataset may be used as input)?
+static bool is_gdalalg_obj_(const Rcpp::RObject &x) {
+    if (x.isNULL() || !x.isObject())
+        return false;
+
+    const Rcpp::String cls = x.attr("class");
+    return cls == "Rcpp_GDALAlg";
+}
+
 #if GDAL_VERSION_NUM >= GDALALG_MIN_GDAL_
 // internal helper to get subalgorithm names, descriptions and URLs,
 // potentially filtering on 'contains'
@@ -292,6 +303,11 @@ GDALAlg::GDALAlg(const Rcpp::CharacterVector &cmd, const Rcpp::RObject &args) {
 
 GDALAlg::~GDALAlg() {
 #if GDAL_VERSION_NUM >= GDALALG_MIN_GDAL_
+    if (m_async_thread.joinable()) {
+        m_async_cancel = true;
+        m_async_thread.join();
+    }
+
     if (m_hActualAlg) {
         if (m_hasRun && !m_hasFinalized)
             GDALAlgorithmFinalize(m_hActualAlg);
@@ -301,6 +317,8 @@ GDALAlg::~GDALAlg() {
     if (m_hAlg)
         GDALAlgorithmRelease(m_hAlg);
 
+    releaseInputDatasets_();
+
 #endif  // GDALALG_MIN_GDAL_
 }
 
@@ -649,6 +667,9 @@ bool GDALAlg::setArg(const Rcpp::String &arg_name,
         return false;
     }
 
+    if (!checkNotRunningAsync_())
+        return false;
+
     if (m_hasRun) {
         if (!quiet)
             cli_alert_danger_("algorithm has already run");
@@ -923,6 +944,18 @@ bool GDALAlg::setArg(const Rcpp::String &arg_name,
                 ret = GDALAlgorithmArgSetAsString(hArg, val.get_cstring());
                 break;
             }
+            else if (is_gdalalg_obj_(arg_value)) {
+                if (!(ds_input_flags & GADV_OBJECT)) {
+                    cli_alert_danger_("argument does not accept a dataset "
+                                      "object as input: "s +
+                                      arg_name_in.get_cstring());
+                    break;
+                }
+                const GDALAlg &alg = Rcpp::as<GDALAlg &>(arg_value);
+                ret = GDALAlgorithmArgSetDataset(hArg,
+                                                 alg.getOutputDatasetH_());
+                break;
+            }
             else if (is_gdalraster_obj_(arg_value)) {
                 if (!(ds_input_flags & GADV_OBJECT)) {
                     cli_alert_danger_("argument does not accept a dataset "
@@ -1036,7 +1069,8 @@ bool GDALAlg::setArg(const Rcpp::String &arg_name,
                 break;
             }
             else if (Rcpp::is<Rcpp::List>(arg_value) ||
-                     is_gdalraster_obj_(arg_value)) {
+                     is_gdalraster_obj_(arg_value) ||
+                     is_gdalalg_obj_(arg_value)) {
 
                 if (!(ds_input_flags & GADV_OBJECT)) {
                     cli_alert_danger_("argument does not accept dataset "
@@ -1046,7 +1080,7 @@ bool GDALAlg::setArg(const Rcpp::String &arg_name,
                 }
 
                 Rcpp::List ds_list;
-                if (is_gdalraster_obj_(arg_value))
+                if (is_gdalraster_obj_(arg_value) || is_gdalalg_obj_(arg_value))
                     ds_list = Rcpp::List::create(arg_value);
                 else
                     ds_list = Rcpp::List(arg_value);
@@ -1055,7 +1089,11 @@ bool GDALAlg::setArg(const Rcpp::String &arg_name,
                 bool in_vector_props_were_set = false;
                 int nInputVectorDatasets = 0;
                 for (R_xlen_t i = 0; i < ds_list.size(); ++i) {
-                    if (is_gdalraster_obj_(ds_list[i])) {
+                    if (is_gdalalg_obj_(ds_list[i])) {
+                        const GDALAlg &alg = Rcpp::as<GDALAlg &>(ds_list[i]);
+                        pahDS.push_back(alg.getOutputDatasetH_());
+                    }
+                    else if (is_gdalraster_obj_(ds_list[i])) {
                         const Rcpp::RObject &x(ds_list[i]);
                         const Rcpp::String cls = x.attr("class");
                         if (cls == "Rcpp_GDALRaster") {
@@ -1147,6 +1185,9 @@ bool GDALAlg::parseCommandLineArgs() {
         return false;
     }
 
+    if (!checkNotRunningAsync_())
+        return false;
+
     if (m_haveParsedCmdLineArgs) {
         if (!quiet)
             cli_alert_danger_("{.code parseCommandLineArgs()} can only be "
@@ -1429,43 +1470,119 @@ bool GDALAlg::run() {
     Rcpp::stop(GDALALG_MIN_GDAL_MSG_);
 #else
 
-    if (!m_hAlg) {
-        if (!quiet)
-            cli_alert_danger_("algorithm not instantiated");
+    if (!prepareRun_())
         return false;
-    }
 
-    if (m_hasRun) {
+    bool res = GDALAlgorithmRun(m_hActualAlg,
+                                quiet ? nullptr : GDALTermProgressR,
+                                nullptr);
+
+    if (res)
+        m_hasRun = true;
+
+    return res;
+#endif  // GDALALG_MIN_GDAL_
+}
+
+bool GDALAlg::runAsync() {
+#if GDAL_VERSION_NUM < GDALALG_MIN_GDAL_
+    Rcpp::stop(GDALALG_MIN_GDAL_MSG_);
+#else
+
+    if (!prepareRun_())
+        return false;
+
+    // a previous async run has completed if we get here
+    joinAsync_();
+    m_async_done = false;
+    m_async_cancel = false;
+    m_async_progress = 0.0;
+    m_async_result = false;
+    m_async_err_msg.clear();
+
+    try {
+        m_async_thread = std::thread([this]() {
+            // runs on the background thread: must not call into R
+            QuietErrorHandlerGuard_ quiet_errors;
+            CPLErrorReset();
+            const bool res = GDALAlgorithmRun(m_hActualAlg, asyncProgress_,
+                                              this);
+            if (res) {
+                m_hasRun = true;
+            }
+            else if (m_async_cancel) {
+                m_async_err_msg = "algorithm was canceled";
+            }
+            else {
+                m_async_err_msg = CPLGetLastErrorMsg();
+                if (m_async_err_msg.empty())
+                    m_async_err_msg = "algorithm run failed";
+            }
+            m_async_result = res;
+            m_async_done = true;
+        });
+    }
+    catch (const std::exception &e) {
+        m_async_done = true;
         if (!quiet)
-            cli_alert_danger_("algorithm has already run");
+            cli_alert_danger_("failed to start thread: "s + e.what());
         return false;
     }
 
-    if (!m_haveParsedCmdLineArgs) {
-        if (!parseCommandLineArgs()) {
+    return true;
+#endif  // GDALALG_MIN_GDAL_
+}
+
+bool GDALAlg::isDone() const {
+    return !isRunningAsync_();
+}
+
+bool GDALAlg::wait() {
+#if GDAL_VERSION_NUM < GDALALG_MIN_GDAL_
+    Rcpp::stop(GDALALG_MIN_GDAL_MSG_);
+#else
+
+    if (!m_async_thread.joinable()) {
+        if (!m_async_done) {
             if (!quiet)
-                cli_alert_danger_("parse command line arguments failed");
+                cli_alert_danger_("algorithm was not started with runAsync()");
             return false;
         }
+        return m_async_result;
     }
 
-    if (!m_hActualAlg) {
-        if (!quiet)
-            cli_alert_danger_("actual algorithm handle is NULL");
-        return false;
+    // progress reported by the algorithm thread is displayed from here
+    double last_progress = -1.0;
+    while (!m_async_done) {
+        if (!quiet) {
+            const double frac = m_async_progress;
+            if (frac > last_progress) {
+                GDALTermProgressR(frac, nullptr, nullptr);
+                last_progress = frac;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        Rcpp::checkUserInterrupt();
     }
 
-    bool res = GDALAlgorithmRun(m_hActualAlg,
-                                quiet ? nullptr : GDALTermProgressR,
-                                nullptr);
+    joinAsync_();
 
-    if (res)
-        m_hasRun = true;
+    if (!quiet) {
+        if (m_async_result && last_progress >= 0.0)
+            GDALTermProgressR(1.0, nullptr, nullptr);
+        else if (!m_async_result)
+            cli_alert_danger_(m_async_err_msg);
+    }
 
-    return res;
+    return m_async_result;
 #endif  // GDALALG_MIN_GDAL_
 }
 
+void GDALAlg::cancel() {
+    if (isRunningAsync_())
+        m_async_cancel = true;
+}
+
 SEXP GDALAlg::output() const {
 #if GDAL_VERSION_NUM < GDALALG_MIN_GDAL_
     Rcpp::stop(GDALALG_MIN_GDAL_MSG_);
@@ -1474,6 +1591,9 @@ SEXP GDALAlg::output() const {
     if (!m_hAlg)
         Rcpp::stop("algorithm not instantiated");
 
+    if (isRunningAsync_())
+        Rcpp::stop("algorithm is running, call wait() first");
+
     if (!m_hasRun || !m_hActualAlg)
         Rcpp::stop("algorithm has not run");
 
@@ -1502,6 +1622,9 @@ Rcpp::List GDALAlg::outputs() const {
     if (!m_hAlg)
         Rcpp::stop("algorithm not instantiated");
 
+    if (isRunningAsync_())
+        Rcpp::stop("algorithm is running, call wait() first");
+
     if (!m_hasRun || !m_hActualAlg)
         Rcpp::stop("algorithm has not run");
 
@@ -1544,6 +1667,9 @@ bool GDALAlg::close() {
         return false;
     }
 
+    if (!checkNotRunningAsync_())
+        return false;
+
     if (!m_hasRun) {
         if (!quiet)
             cli_alert_danger_("algorithm has not run");
@@ -1557,6 +1683,7 @@ bool GDALAlg::close() {
     }
 
     if (m_hActualAlg) {
+        m_hasFinalized = true;
         return GDALAlgorithmFinalize(m_hActualAlg);
     }
     else {
@@ -1572,6 +1699,11 @@ void GDALAlg::release() {
     return;
 #else
 
+    if (m_async_thread.joinable()) {
+        m_async_cancel = true;
+        m_async_thread.join();
+    }
+
     if (m_hActualAlg) {
         if (m_hasRun && !m_hasFinalized)
             GDALAlgorithmFinalize(m_hActualAlg);
@@ -1584,6 +1716,8 @@ void GDALAlg::release() {
         m_hAlg = nullptr;
     }
 
+    releaseInputDatasets_();
+
 #endif  // GDALALG_MIN_GDAL_
 }
 
@@ -1688,7 +1822,11 @@ Rcpp::CharacterVector GDALAlg::parseListArgs_(
             std::vector<GDALDatasetH> ds_list = {};
 
             for (R_xlen_t j = 0; j < list_tmp.size(); ++j) {
-                if (is_gdalraster_obj_(list_tmp[j])) {
+                if (is_gdalalg_obj_(list_tmp[j])) {
+                    const GDALAlg &alg = Rcpp::as<GDALAlg &>(list_tmp[j]);
+                    ds_list.push_back(alg.getOutputDatasetH_());
+                }
+                else if (is_gdalraster_obj_(list_tmp[j])) {
                     const Rcpp::RObject &val = list_tmp[j];
                     const Rcpp::String cls = val.attr("class");
                     if (cls == "Rcpp_GDALRaster") {
@@ -1726,7 +1864,7 @@ Rcpp::CharacterVector GDALAlg::parseListArgs_(
             }
 
             if (!ds_list.empty()) {
-                m_map_input_hDS[nm_no_lead_dashes] = ds_list;
+                setInputDatasets_(nm_no_lead_dashes, ds_list);
             }
             else {
                 cli_alert_danger_("unhandled list input for: "s +
@@ -1735,6 +1873,15 @@ Rcpp::CharacterVector GDALAlg::parseListArgs_(
             continue;
         }
 
+        // the output dataset of an algorithm that has run
+        if (is_gdalalg_obj_(list_args[i])) {
+            const GDALAlg &alg = Rcpp::as<GDALAlg &>(list_args[i]);
+            std::vector<GDALDatasetH> ds_list = {};
+            ds_list.push_back(alg.getOutputDatasetH_());
+            setInputDatasets_(nm_no_lead_dashes, ds_list);
+            continue;
+        }
+
         // potentially a single dataset
         if (is_gdalraster_obj_(list_args[i])) {
             const Rcpp::RObject &val = list_args[i];
@@ -1743,14 +1890,14 @@ Rcpp::CharacterVector GDALAlg::parseListArgs_(
                 const GDALRaster &ds = Rcpp::as<GDALRaster &>(list_args[i]);
                 std::vector<GDALDatasetH> ds_list = {};
                 ds_list.push_back(ds.getGDALDatasetH_());
-                m_map_input_hDS[nm_no_lead_dashes] = ds_list;
+                setInputDatasets_(nm_no_lead_dashes, ds_list);
                 continue;
             }
             if (cls == "Rcpp_GDALVector") {
                 const GDALVector &ds = Rcpp::as<GDALVector &>(list_args[i]);
                 std::vector<GDALDatasetH> ds_list = {};
                 ds_list.push_back(ds.getGDALDatasetH_());
-                m_map_input_hDS[nm_no_lead_dashes] = ds_list;
+                setInputDatasets_(nm_no_lead_dashes, ds_list);
 
                 // FIXME: "input" or "dataset" should be okay as of
                 // GDAL 3.13 for vector algorithms, but probably
@@ -1915,6 +2062,151 @@ void GDALAlg::instantiateAlg_() {
 #endif  // GDALALG_MIN_GDAL_
 }
 
+GDALDatasetH GDALAlg::getOutputDatasetH_() const {
+    // the dataset handle of the single dataset output of this algorithm,
+    // without adding a reference (the caller must reference it if kept)
+#if GDAL_VERSION_NUM < GDALALG_MIN_GDAL_
+    Rcpp::stop(GDALALG_MIN_GDAL_MSG_);
+#else
+
+    if (isRunningAsync_())
+        Rcpp::stop("input algorithm is running, call wait() first");
+
+    if (!m_hAlg || !m_hasRun || !m_hActualAlg)
+        Rcpp::stop("an algorithm given as input must have run");
+
+    GDALDatasetH hDS = nullptr;
+    for (const std::string &arg_name : getOutputArgNames_()) {
+        GDALAlgorithmArgH hArg = GDALAlgorithmGetArg(m_hActualAlg,
+                                                     arg_name.c_str());
+        if (!hArg)
+            continue;
+
+        if (GDALAlgorithmArgIsOutput(hArg) &&
+                GDALAlgorithmArgGetType(hArg) == GAAT_DATASET) {
+
+            GDALArgDatasetValueH hArgDSValue =
+                GDALAlgorithmArgGetAsDatasetValue(hArg);
+            if (hArgDSValue) {
+                GDALDatasetH hOut = GDALArgDatasetValueGetDatasetRef(
+                    hArgDSValue);
+                GDALArgDatasetValueRelease(hArgDSValue);
+                if (hOut && hDS) {
+                    GDALAlgorithmArgRelease(hArg);
+                    Rcpp::stop("an algorithm given as input must have a "
+                               "single output dataset");
+                }
+                if (hOut)
+                    hDS = hOut;
+            }
+        }
+        GDALAlgorithmArgRelease(hArg);
+    }
+
+    if (!hDS)
+        Rcpp::stop("the algorithm given as input has no output dataset");
+
+    return hDS;
+#endif  // GDALALG_MIN_GDAL_
+}
+
+void GDALAlg::setInputDatasets_(const std::string &arg_name,
+                                const std::vector<GDALDatasetH> &ds_list) {
+    // keep a reference on each input dataset until this object is released,
+    // so the datasets outlive the R objects they were given as
+    for (GDALDatasetH hDS : ds_list) {
+        if (hDS)
+            GDALReferenceDataset(hDS);
+    }
+
+    auto it = m_map_input_hDS.find(arg_name);
+    if (it != m_map_input_hDS.end()) {
+        for (GDALDatasetH hDS : it->second) {
+            if (hDS)
+                GDALReleaseDataset(hDS);
+        }
+    }
+
+    m_map_input_hDS[arg_name] = ds_list;
+}
+
+void GDALAlg::releaseInputDatasets_() {
+    for (auto &it : m_map_input_hDS) {
+        for (GDALDatasetH hDS : it.second) {
+            if (hDS)
+                GDALReleaseDataset(hDS);
+        }
+    }
+    m_map_input_hDS.clear();
+}
+
+bool GDALAlg::prepareRun_() {
+    // common checks for run() and runAsync()
+#if GDAL_VERSION_NUM < GDALALG_MIN_GDAL_
+    return false;
+#else
+
+    if (!m_hAlg) {
+        if (!quiet)
+            cli_alert_danger_("algorithm not instantiated");
+        return false;
+    }
+
+    if (!checkNotRunningAsync_())
+        return false;
+
+    if (m_hasRun) {
+        if (!quiet)
+            cli_alert_danger_("algorithm has already run");
+        return false;
+    }
+
+    if (!m_haveParsedCmdLineArgs) {
+        if (!parseCommandLineArgs()) {
+            if (!quiet)
+                cli_alert_danger_("parse command line arguments failed");
+            return false;
+        }
+    }
+
+    if (!m_hActualAlg) {
+        if (!quiet)
+            cli_alert_danger_("actual algorithm handle is NULL");
+        return false;
+    }
+
+    return true;
+#endif  // GDALALG_MIN_GDAL_
+}
+
+bool GDALAlg::isRunningAsync_() const {
+    return m_async_thread.joinable() && !m_async_done;
+}
+
+bool GDALAlg::checkNotRunningAsync_() const {
+    if (isRunningAsync_()) {
+        if (!quiet)
+            cli_alert_danger_("algorithm is running, call wait() first");
+        return false;
+    }
+    return true;
+}
+
+void GDALAlg::joinAsync_() {
+    if (m_async_thread.joinable())
+        m_async_thread.join();
+}
+
+int CPL_STDCALL GDALAlg::asyncProgress_(double dfComplete,
+                                        const char *pszMessage,
+                                        void *pProgressArg) {
+    // called on the algorithm thread
+    (void) pszMessage;
+    GDALAlg *alg = static_cast<GDALAlg *>(pProgressArg);
+    alg->m_async_progress = dfComplete;
+    return alg->m_async_cancel ? FALSE : TRUE;
+}
+
 std::vector<std::string> GDALAlg::getOutputArgNames_() const {
     std::vector<std::string> names_out = {};
 
@@ -2150,6 +2442,14 @@ RCPP_MODULE(mod_GDALAlg) {
         "Return a named list of explicitly set arguments and their values")
     .method("run", &GDALAlg::run,
         "Execute the algorithm")
+    .method("runAsync", &GDALAlg::runAsync,
+        "Execute the algorithm on a background thread")
+    .const_method("isDone", &GDALAlg::isDone,
+        "Return TRUE if no asynchronous run is in progress")
+    .method("wait", &GDALAlg::wait,
+        "Wait for an asynchronous run to complete and return its status")
+    .method("cancel", &GDALAlg::cancel,
+        "Request cancellation of an asynchronous run")
     .const_method("output", &GDALAlg::output,
         "Return the single output value of this algorithm")
     .const_method("outputs", &GDALAlg::outputs,
@@ -14,8 +14,10 @@
 
 #include <Rcpp.h>
 
+#include <atomic>
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "gdalvector.h"
@@ -63,6 +65,10 @@ class GDALAlg {
     bool parseCommandLineArgs();
     Rcpp::List getExplicitlySetArgs() const;
     bool run();
+    bool runAsync();
+    bool isDone() const;
+    bool wait();
+    void cancel();
     SEXP output() const;
     Rcpp::List outputs() const;
     bool close();
@@ -74,6 +80,14 @@ class GDALAlg {
     Rcpp::CharacterVector parseListArgs_(const Rcpp::List &list_args);
     void instantiateAlg_();
     std::vector<std::string> getOutputArgNames_() const;
+    bool prepareRun_();
+    GDALDatasetH getOutputDatasetH_() const;
+    void setInputDatasets_(const std::string &arg_name,
+                           const std::vector<GDALDatasetH> &ds_list);
+    void releaseInputDatasets_();
+    bool isRunningAsync_() const;
+    bool checkNotRunningAsync_() const;
+    void joinAsync_();
 #if __has_include(<gdalalgorithm.h>)
     SEXP getArgValue_(const GDALAlgorithmArgH &hArg) const;
 #endif
@@ -87,10 +101,22 @@ class GDALAlg {
     GDALAlgorithmH m_hAlg {nullptr};
     GDALAlgorithmH m_hActualAlg {nullptr};
 #endif
+    // dataset handles given as objects, each holding a reference
     std::map<std::string, std::vector<GDALDatasetH>> m_map_input_hDS {};
     size_t m_num_input_datasets {0};
     VectorObjectProperties m_in_vector_props;
     VectorObjectProperties m_like_vector_props;
+
+    // state for runAsync(), the algorithm runs on m_async_thread
+    static int CPL_STDCALL asyncProgress_(double dfComplete,
+                                          const char *pszMessage,
+                                          void *pProgressArg);
+    std::thread m_async_thread {};
+    std::atomic<bool> m_async_done {false};
+    std::atomic<bool> m_async_cancel {false};
+    std::atomic<double> m_async_progress {0.0};
+    bool m_async_result {false};
+    std::string m_async_err_msg {};
 };
 
 // cppcheck-suppress unknownMacro
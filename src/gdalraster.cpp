@@ -19,20 +19,29 @@
 #include <R_ext/GraphicsEngine.h>  // for R_RGB and R_RGBA
 
 #include <algorithm>
+#include <chrono>
+#include <climits>
 #include <cmath>
 #include <complex>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <map>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "gdalraster.h"
+#include "dataset_pool.h"
 #include "gdal_vsi.h"
+#include "mmap_altrep.h"
 #include "rcpp_util.h"
+#include "read_ahead.h"
 #include "transform.h"
+#include "thread_util.h"
+#include "warped_vrt_pool.h"
 
 using std::string_literals::operator""s;
 
@@ -288,7 +297,16 @@ GDALRaster::GDALRaster(const Rcpp::CharacterVector &filename, bool read_only,
 }
 
 GDALRaster::~GDALRaster() {
-    if (m_hDataset) {
+    if (m_hDataset && m_pooled) {
+        WarpedVRTPool_::instance().release(m_hDataset);
+    }
+    else if (m_hDataset && m_ds_pooled) {
+        DatasetPool_::instance().release(m_hDataset);
+    }
+    else if (m_hDataset) {
+        // pooled read-only handles on the file would be stale after update
+        if (m_eAccess == GA_Update && m_fname != "")
+            DatasetPool_::instance().evict(m_fname);
         // use GDALClose() on shared, and driver-less datasets such as the one
         // returned by mdim_as_classic()
         if (m_shared || !GDALGetDatasetDriver(m_hDataset))
@@ -1307,6 +1325,134 @@ void GDALRaster::buildOverviews(const std::string &resampling,
     }
 }
 
+Rcpp::DataFrame GDALRaster::buildOverviewsCascade(
+        const std::string &resampling, std::vector<int> levels,
+        std::vector<int> bands, int num_threads) {
+
+    checkAccess_(GA_ReadOnly);
+
+    if (levels.empty())
+        Rcpp::stop("'levels' must contain at least one overview level");
+    for (int lvl : levels) {
+        if (lvl < 2)
+            Rcpp::stop("overview levels must be integers >= 2");
+    }
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+
+    if (bands.size() == 1 && bands[0] == 0) {
+        bands.resize(GDALGetRasterCount(m_hDataset));
+        std::iota(bands.begin(), bands.end(), 1);
+    }
+    for (int b : bands)
+        getBand_(b);
+
+    const int nlevels = static_cast<int>(levels.size());
+    const int nbands = static_cast<int>(bands.size());
+    const int raster_xsize = GDALGetRasterXSize(m_hDataset);
+    const int raster_ysize = GDALGetRasterYSize(m_hDataset);
+
+    // create the overview bands without computing them
+    CPLErr err = GDALBuildOverviews(m_hDataset, "NONE", nlevels,
+                                    levels.data(), nbands, bands.data(),
+                                    nullptr, nullptr);
+    if (err == CE_Failure)
+        Rcpp::stop("failed to create overview bands");
+
+    // overview band handles by band and level
+    std::vector<std::vector<GDALRasterBandH>> ovr_bands(nbands);
+    std::vector<int> ovr_xsize(nlevels, 0);
+    std::vector<int> ovr_ysize(nlevels, 0);
+    for (int i = 0; i < nbands; ++i) {
+        GDALRasterBandH hBand = getBand_(bands[i]);
+        const int novr = GDALGetOverviewCount(hBand);
+        for (int j = 0; j < nlevels; ++j) {
+            const int want_xsize = (raster_xsize + levels[j] - 1) / levels[j];
+            const int want_ysize = (raster_ysize + levels[j] - 1) / levels[j];
+            GDALRasterBandH hOvr = nullptr;
+            int best_diff = -1;
+            for (int k = 0; k < novr; ++k) {
+                GDALRasterBandH hCand = GDALGetOverview(hBand, k);
+                if (hCand == nullptr)
+                    continue;
+                const int diff =
+                    std::abs(GDALGetRasterBandXSize(hCand) - want_xsize) +
+                    std::abs(GDALGetRasterBandYSize(hCand) - want_ysize);
+                if (best_diff < 0 || diff < best_diff) {
+                    best_diff = diff;
+                    hOvr = hCand;
+                }
+            }
+            if (hOvr == nullptr) {
+                Rcpp::stop("overview level " + std::to_string(levels[j]) +
+                           " not found for band " + std::to_string(bands[i]));
+            }
+            ovr_bands[i].push_back(hOvr);
+            ovr_xsize[j] = GDALGetRasterBandXSize(hOvr);
+            ovr_ysize[j] = GDALGetRasterBandYSize(hOvr);
+        }
+    }
+
+    // progress is scaled by the number of source pixels read for each level
+    std::vector<double> work(nlevels);
+    double total_work = 0;
+    for (int j = 0; j < nlevels; ++j) {
+        const double src_xsize = j == 0 ? raster_xsize : ovr_xsize[j - 1];
+        const double src_ysize = j == 0 ? raster_ysize : ovr_ysize[j - 1];
+        work[j] = src_xsize * src_ysize * nbands;
+        total_work += work[j];
+    }
+
+    // GDAL computes overviews on GDAL_NUM_THREADS worker threads
+    const int nthreads = resolve_num_threads_(num_threads, INT_MAX);
+    ThreadLocalConfigOptionGuard_ num_threads_option(
+        "GDAL_NUM_THREADS", std::to_string(nthreads));
+
+    Rcpp::NumericVector elapsed(nlevels);
+    double work_done = 0;
+    if (!quiet)
+        GDALTermProgressR(0.0, nullptr, nullptr);
+
+    for (int j = 0; j < nlevels && err != CE_Failure; ++j) {
+        const auto t_start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nbands && err != CE_Failure; ++i) {
+            // each level is computed from the previous one
+            GDALRasterBandH hSrc = j == 0 ? getBand_(bands[i])
+                                          : ovr_bands[i][j - 1];
+            GDALRasterBandH hOvr = ovr_bands[i][j];
+            const double band_work = work[j] / nbands;
+            void *pScaled = nullptr;
+            if (!quiet) {
+                pScaled = GDALCreateScaledProgress(
+                    work_done / total_work,
+                    (work_done + band_work) / total_work,
+                    GDALTermProgressR, nullptr);
+            }
+            err = GDALRegenerateOverviews(hSrc, 1, &hOvr, resampling.c_str(),
+                                          quiet ? nullptr
+                                                : GDALScaledProgress,
+                                          pScaled);
+            if (pScaled != nullptr)
+                GDALDestroyScaledProgress(pScaled);
+            work_done += band_work;
+        }
+        // the next level reads what was just written
+        if (err != CE_Failure)
+            GDALFlushCache(m_hDataset);
+        elapsed[j] = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_start).count();
+    }
+
+    if (err == CE_Failure)
+        Rcpp::stop("build overviews failed");
+
+    return Rcpp::DataFrame::create(
+        Rcpp::Named("level") = Rcpp::wrap(levels),
+        Rcpp::Named("xsize") = Rcpp::wrap(ovr_xsize),
+        Rcpp::Named("ysize") = Rcpp::wrap(ovr_ysize),
+        Rcpp::Named("elapsed") = elapsed);
+}
+
 std::string GDALRaster::getDataTypeName(int band) const {
     checkAccess_(GA_ReadOnly);
 
@@ -1963,6 +2109,9 @@ SEXP GDALRaster::read(int band, int xoff, int yoff, int xsize, int ysize,
     if (hBand == nullptr)
         Rcpp::stop("failed to access the requested band");
 
+    if (m_read_ahead)
+        m_read_ahead->onRead(band, xoff, yoff, xsize, ysize);
+
     const GDALDataType eDT = GDALGetRasterDataType(hBand);
 
     const R_xlen_t buf_size = static_cast<R_xlen_t>(out_xsize) * out_ysize;
@@ -2205,6 +2354,74 @@ SEXP GDALRaster::readToNativeRaster(int xoff, int yoff, int xsize, int ysize,
     return res;
 }
 
+SEXP GDALRaster::readMapped(int band) const {
+    checkAccess_(GA_ReadOnly);
+    getBand_(band);
+
+    if (m_fname.empty())
+        Rcpp::stop("memory-mapped read requires a dataset with a filename");
+
+    return make_mapped_band_(m_fname, getOpenOptions_(), band);
+}
+
+void GDALRaster::setReadAhead(int num_block_rows) {
+    if (!isOpen())
+        Rcpp::stop("dataset is not open");
+
+    if (num_block_rows < 0)
+        Rcpp::stop("'num_block_rows' must be >= 0");
+
+    m_read_ahead.reset();
+    if (num_block_rows == 0)
+        return;
+
+    if (m_eAccess != GA_ReadOnly)
+        Rcpp::stop("read-ahead requires a dataset opened read-only");
+
+    // read-ahead runs on its own handle, since a dataset handle must not be
+    // used concurrently from more than one thread
+    WorkerDatasets_ worker_ds(this, 1);
+    if (worker_ds.empty()) {
+        Rcpp::stop("read-ahead is not available for this dataset (it "
+                   "cannot be reopened by name)");
+    }
+
+    m_read_ahead = std::make_shared<ReadAhead_>(worker_ds.take(0),
+                                                num_block_rows);
+}
+
+void GDALRaster::waitReadAhead() const {
+    if (m_read_ahead)
+        m_read_ahead->wait();
+}
+
+Rcpp::List GDALRaster::getReadAheadStats() const {
+    ReadAheadStats_ stats {};
+    int block_rows = 0;
+    if (m_read_ahead) {
+        stats = m_read_ahead->stats();
+        block_rows = m_read_ahead->numBlockRows();
+    }
+
+    double hit_rate = NA_REAL;
+    if (stats.reads > 0)
+        hit_rate = static_cast<double>(stats.hits) / stats.reads;
+
+    Rcpp::List list_out = Rcpp::List::create(
+        Rcpp::Named("enabled") = static_cast<bool>(m_read_ahead),
+        Rcpp::Named("block_rows") = block_rows,
+        Rcpp::Named("reads") = static_cast<double>(stats.reads),
+        Rcpp::Named("sequential_reads") =
+            static_cast<double>(stats.sequential_reads),
+        Rcpp::Named("hits") = static_cast<double>(stats.hits),
+        Rcpp::Named("misses") = static_cast<double>(stats.misses),
+        Rcpp::Named("hit_rate") = hit_rate,
+        Rcpp::Named("rows_prefetched") =
+            static_cast<double>(stats.rows_prefetched));
+
+    return list_out;
+}
+
 void GDALRaster::write(int band, int xoff, int yoff, int xsize, int ysize,
                        const Rcpp::RObject &rasterData) {
 
@@ -2923,25 +3140,41 @@ int GDALRaster::getChecksum(int band, int xoff, int yoff, int xsize,
 }
 
 void GDALRaster::close() {
+    m_read_ahead.reset();
+
     if (m_hDataset == nullptr)
         return;
 
-#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 7, 0)
-    // use GDALClose() on shared, and driver-less datasets such as the one
-    // returned by mdim_as_classic()
-    if (m_shared || !GDALGetDatasetDriver(m_hDataset)) {
-        if (GDALClose(m_hDataset) != CE_None)
-            Rcpp::warning("error occurred during GDALClose()!");
+    if (m_pooled) {
+        WarpedVRTPool_::instance().release(m_hDataset);
+        m_pooled = false;
     }
-    else {
-        GDALReleaseDataset(m_hDataset);
+    else if (m_ds_pooled) {
+        DatasetPool_::instance().release(m_hDataset);
+        m_ds_pooled = false;
     }
+    else {
+        // pooled read-only handles on the file would be stale after update
+        if (m_eAccess == GA_Update && m_fname != "")
+            DatasetPool_::instance().evict(m_fname);
+
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 7, 0)
+        // use GDALClose() on shared, and driver-less datasets such as the one
+        // returned by mdim_as_classic()
+        if (m_shared || !GDALGetDatasetDriver(m_hDataset)) {
+            if (GDALClose(m_hDataset) != CE_None)
+                Rcpp::warning("error occurred during GDALClose()!");
+        }
+        else {
+            GDALReleaseDataset(m_hDataset);
+        }
 #else
-    if (m_shared || !GDALGetDatasetDriver(m_hDataset))
-        GDALClose(m_hDataset);
-    else
-        GDALReleaseDataset(m_hDataset);
+        if (m_shared || !GDALGetDatasetDriver(m_hDataset))
+            GDALClose(m_hDataset);
+        else
+            GDALReleaseDataset(m_hDataset);
 #endif
+    }
 
     m_hDataset = nullptr;
 
@@ -3023,6 +3256,28 @@ bool GDALRaster::preserveRObject_(SEXP robj) {
     return true;
 }
 
+void GDALRaster::openFromPool_(
+        const Rcpp::CharacterVector &filename, bool read_only,
+        const Rcpp::Nullable<Rcpp::CharacterVector> &open_options) {
+
+    if (m_hDataset != nullptr)
+        Rcpp::stop("the object already has an open dataset");
+
+    m_fname = Rcpp::as<std::string>(check_gdal_filename(filename));
+    if (open_options.isNotNull())
+        m_open_options = open_options;
+    else
+        m_open_options = Rcpp::CharacterVector::create();
+
+    GDALDatasetH hDS = DatasetPool_::instance().acquire(
+        m_fname, read_only, "", getOpenOptions_());
+    if (hDS == nullptr)
+        Rcpp::stop("open raster failed");
+
+    setGDALDatasetH_(hDS);
+    m_ds_pooled = true;
+}
+
 // ****************************************************************************
 // class methods for internal use not exposed in R
 // ****************************************************************************
@@ -3090,7 +3345,10 @@ GDALDatasetH GDALRaster::getGDALDatasetH_() const {
 }
 
 void GDALRaster::setGDALDatasetH_(GDALDatasetH hDs) {
+    m_read_ahead.reset();
     m_hDataset = hDs;
+    m_pooled = false;
+    m_ds_pooled = false;
     if (m_hDataset) {
         if (GDALGetAccess(m_hDataset) == GA_ReadOnly)
             m_eAccess = GA_ReadOnly;
@@ -3114,6 +3372,14 @@ bool GDALRaster::isMEM_() const {
         return false;
 }
 
+std::vector<std::string> GDALRaster::getOpenOptions_() const {
+    std::vector<std::string> oo = {};
+    for (R_xlen_t i = 0; i < m_open_options.size(); ++i) {
+        oo.push_back(Rcpp::as<std::string>(m_open_options[i]));
+    }
+    return oo;
+}
+
 // ****************************************************************************
 
 RCPP_MODULE(mod_GDALRaster) {
@@ -3230,6 +3496,8 @@ RCPP_MODULE(mod_GDALRaster) {
         "Return the number of overview layers available")
     .method("buildOverviews", &GDALRaster::buildOverviews,
         "Build raster overview(s)")
+    .method("buildOverviewsCascade", &GDALRaster::buildOverviewsCascade,
+        "Build raster overview(s) with each level computed from the previous")
     .const_method("getDataTypeName", &GDALRaster::getDataTypeName,
         "Get name of the data type for this band")
     .const_method("getNoDataValue", &GDALRaster::getNoDataValue,
@@ -3294,6 +3562,14 @@ RCPP_MODULE(mod_GDALRaster) {
         "Read a multi-block user-defined chunk of raster data")
     .const_method("readToNativeRaster", &GDALRaster::readToNativeRaster,
         "Read raster data as an object of class nativeRaster")
+    .const_method("readMapped", &GDALRaster::readMapped,
+        "Return a band as a vector backed by a memory mapping of the file")
+    .method("setReadAhead", &GDALRaster::setReadAhead,
+        "Enable background read-ahead of block rows for sequential reads")
+    .const_method("waitReadAhead", &GDALRaster::waitReadAhead,
+        "Wait until pending background read-ahead has completed")
+    .const_method("getReadAheadStats", &GDALRaster::getReadAheadStats,
+        "Return read-ahead statistics as a list")
     .method("write", &GDALRaster::write,
         "Write a region of raster data for a band")
     .method("writeBlock", &GDALRaster::writeBlock,
@@ -3324,6 +3600,8 @@ RCPP_MODULE(mod_GDALRaster) {
         "S4 show()")
     .method("preserveRObject_", &GDALRaster::preserveRObject_,
         "For internal use only")
+    .method("openFromPool_", &GDALRaster::openFromPool_,
+        "For internal use only")
 
     ;
 }
@@ -19,6 +19,7 @@ void gdal_error_handler_r(CPLErr err_class, int err_no, const char *msg);
 void gdal_silent_errors_r(CPLErr err_class, int err_no, const char *msg);
 #endif
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,7 @@ typedef void *GDALRasterBandH;
 typedef enum {GA_ReadOnly = 0, GA_Update = 1} GDALAccess;
 #endif
 
+class ReadAhead_;
 
 class GDALRaster {
  public:
@@ -101,6 +103,10 @@ class GDALRaster {
     int getOverviewCount(int band) const;
     void buildOverviews(const std::string &resampling, std::vector<int> levels,
                         std::vector<int> bands);
+    Rcpp::DataFrame buildOverviewsCascade(const std::string &resampling,
+                                          std::vector<int> levels,
+                                          std::vector<int> bands,
+                                          int num_threads);
 
     std::string getDataTypeName(int band) const;
     bool hasNoDataValue(int band) const;
@@ -157,6 +163,12 @@ class GDALRaster {
     SEXP readToNativeRaster(int xoff, int yoff, int xsize, int ysize,
                             int out_xsize, int out_ysize) const;
 
+    SEXP readMapped(int band) const;
+
+    void setReadAhead(int num_block_rows);
+    void waitReadAhead() const;
+    Rcpp::List getReadAheadStats() const;
+
     void write(int band, int xoff, int yoff, int xsize, int ysize,
                const Rcpp::RObject &rasterData);
 
@@ -187,6 +199,9 @@ class GDALRaster {
 
     // internal methods exported to R
     bool preserveRObject_(SEXP robj);
+    void openFromPool_(const Rcpp::CharacterVector &filename, bool read_only,
+                       const Rcpp::Nullable<Rcpp::CharacterVector>
+                           &open_options);
 
     // methods for internal use not exported to R
     void checkAccess_(GDALAccess access_needed) const;
@@ -196,7 +211,10 @@ class GDALRaster {
     void warnInt64_() const;
     GDALDatasetH getGDALDatasetH_() const;
     void setGDALDatasetH_(GDALDatasetH hDs);
+    // the dataset is held from WarpedVRTPool_ and is returned there on close
+    void setPooled_(bool pooled) { m_pooled = pooled; }
     bool isMEM_() const;
+    std::vector<std::string> getOpenOptions_() const;
 
  private:
     std::string m_fname {};
@@ -205,7 +223,11 @@ class GDALRaster {
     GDALDatasetH m_hDataset {nullptr};
     GDALAccess m_eAccess {GA_ReadOnly};
     bool m_shared {false};
+    bool m_pooled {false};
+    // the dataset is held from DatasetPool_, see openFromPool_()
+    bool m_ds_pooled {false};
     std::vector<SEXP> m_preserved_r_objects {};
+    std::shared_ptr<ReadAhead_> m_read_ahead {};
 };
 
 // cppcheck-suppress unknownMacro
@@ -322,7 +344,7 @@ GDALRaster *autoCreateWarpedVRT(const GDALRaster* const &src_ds,
                                 const std::string &resample_alg,
                                 const std::string &src_wkt,
                                 double max_err, bool alpha_band,
-                                bool reserved1, bool reserved2);
+                                bool use_pool, bool reserved);
 
 bool buildVRT(const Rcpp::CharacterVector &vrt_filename,
               const Rcpp::CharacterVector &input_rasters,
@@ -348,11 +370,20 @@ bool dem_proc(const std::string &mode,
               const Rcpp::Nullable<Rcpp::String> &col_file,
               bool quiet);
 
-bool fillNodata(const Rcpp::CharacterVector &filename, int band,
+SEXP fillNodata(const Rcpp::CharacterVector &filename, int band,
                 const Rcpp::CharacterVector &mask_file,
                 double max_dist, int smooth_iterations,
+                const std::string &interpolation, int num_threads,
+                const Rcpp::Nullable<Rcpp::IntegerVector> &tile_size,
                 bool quiet);
 
+SEXP fill_nodata_tiles_(const Rcpp::CharacterVector &filename, int band,
+                        const Rcpp::CharacterVector &mask_file,
+                        double max_dist, int smooth_iterations,
+                        const std::string &interpolation,
+                        const Rcpp::IntegerVector &tile_size,
+                        int num_threads, bool quiet);
+
 bool footprint(const Rcpp::CharacterVector &src_filename,
                const Rcpp::CharacterVector &dst_filename,
                const Rcpp::Nullable<Rcpp::CharacterVector> &cl_arg);
@@ -385,8 +416,18 @@ bool sieveFilter(const Rcpp::CharacterVector &src_filename, int src_band,
                  int size_threshold, int connectedness,
                  const Rcpp::CharacterVector &mask_filename , int mask_band,
                  const Rcpp::Nullable<Rcpp::CharacterVector> &options,
+                 int num_threads,
+                 const Rcpp::Nullable<Rcpp::IntegerVector> &tile_size,
                  bool quiet);
 
+bool sieve_filter_tiles_(const Rcpp::CharacterVector &src_filename,
+                         int src_band,
+                         const Rcpp::CharacterVector &dst_filename,
+                         int dst_band, int size_threshold, int connectedness,
+                         const Rcpp::CharacterVector &mask_filename,
+                         int mask_band, const Rcpp::IntegerVector &tile_size,
+                         int num_threads, bool quiet);
+
 bool translate(const GDALRaster* const &ds,
                const Rcpp::CharacterVector &dst_filename,
                const Rcpp::Nullable<Rcpp::CharacterVector> &cl_arg,
@@ -0,0 +1,224 @@
+/* Bookkeeping shared by the pools of dataset handles
+
+   DatasetPool_ (raster handles for worker threads), OGRDatasetPool_ (vector
+   handles for the ogr_manage helpers) and WarpedVRTPool_ (warped VRTs) all
+   keep a list of open dataset handles that are either in use by one holder
+   or idle, hand out idle handles again by key, and close idle handles to
+   stay within a capacity, after a timeout, or when the file was modified.
+   HandlePool_ implements that list. The pools differ in how a handle is
+   known to be in use, which is given by the Tracking policy:
+
+   - InUseFlag_: the pool is told when a handle is returned (release()), and
+     keeps an in-use flag.
+   - RefCount_: the holder gives the handle up with GDALReleaseDataset(),
+     and the handle is idle when the pool holds the only reference.
+
+   HandlePool_ does no locking. The pools call it with their own mutex held,
+   and open new handles without the lock held.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef HANDLE_POOL_H_
+#define HANDLE_POOL_H_
+
+#include <gdal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct HandlePoolEntry_ {
+    std::string key {};      // handles with the same key are interchangeable
+    std::string group {};    // the file or DSN, for eviction after an update
+    std::string driver {};   // short name of the driver that opened it
+    GDALDatasetH hDS {nullptr};
+    bool in_use {false};
+    bool update {false};
+    uint64_t tick {0};       // order of last use
+    std::chrono::steady_clock::time_point last_used {};
+};
+
+struct InUseFlag_ {
+    static bool idle(const HandlePoolEntry_ &e) { return !e.in_use; }
+    static void take(HandlePoolEntry_ *e) { e->in_use = true; }
+    static void give_back(HandlePoolEntry_ *e) { e->in_use = false; }
+    // the holder closes the handle on release, since it is not found
+    static void forget(HandlePoolEntry_ *) {}
+};
+
+struct RefCount_ {
+    static bool idle(const HandlePoolEntry_ &e) {
+        // the holder's reference is gone when only the pool's remains
+        const int ref_count = GDALReferenceDataset(e.hDS);
+        GDALDereferenceDataset(e.hDS);
+        return ref_count <= 2;
+    }
+    static void take(HandlePoolEntry_ *e) { GDALReferenceDataset(e->hDS); }
+    static void give_back(HandlePoolEntry_ *e) { GDALReleaseDataset(e->hDS); }
+    // drop the pool's reference, the holder's reference keeps it open
+    static void forget(HandlePoolEntry_ *e) { GDALReleaseDataset(e->hDS); }
+};
+
+template <typename Tracking>
+class HandlePool_ {
+ public:
+    using Clock_ = std::chrono::steady_clock;
+
+    // Returns an idle handle on key, marked in use (nullptr if none).
+    // driver, if not empty, must match the driver of the handle.
+    GDALDatasetH takeIdle(const std::string &key,
+                          const std::string &driver = "") {
+        for (HandlePoolEntry_ &e : m_entries) {
+            if (e.key == key && (driver.empty() || e.driver == driver) &&
+                    Tracking::idle(e)) {
+                Tracking::take(&e);
+                touch_(&e);
+                return e.hDS;
+            }
+        }
+        return nullptr;
+    }
+
+    // Adds a handle opened by the caller, marked in use.
+    void add(HandlePoolEntry_ entry) {
+        Tracking::take(&entry);
+        touch_(&entry);
+        m_entries.push_back(std::move(entry));
+    }
+
+    // The entry of hDS, nullptr if the handle is not pooled.
+    HandlePoolEntry_ *find(GDALDatasetH hDS) {
+        auto it = std::find_if(m_entries.begin(), m_entries.end(),
+            [hDS](const HandlePoolEntry_ &e) { return e.hDS == hDS; });
+        return it == m_entries.end() ? nullptr : &(*it);
+    }
+
+    // Marks the entry of a pooled handle as idle.
+    void giveBack(HandlePoolEntry_ *e) {
+        Tracking::give_back(e);
+        touch_(e);
+    }
+
+    // Removes a pooled handle without marking it idle, and closes it.
+    void remove(GDALDatasetH hDS) {
+        for (std::size_t i = m_entries.size(); i-- > 0; ) {
+            if (m_entries[i].hDS == hDS)
+                close_(i);
+        }
+    }
+
+    // Closes the idle handles in group other than hDS. Returns the number
+    // closed.
+    std::size_t closeIdleInGroup(const std::string &group,
+                                 GDALDatasetH except = nullptr) {
+        std::size_t n = 0;
+        for (std::size_t i = m_entries.size(); i-- > 0; ) {
+            if (m_entries[i].hDS != except && m_entries[i].group == group &&
+                    Tracking::idle(m_entries[i])) {
+                close_(i);
+                n += 1;
+            }
+        }
+        return n;
+    }
+
+    // Closes the idle handles not used for more than timeout_sec seconds.
+    std::size_t closeExpired(double timeout_sec) {
+        const Clock_::time_point now = Clock_::now();
+        std::size_t n = 0;
+        for (std::size_t i = m_entries.size(); i-- > 0; ) {
+            const double idle_sec = std::chrono::duration<double>(
+                now - m_entries[i].last_used).count();
+            if (idle_sec > timeout_sec && Tracking::idle(m_entries[i])) {
+                close_(i);
+                n += 1;
+            }
+        }
+        return n;
+    }
+
+    // Closes the least recently used idle handles beyond max_idle.
+    std::size_t trimIdle(std::size_t max_idle) {
+        std::vector<std::size_t> idle;
+        for (std::size_t i = 0; i < m_entries.size(); ++i) {
+            if (Tracking::idle(m_entries[i]))
+                idle.push_back(i);
+        }
+        if (idle.size() <= max_idle)
+            return 0;
+
+        std::sort(idle.begin(), idle.end(),
+                  [this](std::size_t a, std::size_t b) {
+                      return m_entries[a].tick < m_entries[b].tick;
+                  });
+        idle.resize(idle.size() - max_idle);
+        std::sort(idle.begin(), idle.end());
+        for (auto it = idle.rbegin(); it != idle.rend(); ++it)
+            close_(*it);
+        return idle.size();
+    }
+
+    // Closes idle handles, least recently used first, until at most
+    // max_size handles are pooled or none is idle.
+    std::size_t trimTotal(std::size_t max_size) {
+        std::size_t idle = 0;
+        for (const HandlePoolEntry_ &e : m_entries) {
+            if (Tracking::idle(e))
+                idle += 1;
+        }
+        if (m_entries.size() <= max_size)
+            return 0;
+        const std::size_t excess = m_entries.size() - max_size;
+        return trimIdle(idle > excess ? idle - excess : 0);
+    }
+
+    // Closes all idle handles. If forget_in_use, the handles in use are
+    // also dropped from the pool, and stay valid for their holders.
+    void clear(bool forget_in_use) {
+        for (std::size_t i = m_entries.size(); i-- > 0; ) {
+            if (Tracking::idle(m_entries[i])) {
+                close_(i);
+            }
+            else if (forget_in_use) {
+                Tracking::forget(&m_entries[i]);
+                m_entries.erase(m_entries.begin() + i);
+            }
+        }
+    }
+
+    // Drops all entries without closing them (e.g., in a forked child).
+    void forgetAll() { m_entries.clear(); }
+
+    std::size_t size() const { return m_entries.size(); }
+
+    std::size_t inUse() const {
+        std::size_t n = 0;
+        for (const HandlePoolEntry_ &e : m_entries) {
+            if (!Tracking::idle(e))
+                n += 1;
+        }
+        return n;
+    }
+
+ private:
+    void touch_(HandlePoolEntry_ *e) {
+        e->tick = ++m_tick;
+        e->last_used = Clock_::now();
+    }
+
+    void close_(std::size_t i) {
+        GDALReleaseDataset(m_entries[i].hDS);
+        m_entries.erase(m_entries.begin() + i);
+    }
+
+    std::vector<HandlePoolEntry_> m_entries {};
+    uint64_t m_tick {0};
+};
+
+#endif  // HANDLE_POOL_H_
@@ -0,0 +1,468 @@
+/* Connected region labeling of a raster band, with region statistics
+
+   The raster is processed in tiles, in at most two passes over the source:
+
+   1. Tiles are read on worker threads, with a one-pixel halo, and labeled
+      (region_label.h). For each region of a tile, the pixel count, the
+      number of pixel sides on the region boundary, the pixel bounding box,
+      the value and the first pixel are computed. A pixel side is on the
+      boundary if the pixel across it is outside the raster, invalid or has a
+      different value, which the halo makes exact at tile edges. On the main
+      thread, regions continuing across seams are connected with
+      TileSeamMerger_ as tiles are added. Once all tiles are done, the
+      statistics of the pieces of each region are combined, and regions are
+      numbered in order of their first pixel in raster scan order, which does
+      not depend on the tile size.
+
+   2. If a label raster is requested, tiles are read and labeled again on
+      worker threads (labeling is deterministic, so the labels are those of
+      the first pass), local labels are replaced with region numbers, and
+      the output is written on the main thread.
+
+   Memory use is proportional to the tile size times the number of threads,
+   plus about 100 bytes per region piece of the raster (the statistics, root
+   and region number of each piece, and the seam union-find), where a region
+   is counted once in each tile that it overlaps.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+
+#include <Rcpp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gdalraster.h"
+#include "rcpp_util.h"
+#include "region_label.h"
+#include "thread_util.h"
+
+struct RegionStats_ {
+    int64_t count {0};
+    // boundary pixel sides along rows (top/bottom) and columns (left/right)
+    int64_t row_sides {0};
+    int64_t col_sides {0};
+    int col_min {std::numeric_limits<int>::max()};
+    int col_max {-1};
+    int row_min {std::numeric_limits<int>::max()};
+    int row_max {-1};
+    double value {0};
+    int64_t first {-1};
+};
+
+struct LabelTile_ {
+    int xoff {0};
+    int yoff {0};
+    int xsize {0};
+    int ysize {0};
+    std::vector<RegionStats_> regions {};  // by local label - 1
+    TileEdges_ edges {};
+    std::vector<int32_t> out {};
+};
+
+// Reads a window of values and validity (band mask, and not NaN).
+static CPLErr read_window_(GDALRasterBandH hBand, int xoff, int yoff,
+                           int xsize, int ysize, std::vector<double> *values,
+                           std::vector<unsigned char> *valid) {
+
+    const std::size_t num_pixels = static_cast<std::size_t>(xsize) * ysize;
+    values->resize(num_pixels);
+    valid->resize(num_pixels);
+
+    CPLErr err = GDALRasterIO(hBand, GF_Read, xoff, yoff, xsize, ysize,
+                              values->data(), xsize, ysize, GDT_Float64, 0, 0);
+    if (err == CE_None) {
+        err = GDALRasterIO(GDALGetMaskBand(hBand), GF_Read, xoff, yoff, xsize,
+                           ysize, valid->data(), xsize, ysize, GDT_Byte, 0, 0);
+    }
+    for (std::size_t i = 0; i < num_pixels; ++i) {
+        if (std::isnan((*values)[i]))
+            (*valid)[i] = 0;
+    }
+    return err;
+}
+
+//' Label the connected regions of a raster band and compute their statistics
+//'
+//' Called from and documented in R/label_regions.R
+//' @noRd
+// [[Rcpp::export(name = ".label_regions")]]
+Rcpp::DataFrame label_regions_ds(const GDALRaster* const &ds, int band,
+                                 int connectedness,
+                                 const GDALRaster* const &dst_ds,
+                                 const Rcpp::IntegerVector &tile_size,
+                                 int num_threads, bool quiet) {
+
+    if (connectedness != 4 && connectedness != 8)
+        Rcpp::stop("'connectedness' must be 4 or 8");
+    if (tile_size.size() != 2 || tile_size[0] < 1 || tile_size[1] < 1)
+        Rcpp::stop("'tile_size' must contain two values > 0");
+    if (static_cast<double>(tile_size[0]) * tile_size[1] > INT32_MAX)
+        Rcpp::stop("'tile_size' is too large");
+
+    ds->checkAccess_(GA_ReadOnly);
+    ds->getBand_(band);
+
+    const int nx = static_cast<int>(ds->getRasterXSize());
+    const int ny = static_cast<int>(ds->getRasterYSize());
+    double gt[6] = {0, 1, 0, 0, 0, 1};
+    GDALGetGeoTransform(ds->getGDALDatasetH_(), gt);
+
+    const bool write_labels = dst_ds->isOpen();
+    GDALRasterBandH hDstBand = nullptr;
+    if (write_labels) {
+        dst_ds->checkAccess_(GA_Update);
+        hDstBand = GDALGetRasterBand(dst_ds->getGDALDatasetH_(), 1);
+        if (hDstBand == nullptr)
+            Rcpp::stop("failed to access the destination band");
+        if (dst_ds->getRasterXSize() != nx ||
+                dst_ds->getRasterYSize() != ny) {
+            Rcpp::stop("the destination raster must have the same "
+                       "dimensions as the source raster");
+        }
+    }
+
+    // tile grid
+    const int ntx = (nx + tile_size[0] - 1) / tile_size[0];
+    const int nty = (ny + tile_size[1] - 1) / tile_size[1];
+    const std::size_t num_tiles = static_cast<std::size_t>(ntx) * nty;
+
+    int nthreads = resolve_num_threads_(num_threads, num_tiles);
+    std::unique_ptr<WorkerDatasets_> worker_ds = nullptr;
+    if (nthreads > 1) {
+        worker_ds = std::make_unique<WorkerDatasets_>(ds, nthreads);
+        if (worker_ds->empty()) {
+            if (!quiet)
+                cli_alert_info_("the raster dataset cannot be reopened for "
+                                "multi-threaded read, using one thread");
+            nthreads = 1;
+        }
+    }
+
+    auto get_band = [&](int thread_idx) {
+        GDALDatasetH hDS = nthreads > 1 ? worker_ds->get(thread_idx)
+                                        : ds->getGDALDatasetH_();
+        GDALRasterBandH hBand = GDALGetRasterBand(hDS, band);
+        if (hBand == nullptr)
+            throw std::runtime_error("failed to access the requested band");
+        return hBand;
+    };
+
+    auto make_batch = [&](std::size_t batch_start, std::size_t batch_size) {
+        std::vector<LabelTile_> batch(batch_size);
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const std::size_t t = batch_start + i;
+            batch[i].xoff = static_cast<int>(t % ntx) * tile_size[0];
+            batch[i].yoff = static_cast<int>(t / ntx) * tile_size[1];
+            batch[i].xsize = std::min(tile_size[0], nx - batch[i].xoff);
+            batch[i].ysize = std::min(tile_size[1], ny - batch[i].yoff);
+        }
+        return batch;
+    };
+
+    // first pass, runs on worker threads: must not call into R
+    auto census_tile = [&](LabelTile_ *tile, int thread_idx) {
+        GDALRasterBandH hBand = get_band(thread_idx);
+
+        // window with a one-pixel halo, clipped to the raster
+        const int wx0 = std::max(tile->xoff - 1, 0);
+        const int wy0 = std::max(tile->yoff - 1, 0);
+        const int wx1 = std::min(tile->xoff + tile->xsize + 1, nx);
+        const int wy1 = std::min(tile->yoff + tile->ysize + 1, ny);
+        const int ww = wx1 - wx0;
+        const int wh = wy1 - wy0;
+        std::vector<double> wvalues;
+        std::vector<unsigned char> wvalid;
+        if (read_window_(hBand, wx0, wy0, ww, wh, &wvalues, &wvalid) !=
+                CE_None) {
+            throw std::runtime_error(std::string("read raster failed: ") +
+                                     CPLGetLastErrorMsg());
+        }
+
+        const int xs = tile->xsize;
+        const int ys = tile->ysize;
+        const int dx = tile->xoff - wx0;
+        const int dy = tile->yoff - wy0;
+        const std::size_t num_pixels = static_cast<std::size_t>(xs) * ys;
+        std::vector<double> values(num_pixels);
+        std::vector<unsigned char> valid(num_pixels);
+        for (int y = 0; y < ys; ++y) {
+            const std::size_t src = static_cast<std::size_t>(y + dy) * ww + dx;
+            const std::size_t dst = static_cast<std::size_t>(y) * xs;
+            std::copy_n(wvalues.begin() + src, xs, values.begin() + dst);
+            std::copy_n(wvalid.begin() + src, xs, valid.begin() + dst);
+        }
+
+        std::vector<int32_t> labels(num_pixels);
+        const int32_t n = label_regions_(values.data(), valid.data(), xs, ys,
+                                         connectedness, labels.data());
+        tile->regions.assign(n, RegionStats_());
+
+        // pixel side is on the boundary unless the pixel across is valid
+        // with the same value
+        auto is_boundary = [&](int wx, int wy, double v) {
+            if (wx < 0 || wy < 0 || wx >= ww || wy >= wh)
+                return true;
+            const std::size_t j = static_cast<std::size_t>(wy) * ww + wx;
+            return !wvalid[j] || wvalues[j] != v;
+        };
+
+        for (int y = 0; y < ys; ++y) {
+            for (int x = 0; x < xs; ++x) {
+                const std::size_t i = static_cast<std::size_t>(y) * xs + x;
+                if (labels[i] == 0)
+                    continue;
+                RegionStats_ &r = tile->regions[labels[i] - 1];
+                const double v = values[i];
+                const int col = tile->xoff + x;
+                const int row = tile->yoff + y;
+                if (r.count == 0) {
+                    r.value = v;
+                    r.first = static_cast<int64_t>(row) * nx + col;
+                }
+                r.count += 1;
+                r.col_min = std::min(r.col_min, col);
+                r.col_max = std::max(r.col_max, col);
+                r.row_min = std::min(r.row_min, row);
+                r.row_max = std::max(r.row_max, row);
+
+                const int wx = x + dx;
+                const int wy = y + dy;
+                r.row_sides += is_boundary(wx, wy - 1, v);
+                r.row_sides += is_boundary(wx, wy + 1, v);
+                r.col_sides += is_boundary(wx - 1, wy, v);
+                r.col_sides += is_boundary(wx + 1, wy, v);
+            }
+        }
+
+        tile->edges = tile_edges_(values.data(), labels.data(), tile->xoff,
+                                  tile->yoff, xs, ys);
+    };
+
+    const double pass1_frac = write_labels ? 0.5 : 1.0;
+
+    if (!quiet) {
+        cli_alert_info_("labeling " + std::to_string(num_tiles) +
+                        " tile(s) using " + std::to_string(nthreads) +
+                        " thread(s)...");
+        GDALTermProgressR(0.0, nullptr, nullptr);
+    }
+
+    // region pieces by global index: tile_base[t] + local label - 1
+    std::vector<int64_t> tile_base(num_tiles + 1, 0);
+    std::vector<RegionStats_> pieces;
+    TileSeamMerger_ merger(ntx, connectedness);
+
+    for (std::size_t batch_start = 0; batch_start < num_tiles;
+            batch_start += nthreads) {
+
+        const std::size_t batch_size =
+            std::min(static_cast<std::size_t>(nthreads),
+                     num_tiles - batch_start);
+        std::vector<LabelTile_> batch = make_batch(batch_start, batch_size);
+
+        try {
+            parallel_for_(batch_size, std::min(nthreads,
+                                               static_cast<int>(batch_size)),
+                [&](std::size_t i, int thread_idx) {
+                    census_tile(&batch[i], thread_idx);
+                });
+        }
+        catch (const std::exception &e) {
+            Rcpp::stop(e.what());
+        }
+
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const std::size_t t = batch_start + i;
+            tile_base[t + 1] = tile_base[t] +
+                static_cast<int64_t>(batch[i].regions.size());
+            pieces.insert(pieces.end(), batch[i].regions.begin(),
+                          batch[i].regions.end());
+            merger.add(t, std::move(batch[i].edges));
+        }
+
+        if (!quiet) {
+            GDALTermProgressR(
+                pass1_frac * static_cast<double>(batch_start + batch_size) /
+                num_tiles, nullptr, nullptr);
+        }
+        Rcpp::checkUserInterrupt();
+    }
+
+    // combine the pieces of each region at its representative piece
+    const int64_t num_pieces = tile_base[num_tiles];
+    std::vector<int64_t> root(num_pieces);
+    for (std::size_t t = 0; t < num_tiles; ++t) {
+        for (int64_t g = tile_base[t]; g < tile_base[t + 1]; ++g) {
+            const int32_t label = static_cast<int32_t>(g - tile_base[t] + 1);
+            const uint64_t key = merger.uf().find(region_key_(t, label));
+            root[g] = tile_base[region_key_tile_(key)] +
+                      region_key_label_(key) - 1;
+        }
+    }
+
+    std::vector<int64_t> roots;
+    for (int64_t g = 0; g < num_pieces; ++g) {
+        const int64_t r = root[g];
+        if (r == g) {
+            roots.push_back(g);
+            continue;
+        }
+        RegionStats_ &a = pieces[r];
+        const RegionStats_ &b = pieces[g];
+        a.count += b.count;
+        a.row_sides += b.row_sides;
+        a.col_sides += b.col_sides;
+        a.col_min = std::min(a.col_min, b.col_min);
+        a.col_max = std::max(a.col_max, b.col_max);
+        a.row_min = std::min(a.row_min, b.row_min);
+        a.row_max = std::max(a.row_max, b.row_max);
+        a.first = std::min(a.first, b.first);
+    }
+
+    if (roots.size() > static_cast<std::size_t>(INT32_MAX))
+        Rcpp::stop("the number of regions exceeds the range of Int32");
+
+    // regions numbered in raster scan order of their first pixel
+    std::sort(roots.begin(), roots.end(), [&](int64_t a, int64_t b) {
+        return pieces[a].first < pieces[b].first;
+    });
+    std::vector<int32_t> region_id(num_pieces, 0);
+    for (std::size_t k = 0; k < roots.size(); ++k)
+        region_id[roots[k]] = static_cast<int32_t>(k + 1);
+
+    // second pass
+    if (write_labels) {
+        // runs on worker threads: must not call into R
+        auto write_tile = [&](LabelTile_ *tile, std::size_t t,
+                              int thread_idx) {
+            std::vector<double> values;
+            std::vector<unsigned char> valid;
+            if (read_window_(get_band(thread_idx), tile->xoff, tile->yoff,
+                             tile->xsize, tile->ysize, &values, &valid) !=
+                    CE_None) {
+                throw std::runtime_error(std::string("read raster failed: ")
+                                         + CPLGetLastErrorMsg());
+            }
+            tile->out.resize(values.size());
+            label_regions_(values.data(), valid.data(), tile->xsize,
+                           tile->ysize, connectedness, tile->out.data());
+            for (int32_t &l : tile->out) {
+                if (l != 0)
+                    l = region_id[root[tile_base[t] + l - 1]];
+            }
+        };
+
+        for (std::size_t batch_start = 0; batch_start < num_tiles;
+                batch_start += nthreads) {
+
+            const std::size_t batch_size =
+                std::min(static_cast<std::size_t>(nthreads),
+                         num_tiles - batch_start);
+            std::vector<LabelTile_> batch = make_batch(batch_start,
+                                                       batch_size);
+
+            try {
+                parallel_for_(batch_size,
+                    std::min(nthreads, static_cast<int>(batch_size)),
+                    [&](std::size_t i, int thread_idx) {
+                        write_tile(&batch[i], batch_start + i, thread_idx);
+                    });
+            }
+            catch (const std::exception &e) {
+                Rcpp::stop(e.what());
+            }
+
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                LabelTile_ &tile = batch[i];
+                if (GDALRasterIO(hDstBand, GF_Write, tile.xoff, tile.yoff,
+                                 tile.xsize, tile.ysize, tile.out.data(),
+                                 tile.xsize, tile.ysize, GDT_Int32, 0, 0)
+                        != CE_None) {
+                    Rcpp::stop("write to the destination raster failed");
+                }
+            }
+
+            if (!quiet) {
+                GDALTermProgressR(
+                    0.5 + 0.5 *
+                    static_cast<double>(batch_start + batch_size) / num_tiles,
+                    nullptr, nullptr);
+            }
+            Rcpp::checkUserInterrupt();
+        }
+    }
+
+    // output table, in map units of the geotransform
+    const std::size_t num_regions = roots.size();
+    const double pixel_area = std::fabs(gt[1] * gt[5] - gt[2] * gt[4]);
+    const double row_side_len = std::sqrt(gt[1] * gt[1] + gt[4] * gt[4]);
+    const double col_side_len = std::sqrt(gt[2] * gt[2] + gt[5] * gt[5]);
+
+    Rcpp::IntegerVector id = Rcpp::no_init(num_regions);
+    Rcpp::NumericVector value = Rcpp::no_init(num_regions);
+    Rcpp::NumericVector count = Rcpp::no_init(num_regions);
+    Rcpp::NumericVector area = Rcpp::no_init(num_regions);
+    Rcpp::NumericVector perimeter = Rcpp::no_init(num_regions);
+    Rcpp::NumericVector xmin = Rcpp::no_init(num_regions);
+    Rcpp::NumericVector ymin = Rcpp::no_init(num_regions);
+    Rcpp::NumericVector xmax = Rcpp::no_init(num_regions);
+    Rcpp::NumericVector ymax = Rcpp::no_init(num_regions);
+
+    for (std::size_t k = 0; k < num_regions; ++k) {
+        const RegionStats_ &r = pieces[roots[k]];
+        id[k] = static_cast<int>(k + 1);
+        value[k] = r.value;
+        count[k] = static_cast<double>(r.count);
+        area[k] = r.count * pixel_area;
+        perimeter[k] = r.row_sides * row_side_len +
+                       r.col_sides * col_side_len;
+
+        // bounding box from the corners of the pixel bounding box
+        const double cols[2] = {static_cast<double>(r.col_min),
+                                static_cast<double>(r.col_max) + 1};
+        const double rows[2] = {static_cast<double>(r.row_min),
+                                static_cast<double>(r.row_max) + 1};
+        xmin[k] = ymin[k] = std::numeric_limits<double>::infinity();
+        xmax[k] = ymax[k] = -std::numeric_limits<double>::infinity();
+        for (double c : cols) {
+            for (double l : rows) {
+                const double x = gt[0] + c * gt[1] + l * gt[2];
+                const double y = gt[3] + c * gt[4] + l * gt[5];
+                xmin[k] = std::min(xmin[k], x);
+                xmax[k] = std::max(xmax[k], x);
+                ymin[k] = std::min(ymin[k], y);
+                ymax[k] = std::max(ymax[k], y);
+            }
+        }
+    }
+
+    if (!quiet)
+        cli_alert_info_(std::to_string(num_regions) + " region(s)");
+
+    Rcpp::DataFrame df_out = Rcpp::DataFrame::create();
+    df_out.push_back(id, "id");
+    df_out.push_back(value, "value");
+    df_out.push_back(count, "count");
+    df_out.push_back(area, "area");
+    df_out.push_back(perimeter, "perimeter");
+    df_out.push_back(xmin, "xmin");
+    df_out.push_back(ymin, "ymin");
+    df_out.push_back(xmax, "xmax");
+    df_out.push_back(ymax, "ymax");
+
+    return df_out;
+}
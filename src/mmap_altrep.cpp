@@ -0,0 +1,516 @@
+/* Memory-mapped raster bands exposed to R as ALTREP vectors
+
+   For raster formats with a raw uncompressed layout on local disk (e.g.,
+   uncompressed GTiff, ENVI, EHdr and other raw formats), GDAL can map the
+   file region of a band directly into memory with GDALGetVirtualMemAuto().
+   The vector returned by make_mapped_band_() is an ALTREP object over that
+   mapping: its length is the number of pixels, and values are converted from
+   the raster data type (with nodata set to NA) only when elements or regions
+   are accessed, so no copy of the band is made. The operating system pages
+   data in from the file on demand.
+
+   Bands of type Int32 or Float64 with a contiguous layout and no nodata
+   conversion needed are exposed as a read-only data pointer directly onto
+   the mapping. Otherwise, R code that needs a data pointer (e.g.,
+   arithmetic on the whole vector or logical subsetting), and any request
+   for a writable data pointer (e.g., when the vector is modified),
+   materializes the vector into a regular R vector of the size of the band,
+   which is used from then on. Element and region access (used by
+   subsetting with indices and by many internal loops in R), and sum(),
+   min(), max() and anyNA() through the ALTREP summary methods, work on the
+   mapping without materializing.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include "mmap_altrep.h"
+
+#include <gdal.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+#include <cpl_string.h>
+#include <cpl_virtualmem.h>
+
+#include <Rcpp.h>
+#include <R_ext/Altrep.h>
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+static R_altrep_class_t mapped_int_class;
+static R_altrep_class_t mapped_real_class;
+
+struct MappedBand_ {
+    GDALDatasetH hDS {nullptr};
+    CPLVirtualMem *vmem {nullptr};
+    const unsigned char *base {nullptr};
+    GDALDataType dt {GDT_Unknown};
+    int pixel_space {0};
+    GIntBig line_space {0};
+    R_xlen_t nx {0};
+    R_xlen_t ny {0};
+    bool has_nodata {false};
+    double nodata {0};
+    // the mapping can be exposed as the data pointer of the R vector
+    bool zero_copy {false};
+
+    ~MappedBand_() {
+        if (vmem != nullptr)
+            CPLVirtualMemFree(vmem);
+        if (hDS != nullptr)
+            GDALReleaseDataset(hDS);
+    }
+};
+
+static void mapped_band_finalizer_(SEXP xp) {
+    MappedBand_ *mb = static_cast<MappedBand_ *>(R_ExternalPtrAddr(xp));
+    if (mb != nullptr) {
+        delete mb;
+        R_ClearExternalPtr(xp);
+    }
+}
+
+static MappedBand_ *mapped_band_(SEXP x) {
+    MappedBand_ *mb =
+        static_cast<MappedBand_ *>(R_ExternalPtrAddr(R_altrep_data1(x)));
+    if (mb == nullptr)
+        Rf_error("the memory mapping of the raster band is no longer valid");
+    return mb;
+}
+
+// value of the raster data type at a pixel of the mapping, as double
+// the data types read by mapped_value_()
+static bool mapped_type_supported_(GDALDataType dt) {
+    switch (dt) {
+        case GDT_Byte:
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 7, 0)
+        case GDT_Int8:
+#endif
+        case GDT_Int16:
+        case GDT_UInt16:
+        case GDT_Int32:
+        case GDT_UInt32:
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 5, 0)
+        case GDT_Int64:
+        case GDT_UInt64:
+#endif
+        case GDT_Float32:
+        case GDT_Float64:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static double mapped_value_(const MappedBand_ *mb, R_xlen_t i) {
+    const R_xlen_t row = i / mb->nx;
+    const R_xlen_t col = i - row * mb->nx;
+    const unsigned char *p = mb->base + row * mb->line_space +
+                             col * mb->pixel_space;
+
+    switch (mb->dt) {
+        case GDT_Byte:
+            return static_cast<double>(*p);
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 7, 0)
+        case GDT_Int8: {
+            int8_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return static_cast<double>(v);
+        }
+#endif
+        case GDT_Int16: {
+            int16_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return static_cast<double>(v);
+        }
+        case GDT_UInt16: {
+            uint16_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return static_cast<double>(v);
+        }
+        case GDT_Int32: {
+            int32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return static_cast<double>(v);
+        }
+        case GDT_UInt32: {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return static_cast<double>(v);
+        }
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 5, 0)
+        case GDT_Int64: {
+            int64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return static_cast<double>(v);
+        }
+        case GDT_UInt64: {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return static_cast<double>(v);
+        }
+#endif
+        case GDT_Float32: {
+            float v;
+            std::memcpy(&v, p, sizeof(v));
+            return static_cast<double>(v);
+        }
+        case GDT_Float64: {
+            double v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        default:
+            return NA_REAL;
+    }
+}
+
+static int mapped_int_value_(const MappedBand_ *mb, R_xlen_t i) {
+    // compared before the cast, the nodata value may not be an int
+    const double v = mapped_value_(mb, i);
+    if (mb->has_nodata && v == mb->nodata)
+        return NA_INTEGER;
+    return static_cast<int>(v);
+}
+
+static double mapped_real_value_(const MappedBand_ *mb, R_xlen_t i) {
+    const double v = mapped_value_(mb, i);
+    if (mb->has_nodata && v == mb->nodata)
+        return NA_REAL;
+    return v;
+}
+
+// copy the band into a regular R vector stored in data2
+static SEXP materialize_(SEXP x) {
+    SEXP data2 = R_altrep_data2(x);
+    if (data2 != R_NilValue)
+        return data2;
+
+    const MappedBand_ *mb = mapped_band_(x);
+    const R_xlen_t n = mb->nx * mb->ny;
+    if (R_altrep_inherits(x, mapped_int_class)) {
+        data2 = PROTECT(Rf_allocVector(INTSXP, n));
+        int *out = INTEGER(data2);
+        for (R_xlen_t i = 0; i < n; ++i)
+            out[i] = mapped_int_value_(mb, i);
+    }
+    else {
+        data2 = PROTECT(Rf_allocVector(REALSXP, n));
+        double *out = REAL(data2);
+        for (R_xlen_t i = 0; i < n; ++i)
+            out[i] = mapped_real_value_(mb, i);
+    }
+    R_set_altrep_data2(x, data2);
+    UNPROTECT(1);
+    return data2;
+}
+
+static R_xlen_t mapped_length_(SEXP x) {
+    SEXP data2 = R_altrep_data2(x);
+    if (data2 != R_NilValue)
+        return XLENGTH(data2);
+    const MappedBand_ *mb = mapped_band_(x);
+    return mb->nx * mb->ny;
+}
+
+static Rboolean mapped_inspect_(SEXP x, int pre, int deep, int pvec,
+                                void (*inspect_subtree)(SEXP, int, int,
+                                                        int)) {
+    const bool materialized = R_altrep_data2(x) != R_NilValue;
+    Rprintf("gdalraster memory-mapped band (len=%ld, %s)\n",
+            static_cast<long>(mapped_length_(x)),
+            materialized ? "materialized" : "mapped");
+    return TRUE;
+}
+
+static const void *mapped_dataptr_or_null_(SEXP x) {
+    SEXP data2 = R_altrep_data2(x);
+    if (data2 != R_NilValue)
+        return DATAPTR_RO(data2);
+    const MappedBand_ *mb = mapped_band_(x);
+    if (mb->zero_copy)
+        return mb->base;
+    return nullptr;
+}
+
+static void *mapped_dataptr_(SEXP x, Rboolean writeable) {
+    if (!writeable) {
+        const void *p = mapped_dataptr_or_null_(x);
+        if (p != nullptr)
+            return const_cast<void *>(p);
+    }
+    SEXP data2 = materialize_(x);
+    if (TYPEOF(data2) == INTSXP)
+        return INTEGER(data2);
+    return REAL(data2);
+}
+
+static int mapped_int_elt_(SEXP x, R_xlen_t i) {
+    SEXP data2 = R_altrep_data2(x);
+    if (data2 != R_NilValue)
+        return INTEGER_ELT(data2, i);
+    return mapped_int_value_(mapped_band_(x), i);
+}
+
+static R_xlen_t mapped_int_get_region_(SEXP x, R_xlen_t start, R_xlen_t size,
+                                       int *buf) {
+    SEXP data2 = R_altrep_data2(x);
+    if (data2 != R_NilValue)
+        return INTEGER_GET_REGION(data2, start, size, buf);
+    const MappedBand_ *mb = mapped_band_(x);
+    const R_xlen_t n = mb->nx * mb->ny;
+    const R_xlen_t ncopy = start + size > n ? n - start : size;
+    for (R_xlen_t k = 0; k < ncopy; ++k)
+        buf[k] = mapped_int_value_(mb, start + k);
+    return ncopy;
+}
+
+static double mapped_real_elt_(SEXP x, R_xlen_t i) {
+    SEXP data2 = R_altrep_data2(x);
+    if (data2 != R_NilValue)
+        return REAL_ELT(data2, i);
+    return mapped_real_value_(mapped_band_(x), i);
+}
+
+static R_xlen_t mapped_real_get_region_(SEXP x, R_xlen_t start,
+                                        R_xlen_t size, double *buf) {
+    SEXP data2 = R_altrep_data2(x);
+    if (data2 != R_NilValue)
+        return REAL_GET_REGION(data2, start, size, buf);
+    const MappedBand_ *mb = mapped_band_(x);
+    const R_xlen_t n = mb->nx * mb->ny;
+    const R_xlen_t ncopy = start + size > n ? n - start : size;
+    for (R_xlen_t k = 0; k < ncopy; ++k)
+        buf[k] = mapped_real_value_(mb, start + k);
+    return ncopy;
+}
+
+// Summary methods, computed over the mapping. Returning nullptr falls back
+// to R's default implementation, which uses Get_region: this is done where
+// R gives a warning or special result (integer overflow, empty input) and
+// when NA is found with na.rm = FALSE, so that R's NA/NaN semantics apply.
+static SEXP mapped_sum_(SEXP x, Rboolean narm) {
+    if (R_altrep_data2(x) != R_NilValue)
+        return nullptr;
+    const MappedBand_ *mb = mapped_band_(x);
+    const R_xlen_t n = mb->nx * mb->ny;
+    const bool is_int = R_altrep_inherits(x, mapped_int_class);
+
+    long double sum = 0;
+    for (R_xlen_t i = 0; i < n; ++i) {
+        if (is_int) {
+            const int v = mapped_int_value_(mb, i);
+            if (v == NA_INTEGER) {
+                if (narm)
+                    continue;
+                return nullptr;
+            }
+            sum += v;
+        }
+        else {
+            const double v = mapped_real_value_(mb, i);
+            if (std::isnan(v)) {
+                if (narm)
+                    continue;
+                return nullptr;
+            }
+            sum += v;
+        }
+    }
+
+    if (is_int) {
+        if (sum > INT_MAX || sum < -INT_MAX)
+            return nullptr;
+        return Rf_ScalarInteger(static_cast<int>(sum));
+    }
+    return Rf_ScalarReal(static_cast<double>(sum));
+}
+
+static SEXP mapped_min_max_(SEXP x, Rboolean narm, bool is_max) {
+    if (R_altrep_data2(x) != R_NilValue)
+        return nullptr;
+    const MappedBand_ *mb = mapped_band_(x);
+    const R_xlen_t n = mb->nx * mb->ny;
+    const bool is_int = R_altrep_inherits(x, mapped_int_class);
+
+    bool found = false;
+    double out = 0;
+    for (R_xlen_t i = 0; i < n; ++i) {
+        double v = 0;
+        if (is_int) {
+            const int iv = mapped_int_value_(mb, i);
+            if (iv == NA_INTEGER) {
+                if (narm)
+                    continue;
+                return nullptr;
+            }
+            v = iv;
+        }
+        else {
+            v = mapped_real_value_(mb, i);
+            if (std::isnan(v)) {
+                if (narm)
+                    continue;
+                return nullptr;
+            }
+        }
+        if (!found || (is_max ? v > out : v < out))
+            out = v;
+        found = true;
+    }
+
+    if (!found)
+        return nullptr;
+    if (is_int)
+        return Rf_ScalarInteger(static_cast<int>(out));
+    return Rf_ScalarReal(out);
+}
+
+static SEXP mapped_min_(SEXP x, Rboolean narm) {
+    return mapped_min_max_(x, narm, false);
+}
+
+static SEXP mapped_max_(SEXP x, Rboolean narm) {
+    return mapped_min_max_(x, narm, true);
+}
+
+// 1 if the vector is known to contain no NA, without scanning it
+static int mapped_no_na_(SEXP x) {
+    if (R_altrep_data2(x) != R_NilValue)
+        return 0;
+    const MappedBand_ *mb = mapped_band_(x);
+    if (mb->has_nodata)
+        return 0;
+    // Int32 can hold NA_INTEGER, floating point types can hold NaN
+    switch (mb->dt) {
+        case GDT_Byte:
+        case GDT_Int16:
+        case GDT_UInt16:
+        case GDT_UInt32:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// [[Rcpp::init]]
+void mmap_altrep_init(DllInfo *dll) {
+    mapped_int_class = R_make_altinteger_class("gdalraster_mapped_int",
+                                               "gdalraster", dll);
+    R_set_altrep_Length_method(mapped_int_class, mapped_length_);
+    R_set_altrep_Inspect_method(mapped_int_class, mapped_inspect_);
+    R_set_altvec_Dataptr_method(mapped_int_class, mapped_dataptr_);
+    R_set_altvec_Dataptr_or_null_method(mapped_int_class,
+                                        mapped_dataptr_or_null_);
+    R_set_altinteger_Elt_method(mapped_int_class, mapped_int_elt_);
+    R_set_altinteger_Get_region_method(mapped_int_class,
+                                       mapped_int_get_region_);
+    R_set_altinteger_Sum_method(mapped_int_class, mapped_sum_);
+    R_set_altinteger_Min_method(mapped_int_class, mapped_min_);
+    R_set_altinteger_Max_method(mapped_int_class, mapped_max_);
+    R_set_altinteger_No_NA_method(mapped_int_class, mapped_no_na_);
+
+    mapped_real_class = R_make_altreal_class("gdalraster_mapped_real",
+                                             "gdalraster", dll);
+    R_set_altrep_Length_method(mapped_real_class, mapped_length_);
+    R_set_altrep_Inspect_method(mapped_real_class, mapped_inspect_);
+    R_set_altvec_Dataptr_method(mapped_real_class, mapped_dataptr_);
+    R_set_altvec_Dataptr_or_null_method(mapped_real_class,
+                                        mapped_dataptr_or_null_);
+    R_set_altreal_Elt_method(mapped_real_class, mapped_real_elt_);
+    R_set_altreal_Get_region_method(mapped_real_class,
+                                    mapped_real_get_region_);
+    R_set_altreal_Sum_method(mapped_real_class, mapped_sum_);
+    R_set_altreal_Min_method(mapped_real_class, mapped_min_);
+    R_set_altreal_Max_method(mapped_real_class, mapped_max_);
+    R_set_altreal_No_NA_method(mapped_real_class, mapped_no_na_);
+}
+
+SEXP make_mapped_band_(const std::string &filename,
+                       const std::vector<std::string> &open_options,
+                       int band) {
+
+    std::vector<const char *> oo;
+    for (const std::string &opt : open_options)
+        oo.push_back(opt.c_str());
+    oo.push_back(nullptr);
+
+    auto mb = std::make_unique<MappedBand_>();
+    mb->hDS = GDALOpenEx(filename.c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY,
+                         nullptr, oo.data(), nullptr);
+    if (mb->hDS == nullptr)
+        Rcpp::stop("failed to open the raster for memory mapping");
+
+    GDALRasterBandH hBand = GDALGetRasterBand(mb->hDS, band);
+    if (hBand == nullptr)
+        Rcpp::stop("failed to access the requested band");
+
+    mb->dt = GDALGetRasterDataType(hBand);
+    if (GDALDataTypeIsComplex(mb->dt))
+        Rcpp::stop("memory-mapped read of complex data types is not supported");
+    if (!mapped_type_supported_(mb->dt)) {
+        Rcpp::stop(std::string("memory-mapped read of data type ") +
+                   GDALGetDataTypeName(mb->dt) + " is not supported");
+    }
+
+    mb->nx = GDALGetRasterBandXSize(hBand);
+    mb->ny = GDALGetRasterBandYSize(hBand);
+    int has_nodata = FALSE;
+    mb->nodata = GDALGetRasterNoDataValue(hBand, &has_nodata);
+    mb->has_nodata = has_nodata;
+
+    // only a direct mapping of the file, not GDAL's default implementation
+    // that reads through the block cache on page faults
+    char **papszOptions = nullptr;
+    papszOptions = CSLSetNameValue(papszOptions, "USE_DEFAULT_IMPLEMENTATION",
+                                   "NO");
+    mb->vmem = GDALGetVirtualMemAuto(hBand, GF_Read, &mb->pixel_space,
+                                     &mb->line_space, papszOptions);
+    CSLDestroy(papszOptions);
+    if (mb->vmem == nullptr) {
+        Rcpp::stop("the raster band cannot be memory-mapped (requires an "
+                   "uncompressed raw layout in native byte order on local "
+                   "disk)");
+    }
+    mb->base = static_cast<const unsigned char *>(
+        CPLVirtualMemGetAddr(mb->vmem));
+
+    // integer types as R integer, others as double, as for GDALRaster::read()
+    const bool as_int = GDALDataTypeIsInteger(mb->dt) &&
+                        (GDALGetDataTypeSizeBits(mb->dt) <= 16 ||
+                         (GDALGetDataTypeSizeBits(mb->dt) <= 32 &&
+                          GDALDataTypeIsSigned(mb->dt)));
+
+    // a nodata value outside the int range, or not a whole number, cannot
+    // occur in a band read as integer
+    if (as_int && mb->has_nodata &&
+            !(mb->nodata >= INT_MIN && mb->nodata <= INT_MAX &&
+              mb->nodata == std::trunc(mb->nodata))) {
+        mb->has_nodata = false;
+    }
+
+    const int dt_size = GDALGetDataTypeSizeBytes(mb->dt);
+    const bool contiguous = mb->pixel_space == dt_size &&
+                            mb->line_space == dt_size * mb->nx;
+    if (as_int) {
+        mb->zero_copy = mb->dt == GDT_Int32 && contiguous && !mb->has_nodata;
+    }
+    else {
+        mb->zero_copy = mb->dt == GDT_Float64 && contiguous &&
+                        (!mb->has_nodata || std::isnan(mb->nodata));
+    }
+
+    SEXP xp = PROTECT(R_MakeExternalPtr(mb.release(), R_NilValue,
+                                        R_NilValue));
+    R_RegisterCFinalizerEx(xp, mapped_band_finalizer_, TRUE);
+    SEXP out = R_new_altrep(as_int ? mapped_int_class : mapped_real_class,
+                            xp, R_NilValue);
+    UNPROTECT(1);
+    return out;
+}
@@ -0,0 +1,22 @@
+/* Memory-mapped raster bands exposed to R as ALTREP vectors
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef MMAP_ALTREP_H_
+#define MMAP_ALTREP_H_
+
+#include <Rcpp.h>
+
+#include <string>
+#include <vector>
+
+// Returns an R vector backed by a read-only memory mapping of a raster band
+// in the file on disk. The dataset is opened by name with its own handle,
+// which is kept open by the returned vector.
+SEXP make_mapped_band_(const std::string &filename,
+                       const std::vector<std::string> &open_options,
+                       int band);
+
+#endif  // MMAP_ALTREP_H_
@@ -0,0 +1,240 @@
+/* Process-wide pool of vector dataset handles for the ogr_manage helpers
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include "ogr_ds_pool.h"
+
+#include <gdal.h>
+
+#include <Rcpp.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+OGRDatasetPool_ &OGRDatasetPool_::instance() {
+    // never destroyed, handles are closed by clear() at package unload
+    static OGRDatasetPool_ *pool = new OGRDatasetPool_();
+    return *pool;
+}
+
+// close idle handles past the idle timeout, then the least recently used
+// idle handles beyond m_max_idle
+void OGRDatasetPool_::expireIdle_() {
+    m_closes += m_pool.closeExpired(m_idle_timeout);
+    m_closes += m_pool.trimIdle(m_max_idle);
+}
+
+static std::string ogr_pool_key_(const std::string &dsn, unsigned int flags) {
+    return dsn + "\n" + std::to_string(flags);
+}
+
+GDALDatasetH OGRDatasetPool_::acquire(const std::string &dsn,
+                                      unsigned int flags) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_enabled) {
+            return GDALOpenEx(dsn.c_str(), flags, nullptr, nullptr,
+                              nullptr);
+        }
+
+        expireIdle_();
+        GDALDatasetH hDS = m_pool.takeIdle(ogr_pool_key_(dsn, flags));
+        if (hDS != nullptr) {
+            m_reuses += 1;
+            return hDS;
+        }
+    }
+
+    // open without the lock held, connection setup may be slow
+    GDALDatasetH hDS = GDALOpenEx(dsn.c_str(), flags, nullptr, nullptr,
+                                  nullptr);
+    if (hDS == nullptr)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    HandlePoolEntry_ entry;
+    entry.key = ogr_pool_key_(dsn, flags);
+    entry.group = dsn;
+    entry.hDS = hDS;
+    entry.update = (flags & GDAL_OF_UPDATE) != 0;
+    m_pool.add(std::move(entry));
+    m_opens += 1;
+    return hDS;
+}
+
+void OGRDatasetPool_::release(GDALDatasetH hDS) {
+    if (hDS == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    HandlePoolEntry_ *entry = m_pool.find(hDS);
+    if (entry == nullptr) {
+        GDALReleaseDataset(hDS);
+        return;
+    }
+
+    if (!m_enabled) {
+        m_pool.remove(hDS);
+        m_closes += 1;
+        return;
+    }
+
+    m_pool.giveBack(entry);
+
+    if (entry->update) {
+        // make the changes visible to handles opened after this one, and
+        // drop the idle handles that may have cached the previous state
+        GDALFlushCache(hDS);
+        const std::string dsn = entry->group;
+        m_closes += m_pool.closeIdleInGroup(dsn, hDS);
+    }
+
+    expireIdle_();
+}
+
+void OGRDatasetPool_::evict(const std::string &dsn) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closes += m_pool.closeIdleInGroup(dsn);
+}
+
+void OGRDatasetPool_::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::size_t size = m_pool.size();
+    m_pool.clear(false);
+    m_closes += size - m_pool.size();
+}
+
+void OGRDatasetPool_::setEnabled(bool enabled, double idle_timeout) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_enabled = enabled;
+    m_idle_timeout = idle_timeout;
+    if (!m_enabled) {
+        const std::size_t size = m_pool.size();
+        m_pool.clear(false);
+        m_closes += size - m_pool.size();
+    }
+    else {
+        expireIdle_();
+    }
+}
+
+OGRDatasetPoolStats_ OGRDatasetPool_::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    OGRDatasetPoolStats_ s;
+    s.enabled = m_enabled;
+    s.idle_timeout = m_idle_timeout;
+    s.size = m_pool.size();
+    s.in_use = m_pool.inUse();
+    s.opens = m_opens;
+    s.reuses = m_reuses;
+    s.closes = m_closes;
+    return s;
+}
+
+GDALDatasetH ogr_ds_open_(const std::string &dsn, unsigned int flags) {
+    return OGRDatasetPool_::instance().acquire(dsn, flags);
+}
+
+void ogr_ds_release_(GDALDatasetH hDS) {
+    OGRDatasetPool_::instance().release(hDS);
+}
+
+
+//' Manage the pool of vector dataset handles
+//'
+//' The helper functions documented in [ogr_manage] open the data source on
+//' each call and close it again before returning. `ogr_ds_pool_enable()`
+//' turns on a pool kept for the R session, in which these helpers leave the
+//' dataset open after use and reuse it on the next call for the same DSN
+//' and access mode. This avoids repeated connection setup for formats where
+//' opening is expensive, such as PostGIS or a GeoPackage accessed over
+//' `/vsicurl/`. The pool is disabled by default.
+//'
+//' @name ogr_ds_pool
+//'
+//' @details
+//' Pooled handles are keyed by the DSN and whether the dataset is opened
+//' read-only or for update. A handle is used by one helper call at a time.
+//' Handles left idle in the pool for longer than `idle_timeout` seconds are
+//' closed, checked each time the pool is accessed. At most 32 idle handles
+//' are kept, closing the least recently used ones beyond that.
+//'
+//' When a helper that modifies the data source returns, its handle is flushed
+//' and the other idle handles on the same DSN are closed, so that later calls
+//' see the changes. Modifications made through other means while a handle is
+//' pooled (e.g., with a `GDALVector` object, [ogr2ogr()] or another process)
+//' may not be seen by the pooled handle. Call `ogr_ds_pool_clear()` after
+//' such modifications, and before deleting or overwriting a pooled data
+//' source. `ogr_ds_exists()` always opens the data source anew and does not
+//' use the pool.
+//'
+//' `ogr_ds_pool_enable()` enables or disables the pool and sets the idle
+//' timeout. Disabling the pool closes all idle handles.
+//'
+//' `ogr_ds_pool_info()` returns information about the pool.
+//'
+//' `ogr_ds_pool_clear()` closes all idle handles and empties the pool.
+//'
+//' @param enable Logical value, `TRUE` to enable the pool (the default),
+//' `FALSE` to disable it.
+//' @param idle_timeout Numeric value, the number of seconds an idle handle is
+//' kept in the pool (`60` by default). `Inf` keeps idle handles until the pool
+//' is cleared or disabled.
+//' @returns
+//' `ogr_ds_pool_info()` returns a list with elements `enabled` (logical),
+//' `idle_timeout` (seconds), `size` (number of pooled handles), `in_use`
+//' (number of pooled handles currently used by a helper call), `opens`
+//' (number of datasets opened by the pool), `reuses` (number of calls served
+//' by an idle pooled handle, i.e., opens avoided) and `closes` (number of
+//' pooled handles closed).
+//'
+//' `ogr_ds_pool_enable()` and `ogr_ds_pool_clear()` return `NULL` invisibly.
+//'
+//' @seealso
+//' [ogr_manage]
+//'
+//' @examples
+//' src <- system.file("extdata/ynp_fires_1984_2022.gpkg", package="gdalraster")
+//' dsn <- file.path(tempdir(), basename(src))
+//' file.copy(src, dsn)
+//'
+//' ogr_ds_pool_enable(TRUE, idle_timeout = 30)
+//'
+//' ogr_ds_layer_names(dsn)
+//' ogr_layer_field_names(dsn, "mtbs_perims")
+//' ogr_field_index(dsn, "mtbs_perims", "incid_name")
+//' ogr_ds_pool_info()
+//'
+//' ogr_ds_pool_enable(FALSE)
+//' deleteDataset(dsn)
+// [[Rcpp::export(invisible = true)]]
+void ogr_ds_pool_enable(bool enable = true, double idle_timeout = 60) {
+    if (std::isnan(idle_timeout) || idle_timeout < 0)
+        Rcpp::stop("'idle_timeout' must be a single value >= 0");
+    OGRDatasetPool_::instance().setEnabled(enable, idle_timeout);
+}
+
+//' @rdname ogr_ds_pool
+// [[Rcpp::export]]
+Rcpp::List ogr_ds_pool_info() {
+    const OGRDatasetPoolStats_ s = OGRDatasetPool_::instance().stats();
+    return Rcpp::List::create(
+        Rcpp::Named("enabled") = s.enabled,
+        Rcpp::Named("idle_timeout") = s.idle_timeout,
+        Rcpp::Named("size") = static_cast<double>(s.size),
+        Rcpp::Named("in_use") = static_cast<double>(s.in_use),
+        Rcpp::Named("opens") = static_cast<double>(s.opens),
+        Rcpp::Named("reuses") = static_cast<double>(s.reuses),
+        Rcpp::Named("closes") = static_cast<double>(s.closes));
+}
+
+//' @rdname ogr_ds_pool
+// [[Rcpp::export(invisible = true)]]
+void ogr_ds_pool_clear() {
+    OGRDatasetPool_::instance().clear();
+}
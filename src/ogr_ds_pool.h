@@ -0,0 +1,92 @@
+/* Process-wide pool of vector dataset handles for the ogr_manage helpers
+
+   Each of the ogr_ds_*(), ogr_layer_*() and ogr_field_*() helpers opens the
+   data source, does one small operation and closes it again. Opening is the
+   dominant cost for formats with expensive connection setup (e.g., PostGIS,
+   remote GeoPackage or FlatGeobuf over /vsicurl/), so a script calling
+   several helpers on the same DSN pays it each time. When enabled,
+   OGRDatasetPool_ keeps the handles opened by the helpers after use, keyed by
+   DSN and open flags, and hands them out again to the next helper call on
+   the same DSN and access mode.
+
+   A handle is either in use by a helper call or idle in the pool. Idle
+   handles not used for longer than the idle timeout are closed, checked
+   lazily on each access to the pool. On release of a handle opened for
+   update, the dataset is flushed and the other idle handles on the same DSN
+   are closed, so that later read-only calls see the changes. The pool is
+   disabled by default, in which case ogr_ds_open_() and ogr_ds_release_()
+   are plain GDALOpenEx() and GDALReleaseDataset(). Pool operations are
+   guarded by a mutex. The bookkeeping of the pooled handles is done by
+   HandlePool_ (handle_pool.h).
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef OGR_DS_POOL_H_
+#define OGR_DS_POOL_H_
+
+#include <gdal.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "handle_pool.h"
+
+struct OGRDatasetPoolStats_ {
+    bool enabled = false;
+    double idle_timeout = 0;
+    std::size_t size = 0;
+    std::size_t in_use = 0;
+    int64_t opens = 0;
+    int64_t reuses = 0;
+    int64_t closes = 0;
+};
+
+class OGRDatasetPool_ {
+ public:
+    static OGRDatasetPool_ &instance();
+
+    // Returns a dataset handle for dsn opened with flags, either an idle
+    // pooled handle or a new one (nullptr on error). The handle must be given
+    // back with release().
+    GDALDatasetH acquire(const std::string &dsn, unsigned int flags);
+
+    // Gives back a handle obtained from acquire(). Handles not owned by the
+    // pool are closed.
+    void release(GDALDatasetH hDS);
+
+    // Closes all idle handles on dsn, e.g., before the dataset is recreated.
+    void evict(const std::string &dsn);
+
+    // Closes all idle handles. Handles in use go back to the pool on release.
+    void clear();
+
+    void setEnabled(bool enabled, double idle_timeout);
+    OGRDatasetPoolStats_ stats() const;
+
+ private:
+    OGRDatasetPool_() = default;
+    OGRDatasetPool_(const OGRDatasetPool_ &) = delete;
+    OGRDatasetPool_ &operator=(const OGRDatasetPool_ &) = delete;
+
+    void expireIdle_();
+
+    mutable std::mutex m_mutex;
+    HandlePool_<InUseFlag_> m_pool {};
+    bool m_enabled {false};
+    double m_idle_timeout {60};
+    std::size_t m_max_idle {32};
+    int64_t m_opens {0};
+    int64_t m_reuses {0};
+    int64_t m_closes {0};
+};
+
+// Open / close a vector dataset in the ogr_manage helpers, through the pool
+// when it is enabled.
+GDALDatasetH ogr_ds_open_(const std::string &dsn, unsigned int flags);
+void ogr_ds_release_(GDALDatasetH hDS);
+
+#endif  // OGR_DS_POOL_H_
@@ -20,6 +20,7 @@
 
 #include "ogr_util.h"
 #include "gdalraster.h"
+#include "ogr_ds_pool.h"
 
 using std::string_literals::operator""s;
 
@@ -535,8 +536,7 @@ std::string ogr_ds_format(const std::string &dsn) {
     std::string fmt = "";
 
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR);
     CPLPopErrorHandler();
 
     if (hDS == nullptr)
@@ -546,7 +546,7 @@ std::string ogr_ds_format(const std::string &dsn) {
     if (hDriver)
         fmt = GDALGetDriverShortName(hDriver);
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return fmt;
 }
 
@@ -560,10 +560,9 @@ SEXP ogr_ds_test_cap(const std::string &dsn, bool with_update = true) {
 
     GDALDatasetH hDS = nullptr;
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(
-        dsn_in.c_str(),
-        with_update ? GDAL_OF_VECTOR | GDAL_OF_UPDATE : GDAL_OF_VECTOR,
-        nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(
+        dsn_in,
+        with_update ? GDAL_OF_VECTOR | GDAL_OF_UPDATE : GDAL_OF_VECTOR);
     CPLPopErrorHandler();
     if (hDS == nullptr)
         return R_NilValue;
@@ -604,7 +603,7 @@ SEXP ogr_ds_test_cap(const std::string &dsn, bool with_update = true) {
             "UpdateFieldDomain");
 #endif
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return cap;
 }
 
@@ -655,6 +654,9 @@ GDALVector *create_ogr(const std::string &format,
         opt_list[dsco_in.size()] = nullptr;
     }
 
+    // pooled handles on a data source being recreated would be stale
+    OGRDatasetPool_::instance().evict(dsn_in);
+
     GDALDatasetH hDstDS = nullptr;
     hDstDS = GDALCreate(hDriver, dsn_in.c_str(),
                         0, 0, 0, GDT_Unknown,
@@ -731,13 +733,13 @@ int ogr_ds_layer_count(const std::string &dsn) {
     GDALDatasetH hDS = nullptr;
 
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR, nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR);
     CPLPopErrorHandler();
 
     int cnt = 0;
     if (hDS != nullptr) {
         cnt = GDALDatasetGetLayerCount(hDS);
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
     }
     return cnt;
 }
@@ -752,14 +754,14 @@ SEXP ogr_ds_layer_names(const std::string &dsn) {
     GDALDatasetH hDS = nullptr;
 
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR, nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR);
     CPLPopErrorHandler();
     if (hDS == nullptr)
         return R_NilValue;
 
     int cnt = GDALDatasetGetLayerCount(hDS);
     if (cnt == 0) {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return R_NilValue;
     }
 
@@ -776,7 +778,7 @@ SEXP ogr_ds_layer_names(const std::string &dsn) {
         }
     }
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return names;
 }
 
@@ -792,7 +794,7 @@ SEXP ogr_ds_field_domain_names(const std::string &dsn) {
     const std::string dsn_in = Rcpp::as<std::string>(check_gdal_filename(dsn));
     GDALDatasetH hDS = nullptr;
 
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR, nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR);
     if (hDS == nullptr) {
         Rcpp::warning("failed to open dataset");
         return R_NilValue;
@@ -804,7 +806,7 @@ SEXP ogr_ds_field_domain_names(const std::string &dsn) {
 
     if (!CPLFetchBool(papszDriverMD, GDAL_DCAP_FIELD_DOMAINS, false)) {
         Rcpp::warning("format does not support reading field domains");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return R_NilValue;
     }
 
@@ -813,7 +815,7 @@ SEXP ogr_ds_field_domain_names(const std::string &dsn) {
 
     Rcpp::CharacterVector names = wrap_gdal_string_list_(aosFldDomNames);
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return names;
 #endif
 }
@@ -833,8 +835,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
     GDALDatasetH hDS = nullptr;
     bool ret = false;
 
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
 
     if (hDS == nullptr) {
         Rcpp::stop("failed to open dataset");
@@ -846,7 +847,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
 
     // domain type
     if (!GDALDatasetTestCapability(hDS, ODsCAddFieldDomain)) {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         Rcpp::stop("format does not support adding field domains");
     }
 
@@ -854,7 +855,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
         fld_dom_defn["type"] == R_NilValue ||
         !Rcpp::is<Rcpp::CharacterVector>(fld_dom_defn["type"])) {
 
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         Rcpp::stop("'$type' must be a character string");
     }
     const std::string domain_type =
@@ -865,7 +866,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
         fld_dom_defn["domain_name"] == R_NilValue ||
         !Rcpp::is<Rcpp::CharacterVector>(fld_dom_defn["domain_name"])) {
 
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         Rcpp::stop("'$domain_name' must be a character string");
     }
     const std::string domain_name =
@@ -885,7 +886,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
         fld_dom_defn["field_type"] == R_NilValue ||
         !Rcpp::is<Rcpp::CharacterVector>(fld_dom_defn["field_type"])) {
 
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         Rcpp::stop("'$field_type' must be a character string");
     }
     const std::string field_type =
@@ -921,7 +922,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
         eOFDSP = OFDSP_GEOMETRY_RATIO;
     }
     else {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         Rcpp::stop("invalid '$split_policy'");
     }
 
@@ -944,7 +945,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
         eOFDMP = OFDMP_GEOMETRY_WEIGHTED;
     }
     else {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         Rcpp::stop("invalid '$merge_policy'");
     }
 
@@ -959,7 +960,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
             (!Rcpp::is<Rcpp::CharacterVector>(fld_dom_defn["coded_values"]) &&
              !Rcpp::is<Rcpp::DataFrame>(fld_dom_defn["coded_values"]))) {
 
-            GDALReleaseDataset(hDS);
+            ogr_ds_release_(hDS);
             Rcpp::stop(
                 "'$coded_values' must be a character vector or data frame");
         }
@@ -971,12 +972,12 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
             Rcpp::CharacterVector coded_values = fld_dom_defn["coded_values"];
 
             if (coded_values.size() == 0) {
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'coded_values' is empty");
             }
 
             if (Rcpp::is_true(Rcpp::any(Rcpp::is_na(coded_values)))) {
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'coded_values' cannot contain NA codes");
             }
 
@@ -989,7 +990,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
 
                 int nTokens = aosTokens.size();
                 if (nTokens < 1 || nTokens > 2) {
-                    GDALReleaseDataset(hDS);
+                    ogr_ds_release_(hDS);
                     if (!ogr_coded_values.empty()) {
                         for (auto &cv : ogr_coded_values) {
                             VSIFree(cv.pszCode);
@@ -1016,19 +1017,19 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
                 Rcpp::as<Rcpp::DataFrame>(fld_dom_defn["coded_values"]);
 
             if (coded_values.nrows() == 0) {
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'coded_values' is empty");
             }
 
             if (coded_values.size() != 2) {
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'coded_values' data frame must have two columns");
             }
 
             if (!Rcpp::is<Rcpp::CharacterVector>(coded_values[0]) ||
                 !Rcpp::is<Rcpp::CharacterVector>(coded_values[1])) {
 
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("columns of 'coded_values' must be character type");
             }
 
@@ -1036,7 +1037,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
             Rcpp::CharacterVector values = coded_values[1];
 
             if (Rcpp::is_true(Rcpp::any(Rcpp::is_na(codes)))) {
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'coded_values' cannot contain NA codes");
             }
 
@@ -1052,7 +1053,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
         }
         else {
             // should not ever reach this
-            GDALReleaseDataset(hDS);
+            ogr_ds_release_(hDS);
             Rcpp::stop(
                 "'$coded_values' must be a character vector or data frame");
         }
@@ -1134,13 +1135,13 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
                       !Rcpp::is<Rcpp::LogicalVector>(
                         fld_dom_defn["min_value"]))) {
 
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'$min_value' must be integer, double or NULL");
             }
             else {
                 Rcpp::NumericVector tmp = fld_dom_defn["min_value"];
                 if (tmp.size() != 1) {
-                    GDALReleaseDataset(hDS);
+                    ogr_ds_release_(hDS);
                     Rcpp::stop("'$min_value' must be a single numeric value");
                 }
                 min_value = tmp[0];
@@ -1163,13 +1164,13 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
                       !Rcpp::is<Rcpp::LogicalVector>(
                         fld_dom_defn["max_value"]))) {
 
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'$max_value' must be integer, double or NULL");
             }
             else {
                 Rcpp::NumericVector tmp = fld_dom_defn["max_value"];
                 if (tmp.size() != 1) {
-                    GDALReleaseDataset(hDS);
+                    ogr_ds_release_(hDS);
                     Rcpp::stop("'$max_value' must be a single numeric value");
                 }
                 max_value = tmp[0];
@@ -1182,7 +1183,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
             OGRField sMin, sMax;
             if (eFieldType == OFTInteger) {
                 if (min_value < INT32_MIN || max_value > INT32_MAX) {
-                    GDALReleaseDataset(hDS);
+                    ogr_ds_release_(hDS);
                     Rcpp::stop("min/max out of range for OFTInteger");
                 }
                 sMin.Integer = static_cast<int>(min_value);
@@ -1232,7 +1233,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
                       !Rcpp::is<Rcpp::IntegerVector>(
                         fld_dom_defn["min_value"]))) {
 
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'$min_value' must be numeric (integer64) or NULL");
             }
             else {
@@ -1240,7 +1241,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
                     Rcpp::as<Rcpp::NumericVector>(fld_dom_defn["min_value"]);
 
                 if (tmp.size() != 1) {
-                    GDALReleaseDataset(hDS);
+                    ogr_ds_release_(hDS);
                     Rcpp::stop("'$min_value' must be a single numeric value");
                 }
 
@@ -1268,7 +1269,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
                       !Rcpp::is<Rcpp::IntegerVector>(
                         fld_dom_defn["max_value"]))) {
 
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'$max_value' must be numeric (integer64) or NULL");
             }
             else {
@@ -1276,7 +1277,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
                     Rcpp::as<Rcpp::NumericVector>(fld_dom_defn["max_value"]);
 
                 if (tmp.size() != 1) {
-                    GDALReleaseDataset(hDS);
+                    ogr_ds_release_(hDS);
                     Rcpp::stop("'$max_value' must be a single numeric value");
                 }
 
@@ -1321,7 +1322,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
         }
 
         else {
-            GDALReleaseDataset(hDS);
+            ogr_ds_release_(hDS);
             if (eFieldType == OFTDateTime) {
                 cli_alert_danger_("use {.field $type} {.str RangeDateTime} "
                                   "for OFTDateTime");
@@ -1334,7 +1335,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
     // RangeDateTime
     else if (EQUAL(domain_type.c_str(), "rangedatetime")) {
         if (eFieldType != OFTDateTime) {
-            GDALReleaseDataset(hDS);
+            ogr_ds_release_(hDS);
             Rcpp::stop("'$field_type' must be OFTDateTime");
         }
 
@@ -1353,7 +1354,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
         else if (!fld_dom_defn.containsElementNamed("min_value") ||
                  !Rcpp::is<Rcpp::NumericVector>(fld_dom_defn["min_value"])) {
 
-            GDALReleaseDataset(hDS);
+            ogr_ds_release_(hDS);
             Rcpp::stop("'$min_value' must be 'numeric' of class 'POSIXct'");
         }
         else {
@@ -1362,7 +1363,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
             if (v_min.hasAttribute("class"))
                 attr = Rcpp::wrap(v_min.attr("class"));
             if (std::find(attr.begin(), attr.end(), "POSIXct") == attr.end()) {
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'$min_value' must be 'numeric' of class 'POSIXct'");
             }
             min_value = v_min[0];
@@ -1392,7 +1393,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
         else if (!fld_dom_defn.containsElementNamed("max_value") ||
                  !Rcpp::is<Rcpp::NumericVector>(fld_dom_defn["max_value"])) {
 
-            GDALReleaseDataset(hDS);
+            ogr_ds_release_(hDS);
             Rcpp::stop("'$max_value' must be 'numeric' of class 'POSIXct'");
         }
         else {
@@ -1401,7 +1402,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
             if (v_max.hasAttribute("class"))
                 attr = Rcpp::wrap(v_max.attr("class"));
             if (std::find(attr.begin(), attr.end(), "POSIXct") == attr.end()) {
-                GDALReleaseDataset(hDS);
+                ogr_ds_release_(hDS);
                 Rcpp::stop("'$max_value' must be 'numeric' of class 'POSIXct'");
             }
             max_value = v_max[0];
@@ -1475,7 +1476,7 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
     // GLOB
     else if (EQUAL(domain_type.c_str(), "glob")) {
         if (eFieldType != OFTString) {
-            GDALReleaseDataset(hDS);
+            ogr_ds_release_(hDS);
             Rcpp::stop("'$field_type' must be OFTString");
         }
 
@@ -1483,13 +1484,13 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
             fld_dom_defn["glob"] == R_NilValue ||
             !Rcpp::is<Rcpp::CharacterVector>(fld_dom_defn["glob"])) {
 
-            GDALReleaseDataset(hDS);
+            ogr_ds_release_(hDS);
             Rcpp::stop("'$glob' must be a character string");
         }
 
         Rcpp::CharacterVector tmp = fld_dom_defn["glob"];
         if (tmp.size() != 1) {
-            GDALReleaseDataset(hDS);
+            ogr_ds_release_(hDS);
             Rcpp::stop("'$glob' must be a character string");
         }
 
@@ -1516,12 +1517,12 @@ bool ogr_ds_add_field_domain(const std::string &dsn,
 
     // unrecognized type
     else {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         Rcpp::stop("unrecognized domain type");
     }
 
     // finished
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return ret;
 #endif
 }
@@ -1540,8 +1541,7 @@ bool ogr_ds_delete_field_domain(const std::string &dsn,
     const std::string dsn_in = Rcpp::as<std::string>(check_gdal_filename(dsn));
     GDALDatasetH hDS = nullptr;
 
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE, nullptr,
-                     nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
 
     if (hDS == nullptr) {
         Rcpp::warning("failed to open dataset");
@@ -1550,7 +1550,7 @@ bool ogr_ds_delete_field_domain(const std::string &dsn,
 
     bool ret = false;
     ret = GDALDatasetDeleteFieldDomain(hDS, domain_name.c_str(), nullptr);
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return ret;
 #endif
 }
@@ -1567,7 +1567,7 @@ bool ogr_layer_exists(const std::string &dsn, const std::string &layer) {
     bool ret = false;
 
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR, nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR);
     if (hDS == nullptr) {
         CPLPopErrorHandler();
         return false;
@@ -1578,7 +1578,7 @@ bool ogr_layer_exists(const std::string &dsn, const std::string &layer) {
     if (hLayer != nullptr)
         ret = true;
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return ret;
 }
 
@@ -1594,10 +1594,9 @@ SEXP ogr_layer_test_cap(const std::string &dsn, const std::string &layer,
     OGRLayerH hLayer = nullptr;
 
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(
-        dsn_in.c_str(),
-        with_update ? GDAL_OF_VECTOR | GDAL_OF_UPDATE : GDAL_OF_VECTOR,
-        nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(
+        dsn_in,
+        with_update ? GDAL_OF_VECTOR | GDAL_OF_UPDATE : GDAL_OF_VECTOR);
 
     if (layer == "")
         hLayer = GDALDatasetGetLayer(hDS, 0);
@@ -1605,10 +1604,12 @@ SEXP ogr_layer_test_cap(const std::string &dsn, const std::string &layer,
         hLayer = GDALDatasetGetLayerByName(hDS, layer.c_str());
     CPLPopErrorHandler();
 
+    // give the pooled handle back also if the layer is not found, it would
+    // otherwise stay in use
+    if (hDS != nullptr)
+        ogr_ds_release_(hDS);
     if (hDS == nullptr || hLayer == nullptr)
         return R_NilValue;
-    else
-        GDALReleaseDataset(hDS);
 
     GDALVector lyr = GDALVector(dsn_in.c_str(), layer, !with_update);
     Rcpp::List cap = lyr.testCapability();
@@ -1635,6 +1636,9 @@ GDALVector *ogr_layer_create(
     GDALDatasetH hDS = nullptr;
     OGRLayerH hLayer = nullptr;
 
+    // the new layer keeps its own handle, pooled handles would be stale
+    OGRDatasetPool_::instance().evict(dsn_in);
+
     hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
                      nullptr, nullptr, nullptr);
 
@@ -1676,8 +1680,7 @@ bool ogr_layer_rename(const std::string &dsn, const std::string &layer,
     GDALDatasetH hDS = nullptr;
     OGRLayerH  hLayer = nullptr;
 
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
 
     if (hDS == nullptr)
         return false;
@@ -1686,13 +1689,13 @@ bool ogr_layer_rename(const std::string &dsn, const std::string &layer,
     if (hLayer == nullptr) {
         cli_alert_danger_("failed to access {.arg layer} {.str "s + layer +
                           "}");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
     if (!OGR_L_TestCapability(hLayer, OLCRename)) {
         cli_alert_danger_("layer does not have Rename capability");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -1700,7 +1703,7 @@ bool ogr_layer_rename(const std::string &dsn, const std::string &layer,
     if (OGR_L_Rename(hLayer, new_name.c_str()) == OGRERR_NONE)
         ret = true;
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return ret;
 
 #endif
@@ -1717,15 +1720,14 @@ bool ogr_layer_delete(const std::string &dsn, const std::string &layer) {
     OGRLayerH  hLayer = nullptr;
     int layer_cnt, layer_idx;
 
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
 
     if (hDS == nullptr)
         return false;
 
     if (!GDALDatasetTestCapability(hDS, ODsCDeleteLayer)) {
         cli_alert_danger_("dataset does not have DeleteLayer capability");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -1733,7 +1735,7 @@ bool ogr_layer_delete(const std::string &dsn, const std::string &layer) {
     if (hLayer == nullptr) {
         cli_alert_danger_("failed to access {.arg layer} {.str "s + layer +
                           "}");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -1748,7 +1750,7 @@ bool ogr_layer_delete(const std::string &dsn, const std::string &layer) {
     if (GDALDatasetDeleteLayer(hDS, layer_idx) == OGRERR_NONE)
         ret = true;
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return ret;
 }
 
@@ -1764,7 +1766,7 @@ SEXP ogr_layer_field_names(const std::string &dsn, const std::string &layer) {
     OGRFeatureDefnH hFDefn = nullptr;
 
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR, nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR);
     if (hDS == nullptr) {
         CPLPopErrorHandler();
         return R_NilValue;
@@ -1776,13 +1778,13 @@ SEXP ogr_layer_field_names(const std::string &dsn, const std::string &layer) {
     CPLPopErrorHandler();
 
     if (hLayer == nullptr) {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return R_NilValue;
     }
 
     hFDefn = OGR_L_GetLayerDefn(hLayer);
     if (hFDefn == nullptr) {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return R_NilValue;
     }
 
@@ -1811,7 +1813,7 @@ SEXP ogr_layer_field_names(const std::string &dsn, const std::string &layer) {
         }
     }
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return names;
 }
 
@@ -1829,7 +1831,7 @@ int ogr_field_index(const std::string &dsn, const std::string &layer,
     int iField;
 
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR, nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR);
     if (hDS == nullptr) {
         CPLPopErrorHandler();
         return -1;
@@ -1841,7 +1843,7 @@ int ogr_field_index(const std::string &dsn, const std::string &layer,
     CPLPopErrorHandler();
 
     if (hLayer == nullptr) {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return -1;
     }
 
@@ -1851,7 +1853,7 @@ int ogr_field_index(const std::string &dsn, const std::string &layer,
     else
         iField = -1;
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return iField;
 }
 
@@ -1876,8 +1878,7 @@ bool ogr_field_create(const std::string &dsn, const std::string &layer,
     int iField;
 
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
 
     if (hDS == nullptr) {
         CPLPopErrorHandler();
@@ -1891,12 +1892,12 @@ bool ogr_field_create(const std::string &dsn, const std::string &layer,
     CPLPopErrorHandler();
 
     if (hLayer == nullptr) {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
     if (!OGR_L_TestCapability(hLayer, OLCCreateField)) {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         cli_alert_danger_("layer does not have CreateField capability");
         return false;
     }
@@ -1906,12 +1907,12 @@ bool ogr_field_create(const std::string &dsn, const std::string &layer,
         iField = OGR_FD_GetFieldIndex(hFDefn, fld_name.c_str());
     }
     else {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
     if (iField >= 0) {
         // fld_name already exists
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -1919,7 +1920,7 @@ bool ogr_field_create(const std::string &dsn, const std::string &layer,
                             fld_width, fld_precision, is_nullable, is_unique,
                             default_value, domain_name);
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return ret;
 }
 
@@ -1944,8 +1945,7 @@ bool ogr_geom_field_create(const std::string &dsn, const std::string &layer,
         Rcpp::stop("'geom_type' not recognized");
 
     CPLPushErrorHandler(CPLQuietErrorHandler);
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
 
     if (hDS == nullptr) {
         CPLPopErrorHandler();
@@ -1959,12 +1959,12 @@ bool ogr_geom_field_create(const std::string &dsn, const std::string &layer,
     CPLPopErrorHandler();
 
     if (hLayer == nullptr) {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
     if (!OGR_L_TestCapability(hLayer, OLCCreateGeomField)) {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         cli_alert_danger_("layer does not have CreateGeomField capability");
         return false;
     }
@@ -1974,19 +1974,19 @@ bool ogr_geom_field_create(const std::string &dsn, const std::string &layer,
         iField = OGR_FD_GetFieldIndex(hFDefn, fld_name.c_str());
     }
     else {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
     if (iField >= 0) {
         // fld_name already exists
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
     bool ret = CreateGeomField_(hDS, hLayer, fld_name, eGeomType, srs,
                                 is_nullable);
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return ret;
 }
 
@@ -2000,8 +2000,7 @@ bool ogr_field_rename(const std::string &dsn, const std::string &layer,
 
     const std::string dsn_in = Rcpp::as<std::string>(check_gdal_filename(dsn));
     GDALDatasetH hDS = nullptr;
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
     if (hDS == nullptr) {
         cli_alert_danger_("failed to open {.arg dsn} for update");
         return false;
@@ -2015,12 +2014,12 @@ bool ogr_field_rename(const std::string &dsn, const std::string &layer,
     if (hLayer == nullptr) {
         cli_alert_danger_("failed to access {.arg layer} {.str "s + layer +
                           "}");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
     if (!OGR_L_TestCapability(hLayer, OLCAlterFieldDefn)) {
         cli_alert_danger_("layer does not have AlterFieldDefn capability");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -2031,13 +2030,13 @@ bool ogr_field_rename(const std::string &dsn, const std::string &layer,
         iField = OGR_FD_GetFieldIndex(hFDefn, fld_name.c_str());
     }
     else {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
     if (iField == -1) {
         cli_alert_danger_("{.arg fld_name} {.str "s + fld_name + "} not found "
                           "on {.arg layer} {.str " + layer + "}");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -2054,7 +2053,7 @@ bool ogr_field_rename(const std::string &dsn, const std::string &layer,
     OGRErr err = OGR_L_AlterFieldDefn(hLayer, iField, hNewFieldDefn,
                                       ALTER_NAME_FLAG);
     OGR_Fld_Destroy(hNewFieldDefn);
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
 
     if (err != OGRERR_NONE) {
         cli_alert_danger_("failed to rename field");
@@ -2080,8 +2079,7 @@ bool ogr_field_set_domain_name(const std::string &dsn,
 #else
     const std::string dsn_in = Rcpp::as<std::string>(check_gdal_filename(dsn));
     GDALDatasetH hDS = nullptr;
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
     if (hDS == nullptr) {
         cli_alert_danger_("failed to open {.arg dsn} for update");
         return false;
@@ -2095,12 +2093,12 @@ bool ogr_field_set_domain_name(const std::string &dsn,
     if (hLayer == nullptr) {
         cli_alert_danger_("failed to access {.arg layer} {.str "s + layer +
                           "}");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
     if (!OGR_L_TestCapability(hLayer, OLCAlterFieldDefn)) {
         cli_alert_danger_("layer does not have AlterFieldDefn capability");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -2111,13 +2109,13 @@ bool ogr_field_set_domain_name(const std::string &dsn,
         iField = OGR_FD_GetFieldIndex(hFDefn, fld_name.c_str());
     }
     else {
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
     if (iField == -1) {
         cli_alert_danger_("{.arg fld_name} {.str "s + fld_name + "} not found "
                           "on {.arg layer} {.str " + layer + "}");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -2135,7 +2133,7 @@ bool ogr_field_set_domain_name(const std::string &dsn,
     OGRErr err = OGR_L_AlterFieldDefn(hLayer, iField, hNewFieldDefn,
                                       ALTER_DOMAIN_FLAG);
     OGR_Fld_Destroy(hNewFieldDefn);
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
 
     if (err != OGRERR_NONE) {
         cli_alert_danger_("failed to set field domain name");
@@ -2156,8 +2154,7 @@ bool ogr_field_delete(const std::string &dsn, const std::string &layer,
 
     const std::string dsn_in = Rcpp::as<std::string>(check_gdal_filename(dsn));
     GDALDatasetH hDS = nullptr;
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
     if (hDS == nullptr) {
         cli_alert_danger_("failed to open {.arg dsn} for update");
         return false;
@@ -2171,12 +2168,12 @@ bool ogr_field_delete(const std::string &dsn, const std::string &layer,
     if (hLayer == nullptr) {
         cli_alert_danger_("failed to access {.arg layer} {.str "s + layer +
                           "}");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
     if (!OGR_L_TestCapability(hLayer, OLCDeleteField)) {
         cli_alert_danger_("layer does not have DeleteField capability");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -2188,13 +2185,13 @@ bool ogr_field_delete(const std::string &dsn, const std::string &layer,
     }
     else {
         cli_alert_danger_("failed to obtain {.code OGRFeatureDefnH}");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
     if (iField == -1) {
         cli_alert_danger_("{.arg fld_name} {.str "s + fld_name + "} not found "
                           "on {.arg layer} {.str " + layer + "}");
-        GDALReleaseDataset(hDS);
+        ogr_ds_release_(hDS);
         return false;
     }
 
@@ -2202,7 +2199,7 @@ bool ogr_field_delete(const std::string &dsn, const std::string &layer,
     if (OGR_L_DeleteField(hLayer, iField) == OGRERR_NONE)
         ret = true;
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return ret;
 }
 
@@ -2230,8 +2227,7 @@ SEXP ogr_execute_sql(const std::string &dsn, const std::string &sql,
         }
     }
 
-    hDS = GDALOpenEx(dsn_in.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE,
-                     nullptr, nullptr, nullptr);
+    hDS = ogr_ds_open_(dsn_in, GDAL_OF_VECTOR | GDAL_OF_UPDATE);
     if (hDS == nullptr) {
         cli_alert_danger_("failed to open DSN for update: {.str "s + dsn_in +
                           "}");
@@ -2256,6 +2252,6 @@ SEXP ogr_execute_sql(const std::string &dsn, const std::string &sql,
     if (hGeom_filter != nullptr)
         OGR_G_DestroyGeometry(hGeom_filter);
 
-    GDALReleaseDataset(hDS);
+    ogr_ds_release_(hDS);
     return R_NilValue;
 }
@@ -0,0 +1,543 @@
+/* Tiled multi-threaded polygonize of a raster band
+
+   The raster is split into tiles that are vectorized concurrently on a pool
+   of worker threads. For each tile, a worker reads the band values and the
+   validity mask, labels the connected regions of equal value
+   (region_label.h), and runs GDALPolygonize() on the in-memory label raster.
+   Polygonizing labels rather than values gives one polygon per region, and
+   the label raster is georeferenced in pixel coordinates so that polygon
+   vertices on the tile seams are exact integers.
+
+   Regions that do not touch an inner tile edge are complete, and are written
+   to the output layer after each batch of tiles. Regions touching an inner
+   edge are kept, and the regions connected across seams are found with
+   TileSeamMerger_ as tiles are added. Once all tiles are done, the pieces of
+   each region are unioned (concurrently across regions) and written.
+   Polygons are converted to georeferenced coordinates with the geotransform
+   of the source raster before writing. Features are written on the main
+   thread, in transactions of POLYGONIZE_TXN_FEATURES_ features when the
+   output data source supports them.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <gdal_alg.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+#include <ogr_api.h>
+
+#include <Rcpp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gdalraster.h"
+#include "rcpp_util.h"
+#include "region_label.h"
+#include "thread_util.h"
+
+// number of features written per transaction
+constexpr int POLYGONIZE_TXN_FEATURES_ = 10000;
+
+struct GeomDeleter_ {
+    void operator()(void *h) const {
+        OGR_G_DestroyGeometry(static_cast<OGRGeometryH>(h));
+    }
+};
+using GeomPtr_ = std::unique_ptr<void, GeomDeleter_>;
+
+struct RegionPolygon_ {
+    GeomPtr_ geom {};
+    double value {0};
+    uint64_t key {0};
+};
+
+// output of one tile
+struct PolygonizeTile_ {
+    int xoff {0};
+    int yoff {0};
+    int xsize {0};
+    int ysize {0};
+    TileEdges_ edges {};
+    std::vector<RegionPolygon_> complete {};
+    std::vector<RegionPolygon_> on_seam {};
+};
+
+// Owns the output data source: on every exit path, including errors raised
+// with Rcpp::stop() and user interrupts, an open transaction is rolled back
+// and the dataset is released, so that the file is not left locked.
+class OutputDataset_ {
+ public:
+    explicit OutputDataset_(GDALDatasetH hDS) : m_hDS(hDS) {}
+    ~OutputDataset_() { close(); }
+    OutputDataset_(const OutputDataset_ &) = delete;
+    OutputDataset_ &operator=(const OutputDataset_ &) = delete;
+
+    GDALDatasetH get() const { return m_hDS; }
+    bool inTransaction() const { return m_in_txn; }
+
+    // false if the data source does not support transactions
+    bool startTransaction() {
+        m_in_txn = (GDALDatasetStartTransaction(m_hDS, FALSE) ==
+                    OGRERR_NONE);
+        return m_in_txn;
+    }
+
+    bool commitTransaction() {
+        m_in_txn = false;
+        return GDALDatasetCommitTransaction(m_hDS) == OGRERR_NONE;
+    }
+
+    void close() {
+        if (m_hDS == nullptr)
+            return;
+        if (m_in_txn)
+            GDALDatasetRollbackTransaction(m_hDS);
+        m_in_txn = false;
+        GDALReleaseDataset(m_hDS);
+        m_hDS = nullptr;
+    }
+
+ private:
+    GDALDatasetH m_hDS {nullptr};
+    bool m_in_txn {false};
+};
+
+// pixel/line to georeferenced coordinates, in place
+static void pixel_to_geo_(OGRGeometryH hGeom, const double *gt) {
+    const int num_sub = OGR_G_GetGeometryCount(hGeom);
+    if (num_sub > 0) {
+        for (int i = 0; i < num_sub; ++i)
+            pixel_to_geo_(OGR_G_GetGeometryRef(hGeom, i), gt);
+        return;
+    }
+    const int num_pts = OGR_G_GetPointCount(hGeom);
+    for (int i = 0; i < num_pts; ++i) {
+        const double px = OGR_G_GetX(hGeom, i);
+        const double ln = OGR_G_GetY(hGeom, i);
+        OGR_G_SetPoint_2D(hGeom, i, gt[0] + px * gt[1] + ln * gt[2],
+                          gt[3] + px * gt[4] + ln * gt[5]);
+    }
+}
+
+//' Tiled multi-threaded polygonize
+//'
+//' Called from and documented in R/gdalraster_proc.R
+//' @noRd
+// [[Rcpp::export(name = ".polygonize_tiles")]]
+bool polygonize_tiles(const Rcpp::CharacterVector &src_filename,
+                      int src_band, const Rcpp::CharacterVector &out_dsn,
+                      const std::string &out_layer,
+                      const std::string &fld_name,
+                      const Rcpp::CharacterVector &mask_file,
+                      bool nomask, int connectedness,
+                      const Rcpp::IntegerVector &tile_size,
+                      int num_threads, bool quiet) {
+
+    if (connectedness != 4 && connectedness != 8)
+        Rcpp::stop("'connectedness' must be 4 or 8");
+    if (tile_size.size() != 2 || tile_size[0] < 1 || tile_size[1] < 1)
+        Rcpp::stop("'tile_size' must contain two values > 0");
+    if (static_cast<double>(tile_size[0]) * tile_size[1] > INT32_MAX)
+        Rcpp::stop("'tile_size' is too large");
+
+    const std::string mask_file_in =
+        Rcpp::as<std::string>(check_gdal_filename(mask_file));
+
+    GDALRaster src_ds(src_filename, true, R_NilValue, false, R_NilValue);
+    GDALDatasetH hSrcDS = src_ds.getGDALDatasetH_();
+    if (GDALGetRasterBand(hSrcDS, src_band) == nullptr)
+        Rcpp::stop("failed to access the source band");
+
+    const int nx = GDALGetRasterXSize(hSrcDS);
+    const int ny = GDALGetRasterYSize(hSrcDS);
+    double gt[6] = {0, 1, 0, 0, 0, 1};
+    GDALGetGeoTransform(hSrcDS, gt);
+
+    std::unique_ptr<GDALRaster> mask_ds = nullptr;
+    if (mask_file_in != "") {
+        mask_ds = std::make_unique<GDALRaster>(mask_file, true, R_NilValue,
+                                               false, R_NilValue);
+        if (GDALGetRasterXSize(mask_ds->getGDALDatasetH_()) != nx ||
+                GDALGetRasterYSize(mask_ds->getGDALDatasetH_()) != ny) {
+            Rcpp::stop("the mask raster must have the same dimensions as "
+                       "the source raster");
+        }
+    }
+
+    const std::string out_dsn_in =
+        Rcpp::as<std::string>(check_gdal_filename(out_dsn));
+    OutputDataset_ out_ds(GDALOpenEx(out_dsn_in.c_str(),
+                                     GDAL_OF_VECTOR | GDAL_OF_UPDATE,
+                                     nullptr, nullptr, nullptr));
+    if (out_ds.get() == nullptr)
+        Rcpp::stop("failed to open the output vector data source");
+
+    OGRLayerH hOutLayer = GDALDatasetGetLayerByName(out_ds.get(),
+                                                    out_layer.c_str());
+    if (hOutLayer == nullptr)
+        Rcpp::stop("failed to open the output layer");
+    OGRFeatureDefnH hOutDefn = OGR_L_GetLayerDefn(hOutLayer);
+    const int iPixValField = OGR_FD_GetFieldIndex(hOutDefn, fld_name.c_str());
+    if (iPixValField == -1)
+        Rcpp::warning("field not found, pixel values will not be written");
+    const bool split_multi =
+        wkbFlatten(OGR_L_GetGeomType(hOutLayer)) == wkbPolygon;
+
+    // tile grid
+    const int ntx = (nx + tile_size[0] - 1) / tile_size[0];
+    const int nty = (ny + tile_size[1] - 1) / tile_size[1];
+    const std::size_t num_tiles = static_cast<std::size_t>(ntx) * nty;
+
+    int nthreads = resolve_num_threads_(num_threads, num_tiles);
+    std::unique_ptr<WorkerDatasets_> worker_src = nullptr;
+    std::unique_ptr<WorkerDatasets_> worker_mask = nullptr;
+    if (nthreads > 1) {
+        worker_src = std::make_unique<WorkerDatasets_>(&src_ds, nthreads);
+        if (mask_ds) {
+            worker_mask = std::make_unique<WorkerDatasets_>(mask_ds.get(),
+                                                            nthreads);
+        }
+        if (worker_src->empty() || (worker_mask && worker_mask->empty())) {
+            if (!quiet)
+                cli_alert_info_("the raster cannot be reopened for "
+                                "multi-threaded read, using one thread");
+            nthreads = 1;
+        }
+    }
+
+    GDALDriverH hMemDrv = GDALGetDriverByName("MEM");
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 11, 0)
+    GDALDriverH hMemVecDrv = hMemDrv;
+#else
+    GDALDriverH hMemVecDrv = GDALGetDriverByName("Memory");
+#endif
+    if (hMemDrv == nullptr || hMemVecDrv == nullptr)
+        Rcpp::stop("failed to get the in-memory drivers");
+
+    std::vector<char *> polygonize_opt = {nullptr};
+    if (connectedness == 8)
+        polygonize_opt.insert(polygonize_opt.begin(),
+                              const_cast<char *>("8CONNECTED=8"));
+
+    // runs on worker threads: must not call into R
+    auto process_tile = [&](PolygonizeTile_ *tile, int thread_idx) {
+        GDALDatasetH hDS = nthreads > 1 ? worker_src->get(thread_idx)
+                                        : hSrcDS;
+        GDALRasterBandH hBand = GDALGetRasterBand(hDS, src_band);
+
+        const int xs = tile->xsize;
+        const int ys = tile->ysize;
+        const std::size_t num_pixels = static_cast<std::size_t>(xs) * ys;
+        std::vector<double> values(num_pixels);
+        std::vector<unsigned char> valid(num_pixels, 1);
+
+        CPLErr err = GDALRasterIO(hBand, GF_Read, tile->xoff, tile->yoff,
+                                  xs, ys, values.data(), xs, ys, GDT_Float64,
+                                  0, 0);
+
+        if (err == CE_None && mask_ds) {
+            // any non-zero value of the mask raster is valid
+            GDALDatasetH hMaskDS = nthreads > 1 ? worker_mask->get(thread_idx)
+                                                : mask_ds->getGDALDatasetH_();
+            std::vector<double> mask_values(num_pixels);
+            err = GDALRasterIO(GDALGetRasterBand(hMaskDS, 1), GF_Read,
+                               tile->xoff, tile->yoff, xs, ys,
+                               mask_values.data(), xs, ys, GDT_Float64, 0, 0);
+            for (std::size_t i = 0; i < num_pixels; ++i)
+                valid[i] = (mask_values[i] != 0) ? 1 : 0;
+        }
+        else if (err == CE_None && !nomask) {
+            err = GDALRasterIO(GDALGetMaskBand(hBand), GF_Read, tile->xoff,
+                               tile->yoff, xs, ys, valid.data(), xs, ys,
+                               GDT_Byte, 0, 0);
+        }
+        if (err != CE_None) {
+            throw std::runtime_error(std::string("read raster failed: ") +
+                                     CPLGetLastErrorMsg());
+        }
+
+        // GDALPolygonize() works on integer values
+        for (std::size_t i = 0; i < num_pixels; ++i) {
+            if (std::isnan(values[i]))
+                valid[i] = 0;
+            else
+                values[i] = std::trunc(values[i]);
+        }
+
+        std::vector<int32_t> labels(num_pixels);
+        const int32_t num_labels = label_regions_(
+            values.data(), valid.data(), xs, ys, connectedness,
+            labels.data());
+
+        tile->edges = tile_edges_(values.data(), labels.data(), tile->xoff,
+                                  tile->yoff, xs, ys);
+        if (num_labels == 0)
+            return;
+
+        // region values, and regions that touch an inner tile edge
+        std::vector<double> label_value(num_labels + 1, 0);
+        for (std::size_t i = 0; i < num_pixels; ++i)
+            label_value[labels[i]] = values[i];
+
+        std::vector<unsigned char> on_seam(num_labels + 1, 0);
+        const TileEdges_ &e = tile->edges;
+        if (tile->yoff > 0) {
+            for (int32_t l : e.top_lab)
+                on_seam[l] = 1;
+        }
+        if (tile->yoff + ys < ny) {
+            for (int32_t l : e.bottom_lab)
+                on_seam[l] = 1;
+        }
+        if (tile->xoff > 0) {
+            for (int32_t l : e.left_lab)
+                on_seam[l] = 1;
+        }
+        if (tile->xoff + xs < nx) {
+            for (int32_t l : e.right_lab)
+                on_seam[l] = 1;
+        }
+
+        // polygonize the labels in pixel coordinates of the full raster
+        GDALDatasetH hLabDS = GDALCreate(hMemDrv, "", xs, ys, 1, GDT_Int32,
+                                         nullptr);
+        GDALDatasetH hVecDS = GDALCreate(hMemVecDrv, "", 0, 0, 0,
+                                         GDT_Unknown, nullptr);
+        auto close_mem = [&]() {
+            if (hLabDS != nullptr)
+                GDALClose(hLabDS);
+            if (hVecDS != nullptr)
+                GDALClose(hVecDS);
+        };
+        if (hLabDS == nullptr || hVecDS == nullptr) {
+            close_mem();
+            throw std::runtime_error("failed to create in-memory datasets");
+        }
+
+        double tile_gt[6] = {static_cast<double>(tile->xoff), 1, 0,
+                             static_cast<double>(tile->yoff), 0, 1};
+        GDALSetGeoTransform(hLabDS, tile_gt);
+        GDALRasterBandH hLabBand = GDALGetRasterBand(hLabDS, 1);
+        GDALSetRasterNoDataValue(hLabBand, 0);
+        err = GDALRasterIO(hLabBand, GF_Write, 0, 0, xs, ys, labels.data(),
+                           xs, ys, GDT_Int32, 0, 0);
+
+        OGRLayerH hLayer = nullptr;
+        if (err == CE_None) {
+            hLayer = GDALDatasetCreateLayer(hVecDS, "regions", nullptr,
+                                            wkbPolygon, nullptr);
+        }
+        if (hLayer != nullptr) {
+            OGRFieldDefnH hFld = OGR_Fld_Create("label", OFTInteger);
+            if (OGR_L_CreateField(hLayer, hFld, TRUE) != OGRERR_NONE)
+                hLayer = nullptr;
+            OGR_Fld_Destroy(hFld);
+        }
+        if (hLayer != nullptr) {
+            err = GDALPolygonize(hLabBand, GDALGetMaskBand(hLabBand), hLayer,
+                                 0, polygonize_opt.data(), nullptr, nullptr);
+        }
+        if (hLayer == nullptr || err != CE_None) {
+            const std::string msg = CPLGetLastErrorMsg();
+            close_mem();
+            throw std::runtime_error("polygonize failed for tile at (" +
+                                     std::to_string(tile->xoff) + ", " +
+                                     std::to_string(tile->yoff) + "): " +
+                                     msg);
+        }
+
+        OGR_L_ResetReading(hLayer);
+        OGRFeatureH hFeat = nullptr;
+        while ((hFeat = OGR_L_GetNextFeature(hLayer)) != nullptr) {
+            const int32_t l = OGR_F_GetFieldAsInteger(hFeat, 0);
+            RegionPolygon_ poly;
+            OGRGeometryH hGeom = OGR_F_GetGeometryRef(hFeat);
+            if (hGeom != nullptr)
+                poly.geom.reset(OGR_G_Clone(hGeom));
+            OGR_F_Destroy(hFeat);
+            if (!poly.geom || l < 1 || l > num_labels)
+                continue;
+            poly.value = label_value[l];
+            poly.key = region_key_(0, l);
+            if (on_seam[l])
+                tile->on_seam.push_back(std::move(poly));
+            else
+                tile->complete.push_back(std::move(poly));
+        }
+        close_mem();
+    };
+
+    // feature output on the main thread
+    int txn_count = 0;
+    int64_t num_written = 0;
+    auto begin_txn = [&]() {
+        out_ds.startTransaction();
+        txn_count = 0;
+    };
+    auto write_polygon = [&](OGRGeometryH hGeom, double value) {
+        pixel_to_geo_(hGeom, gt);
+        OGRFeatureH hFeat = OGR_F_Create(hOutDefn);
+        if (iPixValField >= 0) {
+            OGR_F_SetFieldInteger64(hFeat, iPixValField,
+                                    static_cast<GIntBig>(value));
+        }
+        OGR_F_SetGeometryDirectly(hFeat, hGeom);
+        const OGRErr ogr_err = OGR_L_CreateFeature(hOutLayer, hFeat);
+        OGR_F_Destroy(hFeat);
+        if (ogr_err != OGRERR_NONE)
+            return false;
+        num_written += 1;
+        if (out_ds.inTransaction() &&
+                ++txn_count >= POLYGONIZE_TXN_FEATURES_) {
+            if (!out_ds.commitTransaction())
+                return false;
+            begin_txn();
+        }
+        return true;
+    };
+    auto write_region = [&](GeomPtr_ geom, double value) {
+        OGRGeometryH hGeom = static_cast<OGRGeometryH>(geom.release());
+        if (split_multi &&
+                wkbFlatten(OGR_G_GetGeometryType(hGeom)) == wkbMultiPolygon) {
+            // regions joined only at a corner, written as separate polygons
+            bool ok = true;
+            for (int i = 0; i < OGR_G_GetGeometryCount(hGeom); ++i) {
+                OGRGeometryH hPart =
+                    OGR_G_Clone(OGR_G_GetGeometryRef(hGeom, i));
+                ok = write_polygon(hPart, value) && ok;
+            }
+            OGR_G_DestroyGeometry(hGeom);
+            return ok;
+        }
+        return write_polygon(hGeom, value);
+    };
+    if (!quiet) {
+        cli_alert_info_("polygonizing " + std::to_string(num_tiles) +
+                        " tile(s) using " + std::to_string(nthreads) +
+                        " thread(s)...");
+        GDALTermProgressR(0.0, nullptr, nullptr);
+    }
+
+    begin_txn();
+    TileSeamMerger_ merger(ntx, connectedness);
+    std::vector<RegionPolygon_> seam_polys;
+
+    for (std::size_t batch_start = 0; batch_start < num_tiles;
+            batch_start += nthreads) {
+
+        const std::size_t batch_size =
+            std::min(static_cast<std::size_t>(nthreads),
+                     num_tiles - batch_start);
+
+        std::vector<PolygonizeTile_> batch(batch_size);
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const std::size_t t = batch_start + i;
+            const int tx = static_cast<int>(t % ntx);
+            const int ty = static_cast<int>(t / ntx);
+            batch[i].xoff = tx * tile_size[0];
+            batch[i].yoff = ty * tile_size[1];
+            batch[i].xsize = std::min(tile_size[0], nx - batch[i].xoff);
+            batch[i].ysize = std::min(tile_size[1], ny - batch[i].yoff);
+        }
+
+        try {
+            parallel_for_(batch_size, std::min(nthreads,
+                                               static_cast<int>(batch_size)),
+                [&](std::size_t i, int thread_idx) {
+                    process_tile(&batch[i], thread_idx);
+                });
+        }
+        catch (const std::exception &e) {
+            Rcpp::stop(e.what());
+        }
+
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const std::size_t t = batch_start + i;
+            merger.add(t, std::move(batch[i].edges));
+            for (RegionPolygon_ &poly : batch[i].complete) {
+                if (!write_region(std::move(poly.geom), poly.value))
+                    Rcpp::stop("failed to write polygon features");
+            }
+            for (RegionPolygon_ &poly : batch[i].on_seam) {
+                poly.key = region_key_(t, region_key_label_(poly.key));
+                seam_polys.push_back(std::move(poly));
+            }
+        }
+
+        if (!quiet) {
+            GDALTermProgressR(
+                0.9 * static_cast<double>(batch_start + batch_size) /
+                num_tiles, nullptr, nullptr);
+        }
+        Rcpp::checkUserInterrupt();
+    }
+
+    // regions continued across seams: group the pieces by representative key
+    std::map<uint64_t, std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < seam_polys.size(); ++i)
+        groups[merger.uf().find(seam_polys[i].key)].push_back(i);
+
+    std::vector<std::vector<std::size_t>> group_list;
+    group_list.reserve(groups.size());
+    for (auto &g : groups)
+        group_list.push_back(std::move(g.second));
+    groups.clear();
+
+    std::vector<GeomPtr_> merged(group_list.size());
+    try {
+        parallel_for_(group_list.size(),
+            resolve_num_threads_(nthreads, group_list.size()),
+            [&](std::size_t g, int) {
+                const std::vector<std::size_t> &members = group_list[g];
+                if (members.size() == 1) {
+                    merged[g] = std::move(seam_polys[members[0]].geom);
+                    return;
+                }
+                GeomPtr_ parts(OGR_G_CreateGeometry(wkbMultiPolygon));
+                for (std::size_t i : members) {
+                    OGR_G_AddGeometryDirectly(
+                        static_cast<OGRGeometryH>(parts.get()),
+                        static_cast<OGRGeometryH>(
+                            seam_polys[i].geom.release()));
+                }
+                merged[g].reset(OGR_G_UnionCascaded(
+                    static_cast<OGRGeometryH>(parts.get())));
+                if (!merged[g]) {
+                    throw std::runtime_error(
+                        std::string("failed to merge polygons across tile "
+                                    "seams: ") + CPLGetLastErrorMsg());
+                }
+            });
+    }
+    catch (const std::exception &e) {
+        Rcpp::stop(e.what());
+    }
+
+    for (std::size_t g = 0; g < group_list.size(); ++g) {
+        const double value = seam_polys[group_list[g][0]].value;
+        if (!write_region(std::move(merged[g]), value))
+            Rcpp::stop("failed to write polygon features");
+    }
+
+    if (out_ds.inTransaction() && !out_ds.commitTransaction())
+        Rcpp::stop("failed to commit the output transaction");
+    out_ds.close();
+
+    if (!quiet) {
+        GDALTermProgressR(1.0, nullptr, nullptr);
+        cli_alert_info_(std::to_string(num_written) + " polygon(s) written");
+    }
+
+    return true;
+}
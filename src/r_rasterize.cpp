@@ -37,9 +37,11 @@
 
 #include <Rcpp.h>
 
-#include <algorithm>
+#include <cstddef>
 #include <vector>
 
+#include "r_rasterize.h"
+
 //' Rasterize one polygon
 //'
 //' @noRd
@@ -58,65 +60,15 @@ int rasterize_polygon(int rasterXsize, int rasterYsize,
         return 1;
     }
 
-    int nCoords = polygonX.size();
-    int nParts = part_sizes.size();
-
-    int minY = static_cast<int>(Rcpp::min(polygonY));
-    int maxY = static_cast<int>(Rcpp::max(polygonY));
-
-    if (minY < 0)
-        minY = 0;
-    if (maxY >= rasterYsize)
-        maxY = rasterYsize - 1;
-
-    const int minX = 0;
-    const int maxX = rasterXsize - 1;
-
-    std::vector<int> nodeX(nCoords);
-
-    for (int y = minY; y <= maxY; y++) {
-        const double scanY = y + 0.5;
-        std::fill(nodeX.begin(), nodeX.end(), -1);
-        int nNodes = 0;
-        int part_offset = 0;
-        for (int part = 0; part < nParts; part++) {
-            int j = part_offset + part_sizes[part] - 1;
-            for (int i = part_offset; i < part_offset + part_sizes[part]; i++) {
-                if ((polygonY[i] < scanY && polygonY[j] >= scanY) ||
-                    (polygonY[j] < scanY && polygonY[i] >= scanY)) {
-
-                    const double intersectX =
-                        polygonX[i] + (scanY - polygonY[i]) / (polygonY[j] -
-                        polygonY[i]) * (polygonX[j] - polygonX[i]);
-
-                    nodeX[nNodes++] =
-                        static_cast<int>(std::floor(intersectX + 0.5));
-                }
-                j = i;
-            }
-            part_offset += part_sizes[part];
-        }
-
-        std::sort(nodeX.begin(), nodeX.begin() + nNodes);
-
-        for (int i = 0; i + 1 < nNodes; i += 2) {
-            if (nodeX[i] > maxX)
-                break;
-            if (nodeX[i + 1] > minX) {
-                if (nodeX[i] < minX)
-                    nodeX[i] = minX;
-                if (nodeX[i + 1] > maxX)
-                    nodeX[i + 1] = maxX + 1;
-            }
-            else {
-                continue;
-            }
-            if (nodeX[i + 1] > nodeX[i]) {
-                fnRasterIO(
-                    y, nodeX[i], nodeX[i + 1] - 1, burn_value, attr_value);
-            }
-        }
-    }
+    const std::vector<int> part_sizes_in =
+        Rcpp::as<std::vector<int>>(part_sizes);
+
+    rasterize_polygon_scanlines_(
+        rasterXsize, rasterYsize, part_sizes_in, polygonX.begin(),
+        polygonY.begin(), static_cast<std::size_t>(polygonX.size()),
+        [&](int y, int x1, int x2) {
+            fnRasterIO(y, x1, x2, burn_value, attr_value);
+        });
 
     return 0;
 }
@@ -0,0 +1,93 @@
+/* Scanline polygon fill shared by rasterize_polygon() and zonal_stats()
+   See src/r_rasterize.cpp for a description and references.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef R_RASTERIZE_H_
+#define R_RASTERIZE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Calls fn(row, col_start, col_end) for each contiguous segment of pixels in
+// each row of a raster of size (rasterXsize, rasterYsize) that has its pixel
+// center inside the polygon. col_end is inclusive. Rows are visited in
+// increasing order. Polygon vertices are in pixel/line coordinates, with
+// part_sizes giving the number of vertices in each part/ring.
+// Does not call into R, so it is safe to use from a worker thread.
+template <typename Fn>
+void rasterize_polygon_scanlines_(int rasterXsize, int rasterYsize,
+                                  const std::vector<int> &part_sizes,
+                                  const double *polygonX,
+                                  const double *polygonY,
+                                  std::size_t nCoords, Fn &&fn) {
+
+    if (nCoords == 0 || rasterXsize < 1 || rasterYsize < 1)
+        return;
+
+    const int nParts = static_cast<int>(part_sizes.size());
+
+    int minY = static_cast<int>(*std::min_element(polygonY,
+                                                  polygonY + nCoords));
+    int maxY = static_cast<int>(*std::max_element(polygonY,
+                                                  polygonY + nCoords));
+
+    if (minY < 0)
+        minY = 0;
+    if (maxY >= rasterYsize)
+        maxY = rasterYsize - 1;
+
+    const int minX = 0;
+    const int maxX = rasterXsize - 1;
+
+    std::vector<int> nodeX(nCoords);
+
+    for (int y = minY; y <= maxY; y++) {
+        const double scanY = y + 0.5;
+        std::fill(nodeX.begin(), nodeX.end(), -1);
+        int nNodes = 0;
+        int part_offset = 0;
+        for (int part = 0; part < nParts; part++) {
+            int j = part_offset + part_sizes[part] - 1;
+            for (int i = part_offset; i < part_offset + part_sizes[part]; i++) {
+                if ((polygonY[i] < scanY && polygonY[j] >= scanY) ||
+                    (polygonY[j] < scanY && polygonY[i] >= scanY)) {
+
+                    const double intersectX =
+                        polygonX[i] + (scanY - polygonY[i]) / (polygonY[j] -
+                        polygonY[i]) * (polygonX[j] - polygonX[i]);
+
+                    nodeX[nNodes++] =
+                        static_cast<int>(std::floor(intersectX + 0.5));
+                }
+                j = i;
+            }
+            part_offset += part_sizes[part];
+        }
+
+        std::sort(nodeX.begin(), nodeX.begin() + nNodes);
+
+        for (int i = 0; i + 1 < nNodes; i += 2) {
+            if (nodeX[i] > maxX)
+                break;
+            if (nodeX[i + 1] > minX) {
+                if (nodeX[i] < minX)
+                    nodeX[i] = minX;
+                if (nodeX[i + 1] > maxX)
+                    nodeX[i + 1] = maxX + 1;
+            }
+            else {
+                continue;
+            }
+            if (nodeX[i + 1] > nodeX[i]) {
+                fn(y, nodeX[i], nodeX[i + 1] - 1);
+            }
+        }
+    }
+}
+
+#endif  // R_RASTERIZE_H_
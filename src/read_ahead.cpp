@@ -0,0 +1,198 @@
+/* Background read-ahead for sequential row-wise scans of a GDALRaster
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <cpl_error.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "read_ahead.h"
+#include "dataset_pool.h"
+#include "thread_util.h"
+
+ReadAhead_::ReadAhead_(GDALDatasetH hWorkerDS, int num_block_rows)
+        : m_hWorkerDS(hWorkerDS),
+          m_num_block_rows(std::max(num_block_rows, 1)) {
+
+    // block heights are cached here so that the main thread never touches
+    // the worker handle
+    m_raster_xsize = GDALGetRasterXSize(m_hWorkerDS);
+    m_raster_ysize = GDALGetRasterYSize(m_hWorkerDS);
+    const int nbands = GDALGetRasterCount(m_hWorkerDS);
+    m_block_ysize.assign(nbands + 1, 1);
+    for (int b = 1; b <= nbands; ++b) {
+        int block_xsize = 0;
+        int block_ysize = 0;
+        GDALGetBlockSize(GDALGetRasterBand(m_hWorkerDS, b), &block_xsize,
+                         &block_ysize);
+        if (block_ysize > 0)
+            m_block_ysize[b] = block_ysize;
+    }
+
+    m_thread = std::thread(&ReadAhead_::workerLoop_, this);
+}
+
+ReadAhead_::~ReadAhead_() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_idle_cv.notify_all();
+    if (m_thread.joinable())
+        m_thread.join();
+
+    if (m_hWorkerDS != nullptr)
+        DatasetPool_::instance().release(m_hWorkerDS);
+}
+
+ReadAheadStats_ ReadAhead_::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void ReadAhead_::wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle_cv.wait(lock, [this] {
+        return m_stop || m_next_row >= m_req_end_row;
+    });
+}
+
+void ReadAhead_::onRead(int band, int xoff, int yoff, int xsize, int ysize) {
+    (void) xoff;
+    (void) xsize;
+    const int end = yoff + ysize;
+
+    // a read is sequential if it starts within the rows of the previous read
+    // of the same band (the next block along the same row of blocks), or
+    // continues from its end
+    const bool sequential = (band == m_last_band && yoff >= m_last_yoff &&
+                             yoff <= m_last_end);
+    m_last_band = band;
+    m_last_yoff = yoff;
+    m_last_end = end;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.reads += 1;
+
+        const bool same_band = (band == m_req_band);
+
+        // block rows fetched in the background span the full raster width,
+        // so the read is served from them if all of its rows were fetched
+        if (same_band && yoff >= m_done_start_row && end <= m_done_end_row)
+            m_stats.hits += 1;
+        else
+            m_stats.misses += 1;
+
+        if (!sequential)
+            return;
+
+        m_stats.sequential_reads += 1;
+
+        if (band < 1 || band >= static_cast<int>(m_block_ysize.size()))
+            return;
+        const int block_ysize = m_block_ysize[band];
+
+        // first block boundary at or after the end of this read
+        const int next_block_row = ((end + block_ysize - 1) / block_ysize) *
+                                   block_ysize;
+
+        if (!same_band) {
+            // start read-ahead on a new band
+            m_gen += 1;
+            m_req_band = band;
+            m_req_block_ysize = block_ysize;
+            m_req_end_row = next_block_row;
+            m_next_row = next_block_row;
+            m_done_start_row = next_block_row;
+            m_done_end_row = next_block_row;
+        }
+        else if (m_next_row < end) {
+            // the scan has caught up with read-ahead, skip to the current row
+            m_gen += 1;
+            m_next_row = next_block_row;
+            m_done_start_row = next_block_row;
+            m_done_end_row = next_block_row;
+            m_req_end_row = std::max(m_req_end_row, next_block_row);
+        }
+
+        const int target = std::min(
+            m_raster_ysize, next_block_row + m_num_block_rows * block_ysize);
+        if (target > m_req_end_row)
+            m_req_end_row = target;
+    }
+    m_cv.notify_all();
+    m_idle_cv.notify_all();
+}
+
+// runs on the read-ahead thread: must not call into R
+void ReadAhead_::workerLoop_() {
+    QuietErrorHandlerGuard_ quiet_errors;
+    std::vector<unsigned char> buf;
+
+    while (true) {
+        int64_t gen = 0;
+        int band = 0;
+        int row = 0;
+        int nrows = 0;
+        int advise_rows = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] {
+                return m_stop || m_next_row < m_req_end_row;
+            });
+            if (m_stop)
+                return;
+
+            gen = m_gen;
+            band = m_req_band;
+            row = m_next_row;
+            nrows = std::min(m_req_block_ysize, m_raster_ysize - row);
+            // hint the full pending range when starting on a new batch
+            if (row == m_done_end_row)
+                advise_rows = m_req_end_row - row;
+        }
+
+        const int xsize = m_raster_xsize;
+        GDALRasterBandH hBand = GDALGetRasterBand(m_hWorkerDS, band);
+        bool ok = (hBand != nullptr && nrows > 0);
+        if (ok) {
+            const GDALDataType dt = GDALGetRasterDataType(hBand);
+            if (advise_rows > nrows) {
+                GDALRasterAdviseRead(hBand, 0, row, xsize, advise_rows,
+                                     xsize, advise_rows, dt, nullptr);
+            }
+            const std::size_t buf_size =
+                static_cast<std::size_t>(xsize) * nrows *
+                GDALGetDataTypeSizeBytes(dt);
+            if (buf.size() < buf_size)
+                buf.resize(buf_size);
+            ok = (GDALRasterIO(hBand, GF_Read, 0, row, xsize, nrows,
+                               buf.data(), xsize, nrows, dt, 0, 0) == CE_None);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // skip the result if the request changed while reading
+            if (gen == m_gen && row == m_next_row) {
+                if (ok) {
+                    m_next_row = row + nrows;
+                    m_done_end_row = m_next_row;
+                    m_stats.rows_prefetched += nrows;
+                }
+                else {
+                    // give up on this band, the main read will report errors
+                    m_next_row = m_req_end_row;
+                }
+            }
+        }
+        m_idle_cv.notify_all();
+    }
+}
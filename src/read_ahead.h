@@ -0,0 +1,86 @@
+/* Background read-ahead for sequential row-wise scans of a GDALRaster
+
+   ReadAhead_ watches the reads made through a GDALRaster object. When it
+   detects a sequential top-to-bottom scan of a band, it reads the next block
+   rows on a background thread using a separate read-only handle on the same
+   dataset. Block rows are read across the full width of the raster, so a
+   scan that proceeds block by block along each row of blocks is covered as
+   well as a scan by rows of pixels. The GDAL block cache is per dataset
+   handle, so this does not fill the block cache of the main handle. It warms
+   the caches shared across handles instead: the /vsicurl/ (and related)
+   region cache for network files, and the OS page cache for local files.
+   Reads by the main handle are counted as hits when all the block rows they
+   touch have already been fetched in the background.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef READ_AHEAD_H_
+#define READ_AHEAD_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gdalraster.h"
+
+struct ReadAheadStats_ {
+    int64_t reads = 0;
+    int64_t sequential_reads = 0;
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t rows_prefetched = 0;
+};
+
+class ReadAhead_ {
+ public:
+    // hWorkerDS is owned by this object and released in the destructor
+    ReadAhead_(GDALDatasetH hWorkerDS, int num_block_rows);
+    ~ReadAhead_();
+    ReadAhead_(const ReadAhead_ &) = delete;
+    ReadAhead_ &operator=(const ReadAhead_ &) = delete;
+
+    // Called on the main thread before each read of a region of a band.
+    void onRead(int band, int xoff, int yoff, int xsize, int ysize);
+
+    // Blocks until the block rows requested so far have been read.
+    void wait();
+
+    int numBlockRows() const { return m_num_block_rows; }
+    ReadAheadStats_ stats() const;
+
+ private:
+    void workerLoop_();
+
+    GDALDatasetH m_hWorkerDS {nullptr};
+    int m_num_block_rows {2};
+    int m_raster_xsize {0};
+    int m_raster_ysize {0};
+    std::vector<int> m_block_ysize {};
+
+    // sequential access detection, main thread only
+    int m_last_band {0};
+    int m_last_yoff {-1};
+    int m_last_end {-1};
+
+    // shared with the worker thread, guarded by m_mutex
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_idle_cv;
+    int64_t m_gen {0};
+    int m_req_band {0};
+    int m_req_block_ysize {1};
+    int m_req_end_row {0};
+    int m_next_row {0};
+    int m_done_start_row {0};
+    int m_done_end_row {0};
+    bool m_stop {false};
+    ReadAheadStats_ m_stats {};
+
+    std::thread m_thread;
+};
+
+#endif  // READ_AHEAD_H_
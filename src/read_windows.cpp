@@ -0,0 +1,263 @@
+/* Batched read of many same-size windows of a raster into one array
+
+   Windows are sorted into raster block order and grouped, so that windows
+   sharing blocks in the same row of blocks are served by a single read of
+   their union. Groups are read on a pool of worker threads, each using its
+   own read-only handle on the dataset, directly into the output array.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+
+#include <Rcpp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gdalraster.h"
+#include "rcpp_util.h"
+#include "thread_util.h"
+
+// maximum number of pixels per band in one coalesced read
+constexpr int64_t READ_WINDOWS_MAX_GROUP_PIXELS_ = 4194304;
+
+struct WindowGroup_ {
+    int xoff {0};
+    int yoff {0};
+    int xsize {0};
+    int ysize {0};
+    std::vector<std::size_t> windows {};
+};
+
+//' Read a set of raster windows into a single array
+//'
+//' Called from and documented in R/read_windows.R
+//' @noRd
+// [[Rcpp::export(name = ".read_windows")]]
+Rcpp::NumericVector read_windows(const GDALRaster* const &ds,
+                                 const Rcpp::IntegerVector &bands,
+                                 const Rcpp::IntegerMatrix &windows,
+                                 int num_threads, bool quiet) {
+
+    ds->checkAccess_(GA_ReadOnly);
+
+    if (bands.size() < 1)
+        Rcpp::stop("'bands' must contain at least one band number");
+    for (int b : bands)
+        ds->getBand_(b);
+
+    if (windows.ncol() != 4)
+        Rcpp::stop("'windows' must be a matrix with four columns");
+
+    const std::size_t num_windows = static_cast<std::size_t>(windows.nrow());
+    const int nbands = static_cast<int>(bands.size());
+    const int raster_xsize = static_cast<int>(ds->getRasterXSize());
+    const int raster_ysize = static_cast<int>(ds->getRasterYSize());
+
+    int win_xsize = 0;
+    int win_ysize = 0;
+    if (num_windows > 0) {
+        win_xsize = windows(0, 2);
+        win_ysize = windows(0, 3);
+    }
+    for (std::size_t i = 0; i < num_windows; ++i) {
+        const int xoff = windows(i, 0);
+        const int yoff = windows(i, 1);
+        if (windows(i, 2) != win_xsize || windows(i, 3) != win_ysize)
+            Rcpp::stop("all windows must have the same xsize and ysize");
+        if (win_xsize < 1 || win_ysize < 1)
+            Rcpp::stop("window xsize and ysize must be > 0");
+        if (xoff == NA_INTEGER || yoff == NA_INTEGER || xoff < 0 ||
+                yoff < 0 || xoff + win_xsize > raster_xsize ||
+                yoff + win_ysize > raster_ysize) {
+            Rcpp::stop("window %d is outside the raster extent",
+                       static_cast<int>(i + 1));
+        }
+    }
+
+    const std::size_t win_pixels = static_cast<std::size_t>(win_xsize) *
+                                   win_ysize;
+    const std::size_t win_len = win_pixels * nbands;
+
+    Rcpp::NumericVector out = Rcpp::no_init(num_windows * win_len);
+    if (nbands == 1) {
+        out.attr("dim") = Rcpp::IntegerVector::create(
+            win_xsize, win_ysize, static_cast<int>(num_windows));
+    }
+    else {
+        out.attr("dim") = Rcpp::IntegerVector::create(
+            win_xsize, win_ysize, nbands, static_cast<int>(num_windows));
+    }
+    if (num_windows == 0)
+        return out;
+
+    std::vector<int> band_list(bands.begin(), bands.end());
+    std::vector<double> nodata(nbands);
+    std::vector<bool> has_nodata(nbands);
+    for (int b = 0; b < nbands; ++b) {
+        int has = FALSE;
+        nodata[b] = GDALGetRasterNoDataValue(ds->getBand_(band_list[b]), &has);
+        has_nodata[b] = has && !std::isnan(nodata[b]);
+    }
+
+    int block_xsize = 0;
+    int block_ysize = 0;
+    GDALGetBlockSize(ds->getBand_(band_list[0]), &block_xsize, &block_ysize);
+    if (block_xsize < 1)
+        block_xsize = raster_xsize;
+    if (block_ysize < 1)
+        block_ysize = 1;
+
+    // sort windows into block order
+    std::vector<std::size_t> order(num_windows);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&](std::size_t a, std::size_t b) {
+            const int ya = windows(a, 1) / block_ysize;
+            const int yb = windows(b, 1) / block_ysize;
+            if (ya != yb)
+                return ya < yb;
+            return windows(a, 0) < windows(b, 0);
+        });
+
+    // coalesce windows in the same row of blocks that share blocks
+    std::vector<WindowGroup_> groups;
+    int group_block_row = -1;
+    int group_xblock_end = -1;
+    for (std::size_t i : order) {
+        const int xoff = windows(i, 0);
+        const int yoff = windows(i, 1);
+        const int block_row = yoff / block_ysize;
+        const int xblock_start = xoff / block_xsize;
+        const int xblock_end = (xoff + win_xsize - 1) / block_xsize;
+
+        bool merge = false;
+        if (!groups.empty() && block_row == group_block_row &&
+                xblock_start <= group_xblock_end) {
+            const WindowGroup_ &g = groups.back();
+            const int x0 = std::min(g.xoff, xoff);
+            const int y0 = std::min(g.yoff, yoff);
+            const int x1 = std::max(g.xoff + g.xsize, xoff + win_xsize);
+            const int y1 = std::max(g.yoff + g.ysize, yoff + win_ysize);
+            merge = static_cast<int64_t>(x1 - x0) * (y1 - y0) <=
+                    READ_WINDOWS_MAX_GROUP_PIXELS_;
+        }
+
+        if (merge) {
+            WindowGroup_ &g = groups.back();
+            const int x1 = std::max(g.xoff + g.xsize, xoff + win_xsize);
+            const int y1 = std::max(g.yoff + g.ysize, yoff + win_ysize);
+            g.xoff = std::min(g.xoff, xoff);
+            g.yoff = std::min(g.yoff, yoff);
+            g.xsize = x1 - g.xoff;
+            g.ysize = y1 - g.yoff;
+            g.windows.push_back(i);
+            group_xblock_end = std::max(group_xblock_end, xblock_end);
+        }
+        else {
+            WindowGroup_ g;
+            g.xoff = xoff;
+            g.yoff = yoff;
+            g.xsize = win_xsize;
+            g.ysize = win_ysize;
+            g.windows.push_back(i);
+            groups.push_back(std::move(g));
+            group_block_row = block_row;
+            group_xblock_end = xblock_end;
+        }
+    }
+
+    const std::size_t num_groups = groups.size();
+    int nthreads = resolve_num_threads_(num_threads, num_groups);
+    std::unique_ptr<WorkerDatasets_> worker_ds = nullptr;
+    if (nthreads > 1) {
+        worker_ds = std::make_unique<WorkerDatasets_>(ds, nthreads);
+        if (worker_ds->empty()) {
+            if (!quiet)
+                cli_alert_info_("the raster dataset cannot be reopened for "
+                                "multi-threaded read, using one thread");
+            nthreads = 1;
+        }
+    }
+
+    std::vector<std::vector<double>> buffers(nthreads);
+    double *out_data = out.begin();
+    const int *win_data = windows.begin();
+    const std::size_t win_nrow = num_windows;
+
+    // runs on worker threads: must not call into R
+    auto read_group = [&](std::size_t gi, int thread_idx) {
+        const WindowGroup_ &g = groups[gi];
+        GDALDatasetH hDS = nthreads > 1 ? worker_ds->get(thread_idx)
+                                        : ds->getGDALDatasetH_();
+
+        const std::size_t group_pixels = static_cast<std::size_t>(g.xsize) *
+                                         g.ysize;
+        std::vector<double> &buf = buffers[thread_idx];
+        buf.resize(group_pixels * nbands);
+
+        CPLErr err = GDALDatasetRasterIO(
+            hDS, GF_Read, g.xoff, g.yoff, g.xsize, g.ysize, buf.data(),
+            g.xsize, g.ysize, GDT_Float64, nbands, band_list.data(), 0, 0, 0);
+
+        if (err != CE_None) {
+            throw std::runtime_error(std::string("read raster failed: ") +
+                                     CPLGetLastErrorMsg());
+        }
+
+        for (std::size_t w : g.windows) {
+            // column-major access to the windows matrix
+            const int wx = win_data[w] - g.xoff;
+            const int wy = win_data[w + win_nrow] - g.yoff;
+            for (int b = 0; b < nbands; ++b) {
+                const double *src = buf.data() + group_pixels * b;
+                double *dst = out_data + w * win_len + win_pixels * b;
+                for (int row = 0; row < win_ysize; ++row) {
+                    const double *src_row = src +
+                        static_cast<std::size_t>(wy + row) * g.xsize + wx;
+                    double *dst_row = dst +
+                        static_cast<std::size_t>(row) * win_xsize;
+                    std::copy(src_row, src_row + win_xsize, dst_row);
+                    if (has_nodata[b]) {
+                        for (int col = 0; col < win_xsize; ++col) {
+                            if (dst_row[col] == nodata[b])
+                                dst_row[col] = NA_REAL;
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    if (!quiet) {
+        cli_alert_info_("reading " + std::to_string(num_windows) +
+                        " window(s) in " + std::to_string(num_groups) +
+                        " read(s) using " + std::to_string(nthreads) +
+                        " thread(s)...");
+        GDALTermProgressR(0.0, nullptr, nullptr);
+    }
+
+    try {
+        parallel_for_(num_groups, nthreads, read_group,
+            [quiet](double frac) {
+                if (!quiet)
+                    GDALTermProgressR(frac, nullptr, nullptr);
+            });
+    }
+    catch (const std::exception &e) {
+        Rcpp::stop(e.what());
+    }
+
+    return out;
+}
@@ -0,0 +1,273 @@
+/* Connected region labeling of raster tiles, with merging across tile seams
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include "region_label.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+int32_t label_regions_(const double *values, const unsigned char *valid,
+                       int xsize, int ysize, int connectedness,
+                       int32_t *labels) {
+
+    // provisional labels and their union-find parents, label 0 is unused
+    std::vector<int32_t> parent(1, 0);
+
+    auto find = [&parent](int32_t a) {
+        while (parent[a] != a) {
+            parent[a] = parent[parent[a]];
+            a = parent[a];
+        }
+        return a;
+    };
+
+    auto unite = [&](int32_t a, int32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a < b)
+            parent[b] = a;
+        else if (b < a)
+            parent[a] = b;
+    };
+
+    const bool eight = (connectedness == 8);
+    for (int y = 0; y < ysize; ++y) {
+        const std::size_t row = static_cast<std::size_t>(y) * xsize;
+        const std::size_t prev_row = row - xsize;
+        for (int x = 0; x < xsize; ++x) {
+            const std::size_t i = row + x;
+            labels[i] = 0;
+            if (!valid[i])
+                continue;
+
+            const double v = values[i];
+            int32_t lab = 0;
+            auto visit = [&](std::size_t j) {
+                if (labels[j] == 0 || values[j] != v)
+                    return;
+                if (lab == 0)
+                    lab = labels[j];
+                else if (labels[j] != lab)
+                    unite(lab, labels[j]);
+            };
+
+            if (x > 0)
+                visit(i - 1);
+            if (y > 0) {
+                visit(prev_row + x);
+                if (eight && x > 0)
+                    visit(prev_row + x - 1);
+                if (eight && x < xsize - 1)
+                    visit(prev_row + x + 1);
+            }
+
+            if (lab == 0) {
+                lab = static_cast<int32_t>(parent.size());
+                parent.push_back(lab);
+            }
+            labels[i] = lab;
+        }
+    }
+
+    // final labels numbered in order of first occurrence
+    std::vector<int32_t> final_label(parent.size(), 0);
+    int32_t n = 0;
+    const std::size_t num_pixels = static_cast<std::size_t>(xsize) * ysize;
+    for (std::size_t i = 0; i < num_pixels; ++i) {
+        if (labels[i] == 0)
+            continue;
+        const int32_t root = find(labels[i]);
+        if (final_label[root] == 0)
+            final_label[root] = ++n;
+        labels[i] = final_label[root];
+    }
+    return n;
+}
+
+std::size_t RegionUnionFind_::index_(uint64_t key) {
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+        return it->second;
+    const std::size_t i = m_keys.size();
+    m_index.emplace(key, i);
+    m_keys.push_back(key);
+    m_parent.push_back(i);
+    return i;
+}
+
+std::size_t RegionUnionFind_::root_(std::size_t i) {
+    while (m_parent[i] != i) {
+        m_parent[i] = m_parent[m_parent[i]];
+        i = m_parent[i];
+    }
+    return i;
+}
+
+void RegionUnionFind_::unite(uint64_t a, uint64_t b) {
+    const std::size_t ra = root_(index_(a));
+    const std::size_t rb = root_(index_(b));
+    if (ra == rb)
+        return;
+    if (m_keys[ra] < m_keys[rb])
+        m_parent[rb] = ra;
+    else
+        m_parent[ra] = rb;
+}
+
+uint64_t RegionUnionFind_::find(uint64_t key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+        return key;
+    return m_keys[root_(it->second)];
+}
+
+TileEdges_ tile_edges_(const double *values, const int32_t *labels,
+                       int xoff, int yoff, int xsize, int ysize) {
+    TileEdges_ e;
+    e.xoff = xoff;
+    e.yoff = yoff;
+    e.xsize = xsize;
+    e.ysize = ysize;
+
+    const std::size_t last_row = static_cast<std::size_t>(ysize - 1) * xsize;
+    e.top_lab.assign(labels, labels + xsize);
+    e.top_val.assign(values, values + xsize);
+    e.bottom_lab.assign(labels + last_row, labels + last_row + xsize);
+    e.bottom_val.assign(values + last_row, values + last_row + xsize);
+
+    e.left_lab.resize(ysize);
+    e.left_val.resize(ysize);
+    e.right_lab.resize(ysize);
+    e.right_val.resize(ysize);
+    for (int y = 0; y < ysize; ++y) {
+        const std::size_t row = static_cast<std::size_t>(y) * xsize;
+        e.left_lab[y] = labels[row];
+        e.left_val[y] = values[row];
+        e.right_lab[y] = labels[row + xsize - 1];
+        e.right_val[y] = values[row + xsize - 1];
+    }
+    return e;
+}
+
+TileSeamMerger_::TileSeamMerger_(int num_tiles_x, int connectedness,
+                                 bool record_adjacent)
+        : m_num_tiles_x(std::max(num_tiles_x, 1)),
+          m_connectedness(connectedness),
+          m_record_adjacent(record_adjacent) {}
+
+void TileSeamMerger_::unite_if_same_(std::size_t ta, int32_t la, double va,
+                                     std::size_t tb, int32_t lb, double vb) {
+    if (la == 0 || lb == 0)
+        return;
+    if (va == vb)
+        m_uf.unite(region_key_(ta, la), region_key_(tb, lb));
+    else if (m_record_adjacent)
+        m_adjacent.emplace_back(region_key_(ta, la), region_key_(tb, lb));
+}
+
+// a is the tile to the left of, above, or diagonally above b, as given by
+// seam (not derived from the tile indexes, which are ambiguous with one or
+// two columns of tiles)
+void TileSeamMerger_::connect_(const TileEdges_ &a, std::size_t ta,
+                               const TileEdges_ &b, std::size_t tb,
+                               Seam_ seam) {
+
+    const bool eight = (m_connectedness == 8);
+
+    switch (seam) {
+    case Seam_::LEFT: {
+        // vertical seam, tiles in the same row have the same height
+        const int n = std::min(a.ysize, b.ysize);
+        for (int y = 0; y < n; ++y) {
+            unite_if_same_(ta, a.right_lab[y], a.right_val[y],
+                           tb, b.left_lab[y], b.left_val[y]);
+            if (eight && y > 0) {
+                unite_if_same_(ta, a.right_lab[y], a.right_val[y],
+                               tb, b.left_lab[y - 1], b.left_val[y - 1]);
+            }
+            if (eight && y < n - 1) {
+                unite_if_same_(ta, a.right_lab[y], a.right_val[y],
+                               tb, b.left_lab[y + 1], b.left_val[y + 1]);
+            }
+        }
+        break;
+    }
+    case Seam_::TOP: {
+        // horizontal seam, tiles in the same column have the same width
+        const int n = std::min(a.xsize, b.xsize);
+        for (int x = 0; x < n; ++x) {
+            unite_if_same_(ta, a.bottom_lab[x], a.bottom_val[x],
+                           tb, b.top_lab[x], b.top_val[x]);
+            if (eight && x > 0) {
+                unite_if_same_(ta, a.bottom_lab[x], a.bottom_val[x],
+                               tb, b.top_lab[x - 1], b.top_val[x - 1]);
+            }
+            if (eight && x < n - 1) {
+                unite_if_same_(ta, a.bottom_lab[x], a.bottom_val[x],
+                               tb, b.top_lab[x + 1], b.top_val[x + 1]);
+            }
+        }
+        break;
+    }
+    case Seam_::TOP_LEFT:
+        // corner: bottom right pixel of a, top left pixel of b
+        if (eight) {
+            unite_if_same_(ta, a.bottom_lab.back(), a.bottom_val.back(),
+                           tb, b.top_lab.front(), b.top_val.front());
+        }
+        break;
+    case Seam_::TOP_RIGHT:
+        // corner: bottom left pixel of a, top right pixel of b
+        if (eight) {
+            unite_if_same_(ta, a.bottom_lab.front(), a.bottom_val.front(),
+                           tb, b.top_lab.back(), b.top_val.back());
+        }
+        break;
+    }
+}
+
+void TileSeamMerger_::add(std::size_t t, TileEdges_ &&edges) {
+    const std::size_t ntx = static_cast<std::size_t>(m_num_tiles_x);
+    const std::size_t tx = t % ntx;
+    const bool has_top = t >= ntx;
+    const bool eight = (m_connectedness == 8);
+
+    std::vector<std::pair<std::size_t, Seam_>> neighbours;
+    if (tx > 0)
+        neighbours.emplace_back(t - 1, Seam_::LEFT);
+    if (has_top) {
+        neighbours.emplace_back(t - ntx, Seam_::TOP);
+        if (eight && tx > 0)
+            neighbours.emplace_back(t - ntx - 1, Seam_::TOP_LEFT);
+        if (eight && tx < ntx - 1)
+            neighbours.emplace_back(t - ntx + 1, Seam_::TOP_RIGHT);
+    }
+
+    for (const auto &nb : neighbours) {
+        auto it = m_edges.find(nb.first);
+        if (it != m_edges.end())
+            connect_(it->second, nb.first, edges, t, nb.second);
+    }
+
+    m_edges[t] = std::move(edges);
+
+    // tile s is last needed by tile s + ntx + 1
+    if (t >= ntx + 1) {
+        const std::size_t keep_from = t - ntx;
+        m_edges.erase(m_edges.begin(), m_edges.lower_bound(keep_from));
+    }
+}
+
+std::vector<std::pair<uint64_t, uint64_t>> TileSeamMerger_::take_adjacent() {
+    std::vector<std::pair<uint64_t, uint64_t>> adj;
+    adj.swap(m_adjacent);
+    std::sort(adj.begin(), adj.end());
+    adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
+    return adj;
+}
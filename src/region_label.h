@@ -0,0 +1,113 @@
+/* Connected region labeling of raster tiles, with merging across tile seams
+
+   Regions are connected sets of valid pixels sharing the same value, under
+   4- or 8-connectedness. label_regions_() labels the regions of one tile
+   with a two-pass union-find. Regions that touch the edge of a tile may
+   continue in the neighbouring tiles: TileSeamMerger_ keeps the edge rows
+   and columns of labeled tiles, and connects regions across each seam in a
+   RegionUnionFind_ over region keys (tile index and local label). Tiles are
+   added in row-major order, and the edges of a tile are released once all
+   of its neighbours have been added, so memory use is bounded by about two
+   rows of tiles' worth of edges.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef REGION_LABEL_H_
+#define REGION_LABEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Labels the regions of a tile of xsize * ysize pixels. values and valid
+// (non-zero for valid pixels) are in row-major order. Writes labels 1..n to
+// labels in order of first occurrence, 0 for invalid pixels, and returns n.
+int32_t label_regions_(const double *values, const unsigned char *valid,
+                       int xsize, int ysize, int connectedness,
+                       int32_t *labels);
+
+// key identifying the region with local label in tile
+inline uint64_t region_key_(std::size_t tile, int32_t label) {
+    return (static_cast<uint64_t>(tile) << 32) | static_cast<uint32_t>(label);
+}
+
+inline std::size_t region_key_tile_(uint64_t key) {
+    return static_cast<std::size_t>(key >> 32);
+}
+
+inline int32_t region_key_label_(uint64_t key) {
+    return static_cast<int32_t>(key & 0xFFFFFFFFu);
+}
+
+// Union-find over region keys. Only keys that have been united are stored.
+// The representative of a set is its smallest key.
+class RegionUnionFind_ {
+ public:
+    void unite(uint64_t a, uint64_t b);
+    // representative of the set containing key (key itself if not stored)
+    uint64_t find(uint64_t key);
+    bool contains(uint64_t key) const { return m_index.count(key) > 0; }
+    std::size_t size() const { return m_keys.size(); }
+
+ private:
+    std::size_t index_(uint64_t key);
+    std::size_t root_(std::size_t i);
+
+    std::unordered_map<uint64_t, std::size_t> m_index {};
+    std::vector<uint64_t> m_keys {};
+    std::vector<std::size_t> m_parent {};
+};
+
+// edge rows and columns of a labeled tile (labels and pixel values)
+struct TileEdges_ {
+    int xoff {0};
+    int yoff {0};
+    int xsize {0};
+    int ysize {0};
+    std::vector<int32_t> top_lab {}, bottom_lab {}, left_lab {}, right_lab {};
+    std::vector<double> top_val {}, bottom_val {}, left_val {}, right_val {};
+};
+
+TileEdges_ tile_edges_(const double *values, const int32_t *labels,
+                       int xoff, int yoff, int xsize, int ysize);
+
+// Connects the regions of a grid of tiles across tile seams. Optionally
+// records the pairs of regions with different values that touch across a
+// seam.
+class TileSeamMerger_ {
+ public:
+    TileSeamMerger_(int num_tiles_x, int connectedness,
+                    bool record_adjacent = false);
+
+    // Adds the edges of tile t, which must be added in row-major order, and
+    // connects its regions with those of the tiles to the left and above.
+    void add(std::size_t t, TileEdges_ &&edges);
+
+    RegionUnionFind_ &uf() { return m_uf; }
+
+    // region keys of adjacent regions recorded since the last call
+    std::vector<std::pair<uint64_t, uint64_t>> take_adjacent();
+
+ private:
+    // position of tile a relative to tile b
+    enum class Seam_ { LEFT, TOP, TOP_LEFT, TOP_RIGHT };
+
+    void connect_(const TileEdges_ &a, std::size_t ta, const TileEdges_ &b,
+                  std::size_t tb, Seam_ seam);
+    void unite_if_same_(std::size_t ta, int32_t la, double va,
+                        std::size_t tb, int32_t lb, double vb);
+
+    int m_num_tiles_x {1};
+    int m_connectedness {4};
+    bool m_record_adjacent {false};
+    std::map<std::size_t, TileEdges_> m_edges {};
+    RegionUnionFind_ m_uf {};
+    std::vector<std::pair<uint64_t, uint64_t>> m_adjacent {};
+};
+
+#endif  // REGION_LABEL_H_
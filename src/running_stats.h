@@ -9,8 +9,63 @@
 
 #include <Rcpp.h>
 
+#include <cmath>
 #include <cstdint>
 
+// Plain one-pass accumulator using the same algorithm as RunningStats, without
+// R dependencies, for use in native code that may run on worker threads.
+// merge() combines partial results (Chan et al. parallel algorithm).
+struct RunningStatsAccum_ {
+    int64_t count {0};
+    double mean {0.0};
+    double M2 {0.0};
+    double min {0.0};
+    double max {0.0};
+    double sum {0.0};
+
+    void update(double x) {
+        count += 1;
+        if (count == 1) {
+            mean = min = max = sum = x;
+            M2 = 0.0;
+        }
+        else {
+            const double delta = x - mean;
+            mean += (delta / count);
+            M2 += (delta * (x - mean));
+            if (x < min)
+                min = x;
+            else if (x > max)
+                max = x;
+            sum += x;
+        }
+    }
+
+    void merge(const RunningStatsAccum_ &other) {
+        if (other.count == 0)
+            return;
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        const double n_a = static_cast<double>(count);
+        const double n_b = static_cast<double>(other.count);
+        const double delta = other.mean - mean;
+        count += other.count;
+        mean += delta * n_b / (n_a + n_b);
+        M2 += other.M2 + delta * delta * n_a * n_b / (n_a + n_b);
+        if (other.min < min)
+            min = other.min;
+        if (other.max > max)
+            max = other.max;
+        sum += other.sum;
+    }
+
+    double var() const {
+        return count < 2 ? std::nan("") : M2 / (count - 1);
+    }
+};
+
 class RunningStats {
  public:
     RunningStats();
@@ -0,0 +1,503 @@
+/* Tiled multi-threaded sieve filter
+
+   As in GDALSieveFilter(), regions (connected pixels of the same value)
+   smaller than the size threshold are replaced with the value of their
+   largest neighbouring region, following the chain of largest neighbours
+   until a region at least as large as the threshold is reached.
+   The raster is processed in tiles, in two passes over the source:
+
+   1. Tiles are read and labeled on worker threads (region_label.h). For each
+      tile the size, value and first pixel of its regions, and the pairs of
+      adjacent regions are kept, together with the tile edges. On the main
+      thread, regions continuing across seams are connected with
+      TileSeamMerger_ as tiles are added, which also records the regions that
+      touch across a seam. Once all tiles are done, the sizes of the pieces
+      of each region are summed, the largest neighbour of each region is
+      found, and the replacement value of each small region is resolved.
+
+   2. Tiles are read and labeled again on worker threads (labeling is
+      deterministic, so the labels are those of the first pass), the small
+      regions are replaced, and the output is written on the main thread.
+
+   Memory use is proportional to the tile size times the number of threads,
+   plus about 50 bytes per region of the raster and 16 bytes per pair of
+   adjacent regions, counted once in each tile and seam where the two regions
+   touch. The pairs are held until the end of the first pass, and number a
+   few per region for typical rasters.
+
+   The result is the same as GDALSieveFilter() except for ties between
+   neighbours of the same size. GDALSieveFilter() resolves them by the order
+   in which it finds the neighbours, while here the neighbour whose first
+   pixel comes first in raster scan order is used, so the output does not
+   depend on the tile size.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+
+#include <Rcpp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gdalraster.h"
+#include "rcpp_util.h"
+#include "region_label.h"
+#include "thread_util.h"
+
+struct SieveTile_ {
+    int xoff {0};
+    int yoff {0};
+    int xsize {0};
+    int ysize {0};
+    // pixel values and mask, set on the main thread when re-read in place
+    std::vector<double> values {};
+    std::vector<unsigned char> valid {};
+    // regions by local label - 1
+    std::vector<int64_t> size {};
+    std::vector<double> value {};
+    std::vector<int64_t> first {};
+    std::vector<std::pair<int32_t, int32_t>> adjacent {};
+    TileEdges_ edges {};
+    // output of the second pass
+    std::vector<double> out {};
+};
+
+// Reads the tile values, rounded to integer as by GDALSieveFilter(), and the
+// mask. NaN pixels are invalid.
+static CPLErr read_sieve_tile_(GDALRasterBandH hBand,
+                               GDALRasterBandH hMaskBand, SieveTile_ *tile) {
+
+    const std::size_t num_pixels =
+        static_cast<std::size_t>(tile->xsize) * tile->ysize;
+    tile->values.resize(num_pixels);
+    tile->valid.assign(num_pixels, 1);
+
+    CPLErr err = GDALRasterIO(hBand, GF_Read, tile->xoff, tile->yoff,
+                              tile->xsize, tile->ysize, tile->values.data(),
+                              tile->xsize, tile->ysize, GDT_Float64, 0, 0);
+
+    if (err == CE_None && hMaskBand != nullptr) {
+        std::vector<double> mask_values(num_pixels);
+        err = GDALRasterIO(hMaskBand, GF_Read, tile->xoff, tile->yoff,
+                           tile->xsize, tile->ysize, mask_values.data(),
+                           tile->xsize, tile->ysize, GDT_Float64, 0, 0);
+        for (std::size_t i = 0; i < num_pixels; ++i)
+            tile->valid[i] = (mask_values[i] != 0) ? 1 : 0;
+    }
+
+    for (std::size_t i = 0; i < num_pixels; ++i) {
+        if (std::isnan(tile->values[i]))
+            tile->valid[i] = 0;
+        else
+            tile->values[i] = std::round(tile->values[i]);
+    }
+    return err;
+}
+
+bool sieve_filter_tiles_(const Rcpp::CharacterVector &src_filename,
+                         int src_band,
+                         const Rcpp::CharacterVector &dst_filename,
+                         int dst_band, int size_threshold, int connectedness,
+                         const Rcpp::CharacterVector &mask_filename,
+                         int mask_band, const Rcpp::IntegerVector &tile_size,
+                         int num_threads, bool quiet) {
+
+    if (tile_size.size() != 2 || tile_size[0] < 1 || tile_size[1] < 1)
+        Rcpp::stop("'tile_size' must contain two values > 0");
+    if (static_cast<double>(tile_size[0]) * tile_size[1] > INT32_MAX)
+        Rcpp::stop("'tile_size' is too large");
+
+    const std::string src_filename_in =
+        Rcpp::as<std::string>(check_gdal_filename(src_filename));
+    const std::string dst_filename_in =
+        Rcpp::as<std::string>(check_gdal_filename(dst_filename));
+    const std::string mask_file_in =
+        Rcpp::as<std::string>(check_gdal_filename(mask_filename));
+
+    const bool in_place =
+        (src_filename_in == dst_filename_in && src_band == dst_band);
+
+    std::unique_ptr<GDALRaster> src_ds = std::make_unique<GDALRaster>(
+        src_filename, true, R_NilValue, false, R_NilValue);
+    GDALDatasetH hSrcDS = src_ds->getGDALDatasetH_();
+    if (GDALGetRasterBand(hSrcDS, src_band) == nullptr)
+        Rcpp::stop("failed to access the source band");
+
+    const int nx = GDALGetRasterXSize(hSrcDS);
+    const int ny = GDALGetRasterYSize(hSrcDS);
+
+    std::unique_ptr<GDALRaster> mask_ds = nullptr;
+    if (mask_file_in != "") {
+        mask_ds = std::make_unique<GDALRaster>(mask_filename, true,
+                                               R_NilValue, false, R_NilValue);
+        GDALDatasetH hMaskDS = mask_ds->getGDALDatasetH_();
+        if (GDALGetRasterBand(hMaskDS, mask_band) == nullptr)
+            Rcpp::stop("failed to access the mask band");
+        if (GDALGetRasterXSize(hMaskDS) != nx ||
+                GDALGetRasterYSize(hMaskDS) != ny) {
+            Rcpp::stop("the mask raster must have the same dimensions as "
+                       "the source raster");
+        }
+    }
+
+    GDALRaster dst_ds(dst_filename, false, R_NilValue, false, R_NilValue);
+    GDALDatasetH hDstDS = dst_ds.getGDALDatasetH_();
+    GDALRasterBandH hDstBand = GDALGetRasterBand(hDstDS, dst_band);
+    if (hDstBand == nullptr)
+        Rcpp::stop("failed to access the destination band");
+    if (GDALGetRasterXSize(hDstDS) != nx || GDALGetRasterYSize(hDstDS) != ny) {
+        Rcpp::stop("the destination raster must have the same dimensions as "
+                   "the source raster");
+    }
+
+    // tile grid
+    const int ntx = (nx + tile_size[0] - 1) / tile_size[0];
+    const int nty = (ny + tile_size[1] - 1) / tile_size[1];
+    const std::size_t num_tiles = static_cast<std::size_t>(ntx) * nty;
+
+    int nthreads = resolve_num_threads_(num_threads, num_tiles);
+    std::unique_ptr<WorkerDatasets_> worker_src = nullptr;
+    std::unique_ptr<WorkerDatasets_> worker_mask = nullptr;
+    if (nthreads > 1) {
+        worker_src = std::make_unique<WorkerDatasets_>(src_ds.get(),
+                                                       nthreads);
+        if (mask_ds) {
+            worker_mask = std::make_unique<WorkerDatasets_>(mask_ds.get(),
+                                                            nthreads);
+        }
+        if (worker_src->empty() || (worker_mask && worker_mask->empty())) {
+            if (!quiet)
+                cli_alert_info_("the raster cannot be reopened for "
+                                "multi-threaded read, using one thread");
+            nthreads = 1;
+        }
+    }
+
+    auto get_bands = [&](int thread_idx) {
+        GDALDatasetH hDS = nthreads > 1 ? worker_src->get(thread_idx)
+                                        : src_ds->getGDALDatasetH_();
+        GDALRasterBandH hMaskBand = nullptr;
+        if (mask_ds) {
+            GDALDatasetH hMaskDS = nthreads > 1 ? worker_mask->get(thread_idx)
+                                                : mask_ds->getGDALDatasetH_();
+            hMaskBand = GDALGetRasterBand(hMaskDS, mask_band);
+        }
+        return std::make_pair(GDALGetRasterBand(hDS, src_band), hMaskBand);
+    };
+
+    auto make_batch = [&](std::size_t batch_start, std::size_t batch_size) {
+        std::vector<SieveTile_> batch(batch_size);
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const std::size_t t = batch_start + i;
+            batch[i].xoff = static_cast<int>(t % ntx) * tile_size[0];
+            batch[i].yoff = static_cast<int>(t / ntx) * tile_size[1];
+            batch[i].xsize = std::min(tile_size[0], nx - batch[i].xoff);
+            batch[i].ysize = std::min(tile_size[1], ny - batch[i].yoff);
+        }
+        return batch;
+    };
+
+    const bool eight = (connectedness == 8);
+
+    // first pass, runs on worker threads: must not call into R
+    auto census_tile = [&](SieveTile_ *tile, int thread_idx) {
+        auto bands = get_bands(thread_idx);
+        if (read_sieve_tile_(bands.first, bands.second, tile) != CE_None) {
+            throw std::runtime_error(std::string("read raster failed: ") +
+                                     CPLGetLastErrorMsg());
+        }
+
+        const int xs = tile->xsize;
+        const int ys = tile->ysize;
+        std::vector<int32_t> labels(static_cast<std::size_t>(xs) * ys);
+        const int32_t n = label_regions_(tile->values.data(),
+                                         tile->valid.data(), xs, ys,
+                                         connectedness, labels.data());
+
+        tile->size.assign(n, 0);
+        tile->value.assign(n, 0);
+        tile->first.assign(n, -1);
+        for (int y = 0; y < ys; ++y) {
+            for (int x = 0; x < xs; ++x) {
+                const std::size_t i = static_cast<std::size_t>(y) * xs + x;
+                const int32_t a = labels[i];
+                if (a == 0)
+                    continue;
+                tile->size[a - 1] += 1;
+                if (tile->first[a - 1] < 0) {
+                    tile->value[a - 1] = tile->values[i];
+                    tile->first[a - 1] =
+                        static_cast<int64_t>(tile->yoff + y) * nx +
+                        tile->xoff + x;
+                }
+
+                auto add_pair = [&](std::size_t j) {
+                    const int32_t b = labels[j];
+                    if (b != 0 && b != a)
+                        tile->adjacent.emplace_back(std::min(a, b),
+                                                    std::max(a, b));
+                };
+                if (x < xs - 1)
+                    add_pair(i + 1);
+                if (y < ys - 1) {
+                    add_pair(i + xs);
+                    if (eight && x > 0)
+                        add_pair(i + xs - 1);
+                    if (eight && x < xs - 1)
+                        add_pair(i + xs + 1);
+                }
+            }
+        }
+        std::sort(tile->adjacent.begin(), tile->adjacent.end());
+        tile->adjacent.erase(std::unique(tile->adjacent.begin(),
+                                         tile->adjacent.end()),
+                             tile->adjacent.end());
+
+        tile->edges = tile_edges_(tile->values.data(), labels.data(),
+                                  tile->xoff, tile->yoff, xs, ys);
+        tile->values.clear();
+        tile->values.shrink_to_fit();
+        tile->valid.clear();
+        tile->valid.shrink_to_fit();
+    };
+
+    if (!quiet) {
+        cli_alert_info_("sieving " + std::to_string(num_tiles) +
+                        " tile(s) using " + std::to_string(nthreads) +
+                        " thread(s)...");
+        GDALTermProgressR(0.0, nullptr, nullptr);
+    }
+
+    // regions by global index: tile_base[t] + local label - 1
+    std::vector<int64_t> tile_base(num_tiles + 1, 0);
+    std::vector<int64_t> region_size;
+    std::vector<double> region_value;
+    std::vector<int64_t> region_first;
+    std::vector<std::pair<int64_t, int64_t>> adjacent;
+    TileSeamMerger_ merger(ntx, connectedness, true);
+
+    auto key_to_index = [&](uint64_t key) {
+        return tile_base[region_key_tile_(key)] + region_key_label_(key) - 1;
+    };
+
+    for (std::size_t batch_start = 0; batch_start < num_tiles;
+            batch_start += nthreads) {
+
+        const std::size_t batch_size =
+            std::min(static_cast<std::size_t>(nthreads),
+                     num_tiles - batch_start);
+        std::vector<SieveTile_> batch = make_batch(batch_start, batch_size);
+
+        try {
+            parallel_for_(batch_size, std::min(nthreads,
+                                               static_cast<int>(batch_size)),
+                [&](std::size_t i, int thread_idx) {
+                    census_tile(&batch[i], thread_idx);
+                });
+        }
+        catch (const std::exception &e) {
+            Rcpp::stop(e.what());
+        }
+
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const std::size_t t = batch_start + i;
+            SieveTile_ &tile = batch[i];
+            const int64_t base = tile_base[t];
+            tile_base[t + 1] = base + static_cast<int64_t>(tile.size.size());
+            region_size.insert(region_size.end(), tile.size.begin(),
+                               tile.size.end());
+            region_value.insert(region_value.end(), tile.value.begin(),
+                                tile.value.end());
+            region_first.insert(region_first.end(), tile.first.begin(),
+                                tile.first.end());
+            for (const auto &p : tile.adjacent)
+                adjacent.emplace_back(base + p.first - 1, base + p.second - 1);
+
+            merger.add(t, std::move(tile.edges));
+            for (const auto &p : merger.take_adjacent())
+                adjacent.emplace_back(key_to_index(p.first),
+                                      key_to_index(p.second));
+        }
+
+        if (!quiet) {
+            GDALTermProgressR(
+                0.5 * static_cast<double>(batch_start + batch_size) /
+                num_tiles, nullptr, nullptr);
+        }
+        Rcpp::checkUserInterrupt();
+    }
+
+    // representative of each region continued across seams, with the total
+    // size and first pixel kept at the representative
+    const int64_t num_regions = tile_base[num_tiles];
+    std::vector<int64_t> root(num_regions);
+    for (std::size_t t = 0; t < num_tiles; ++t) {
+        for (int64_t g = tile_base[t]; g < tile_base[t + 1]; ++g) {
+            const int32_t label = static_cast<int32_t>(g - tile_base[t] + 1);
+            root[g] = key_to_index(merger.uf().find(region_key_(t, label)));
+        }
+    }
+    for (int64_t g = 0; g < num_regions; ++g) {
+        const int64_t r = root[g];
+        if (r == g)
+            continue;
+        region_size[r] += region_size[g];
+        region_first[r] = std::min(region_first[r], region_first[g]);
+    }
+
+    // largest neighbour of each region
+    std::vector<int64_t> big(num_regions, -1);
+    auto compare_neighbour = [&](int64_t r, int64_t c) {
+        const int64_t cur = big[r];
+        if (cur < 0 || region_size[c] > region_size[cur] ||
+                (region_size[c] == region_size[cur] &&
+                 region_first[c] < region_first[cur])) {
+            big[r] = c;
+        }
+    };
+    for (const auto &p : adjacent) {
+        const int64_t ra = root[p.first];
+        const int64_t rb = root[p.second];
+        if (ra == rb)
+            continue;
+        compare_neighbour(ra, rb);
+        compare_neighbour(rb, ra);
+    }
+    adjacent.clear();
+    adjacent.shrink_to_fit();
+
+    // replacement region of each small region, -1 if none
+    std::vector<int64_t> target(num_regions, -1);
+    int64_t num_merged = 0;
+    std::vector<int64_t> visited;
+    for (int64_t r = 0; r < num_regions; ++r) {
+        if (root[r] != r || region_size[r] >= size_threshold)
+            continue;
+        visited.assign(1, r);
+        int64_t f = r;
+        while (true) {
+            f = big[f];
+            if (f < 0)
+                break;
+            if (region_size[f] >= size_threshold) {
+                target[r] = f;
+                num_merged += 1;
+                break;
+            }
+            if (std::find(visited.begin(), visited.end(), f) !=
+                    visited.end()) {
+                break;
+            }
+            visited.push_back(f);
+        }
+    }
+    big.clear();
+    big.shrink_to_fit();
+
+    // second pass
+    if (in_place) {
+        // re-read on the main thread from the updated dataset
+        worker_src.reset();
+        src_ds->close();
+    }
+
+    // runs on worker threads: must not call into R
+    auto sieve_tile = [&](SieveTile_ *tile, std::size_t t, int thread_idx) {
+        if (!in_place) {
+            auto bands = get_bands(thread_idx);
+            if (read_sieve_tile_(bands.first, bands.second, tile) !=
+                    CE_None) {
+                throw std::runtime_error(std::string("read raster failed: ")
+                                         + CPLGetLastErrorMsg());
+            }
+        }
+
+        const std::size_t num_pixels =
+            static_cast<std::size_t>(tile->xsize) * tile->ysize;
+        std::vector<int32_t> labels(num_pixels);
+        label_regions_(tile->values.data(), tile->valid.data(), tile->xsize,
+                       tile->ysize, connectedness, labels.data());
+
+        tile->out = std::move(tile->values);
+        for (std::size_t i = 0; i < num_pixels; ++i) {
+            if (labels[i] == 0)
+                continue;
+            const int64_t r = root[tile_base[t] + labels[i] - 1];
+            if (target[r] >= 0)
+                tile->out[i] = region_value[target[r]];
+        }
+    };
+
+    for (std::size_t batch_start = 0; batch_start < num_tiles;
+            batch_start += nthreads) {
+
+        const std::size_t batch_size =
+            std::min(static_cast<std::size_t>(nthreads),
+                     num_tiles - batch_start);
+        std::vector<SieveTile_> batch = make_batch(batch_start, batch_size);
+
+        if (in_place) {
+            GDALRasterBandH hMaskBand = nullptr;
+            if (mask_ds) {
+                hMaskBand = GDALGetRasterBand(mask_ds->getGDALDatasetH_(),
+                                              mask_band);
+            }
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                if (read_sieve_tile_(hDstBand, hMaskBand, &batch[i]) !=
+                        CE_None) {
+                    Rcpp::stop("read raster failed");
+                }
+            }
+        }
+
+        try {
+            parallel_for_(batch_size, std::min(nthreads,
+                                               static_cast<int>(batch_size)),
+                [&](std::size_t i, int thread_idx) {
+                    sieve_tile(&batch[i], batch_start + i, thread_idx);
+                });
+        }
+        catch (const std::exception &e) {
+            Rcpp::stop(e.what());
+        }
+
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const SieveTile_ &tile = batch[i];
+            if (GDALRasterIO(hDstBand, GF_Write, tile.xoff, tile.yoff,
+                             tile.xsize, tile.ysize,
+                             const_cast<double *>(tile.out.data()),
+                             tile.xsize, tile.ysize, GDT_Float64, 0, 0)
+                    != CE_None) {
+                Rcpp::stop("write to the destination raster failed");
+            }
+        }
+
+        if (!quiet) {
+            GDALTermProgressR(
+                0.5 + 0.5 * static_cast<double>(batch_start + batch_size) /
+                num_tiles, nullptr, nullptr);
+        }
+        Rcpp::checkUserInterrupt();
+    }
+
+    dst_ds.close();
+
+    if (!quiet) {
+        cli_alert_info_(std::to_string(num_merged) +
+                        " region(s) merged into a neighbour");
+    }
+
+    return true;
+}
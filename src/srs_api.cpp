@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "srs_api.h"
+#include "srs_cache.h"
 #include "transform.h"
 
 using std::string_literals::operator""s;
@@ -153,15 +154,12 @@ std::string srs_to_wkt(const std::string &srs, bool pretty = false,
     if (srs == "")
         return "";
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
     OGRSpatialReferenceH hSRS_out = nullptr;
     char *pszSRS_WKT = nullptr;
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     if (gcs_only)
         hSRS_out = OSRCloneGeogCS(hSRS);
@@ -209,13 +207,10 @@ std::string srs_to_projjson(const std::string &srs,
     if (!(proj_ver[0] > 6 || proj_ver[1] >= 2))
         Rcpp::stop("srs_to_projjson() requires PROJ >= 6.2");
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     std::vector<const char *> opt_list;
     if (!multiline) {
@@ -484,13 +479,10 @@ std::string srs_get_name(const std::string &srs) {
     if (srs == "")
         return "";
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     const char *pszName = OSRGetName(hSRS);
     std::string ret = "";
@@ -507,13 +499,10 @@ SEXP srs_find_epsg(const std::string &srs, bool all_matches = false) {
     if (srs == "")
         return R_NilValue;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     std::unique_ptr<OGRSpatialReferenceH> pahSRS;
     int nEntries = 0;
@@ -577,13 +566,10 @@ bool srs_is_geographic(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSRIsGeographic(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -596,13 +582,10 @@ bool srs_is_derived_gcs(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSRIsDerivedGeographic(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -615,13 +598,10 @@ bool srs_is_local(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSRIsLocal(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -634,13 +614,10 @@ bool srs_is_projected(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSRIsProjected(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -653,13 +630,10 @@ bool srs_is_compound(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSRIsCompound(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -672,13 +646,10 @@ bool srs_is_geocentric(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSRIsGeocentric(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -691,13 +662,10 @@ bool srs_is_vertical(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSRIsVertical(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -715,13 +683,10 @@ bool srs_is_dynamic(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSRIsDynamic(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -739,19 +704,13 @@ bool srs_is_same(const std::string &srs, const std::string &srs_other,
     if (srs == "" || srs_other == "")
         return false;
 
-    OGRSpatialReferenceH hSRS1 = OSRNewSpatialReference(nullptr);
-    if (OSRSetFromUserInput(hSRS1, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS1 != nullptr)
-            OSRDestroySpatialReference(hSRS1);
+    OGRSpatialReferenceH hSRS1 = SRSCache_::instance().get(srs);
+    if (hSRS1 == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
-    OGRSpatialReferenceH hSRS2 = OSRNewSpatialReference(nullptr);
-    if (OSRSetFromUserInput(hSRS2, srs_other.c_str()) != OGRERR_NONE) {
-        if (hSRS2 != nullptr) {
-            OSRDestroySpatialReference(hSRS1);
-            OSRDestroySpatialReference(hSRS2);
-        }
+    OGRSpatialReferenceH hSRS2 = SRSCache_::instance().get(srs_other);
+    if (hSRS2 == nullptr) {
+        OSRDestroySpatialReference(hSRS1);
         Rcpp::stop("error importing SRS from user input");
     }
 
@@ -794,13 +753,10 @@ SEXP srs_get_angular_units(const std::string &srs) {
     if (srs == "")
         return R_NilValue;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     char *pszNameTmp = nullptr;
     double to_rad = OSRGetAngularUnits(hSRS, &pszNameTmp);
@@ -820,13 +776,10 @@ SEXP srs_get_linear_units(const std::string &srs) {
     if (srs == "")
         return R_NilValue;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     char *pszNameTmp = nullptr;
     double to_m = OSRGetLinearUnits(hSRS, &pszNameTmp);
@@ -851,13 +804,10 @@ double srs_get_coord_epoch(const std::string &srs) {
     if (srs == "")
         return 0.0;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     double ret = OSRGetCoordinateEpoch(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -871,13 +821,10 @@ int srs_get_utm_zone(const std::string &srs) {
     if (srs == "")
         return 0;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     int bNorth = 0;
     int utm_zone = OSRGetUTMZone(hSRS, &bNorth);
@@ -894,13 +841,10 @@ std::string srs_get_axis_mapping_strategy(const std::string &srs) {
     if (srs == "")
         return "";
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     OSRAxisMappingStrategy eOAMS = OSRGetAxisMappingStrategy(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -920,13 +864,10 @@ SEXP srs_get_area_of_use(const std::string &srs) {
     if (srs == "")
         return R_NilValue;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     double dfWestLongitudeDeg = NA_REAL;
     double dfSouthLatitudeDeg = NA_REAL;
@@ -975,13 +916,10 @@ int srs_get_axes_count(const std::string &srs) {
     if (srs == "")
         return NA_INTEGER;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     int axes_count = OSRGetAxesCount(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -996,13 +934,10 @@ SEXP srs_get_axes(const std::string &srs,
     if (srs == "")
         return R_NilValue;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     const char *pszTargetKey = nullptr;
     if (target_key.isNotNull()) {
@@ -1076,13 +1011,10 @@ bool srs_epsg_treats_as_lat_long(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSREPSGTreatsAsLatLong(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -1095,13 +1027,10 @@ bool srs_epsg_treats_as_northing_easting(const std::string &srs) {
     if (srs == "")
         return false;
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     bool ret = OSREPSGTreatsAsNorthingEasting(hSRS);
     OSRDestroySpatialReference(hSRS);
@@ -1121,13 +1050,10 @@ std::string srs_get_celestial_body_name(const std::string &srs) {
     if (!(proj_ver[0] > 8 || (proj_ver[0] == 8 && proj_ver[1] >= 1)))
         Rcpp::stop("srs_get_celestial_body_name() requires PROJ >= 8.1");
 
-    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    OGRSpatialReferenceH hSRS = SRSCache_::instance().get(srs);
 
-    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
-        if (hSRS != nullptr)
-            OSRDestroySpatialReference(hSRS);
+    if (hSRS == nullptr)
         Rcpp::stop("error importing SRS from user input");
-    }
 
     const char *pszName = OSRGetCelestialBodyName(hSRS);
     std::string ret = "";
@@ -1139,6 +1065,166 @@ std::string srs_get_celestial_body_name(const std::string &srs) {
 #endif  // GDAL 3.12
 }
 
+//' Query spatial reference systems given as a character vector
+//'
+//' These functions are vectorized versions of some of the [srs_query]
+//' functions, operating on a character vector of spatial reference system
+//' definitions in any of the formats supported by [srs_to_wkt()]. Parsed
+//' definitions are cached (see [srs_cache]), so repeated definitions in the
+//' input are only parsed once.
+//'
+//' @name srs_query_batch
+//'
+//' @details
+//' `srs_query_batch()` returns a data frame with one row per element of `srs`
+//' and the following columns:
+//' * `srs`: the input definition
+//' * `name`: the SRS name (see `srs_get_name()`)
+//' * `authority`: the authority name and code of the SRS in the form
+//' `"EPSG:####"`, if the definition carries one (e.g., `"EPSG:5070"`, or WKT
+//' with an ID node), otherwise `NA` (see `srs_find_epsg()` to search for a
+//' match)
+//' * `is_geographic`, `is_projected`, `is_compound`, `is_geocentric`,
+//' `is_vertical`, `is_local`: as returned by the corresponding `srs_is_*()`
+//' functions
+//' * `utm_zone`: as returned by `srs_get_utm_zone()`
+//'
+//' `srs_is_same_batch()` returns a logical vector, as `srs_is_same()` applied
+//' to each element of `srs` and the corresponding element of `srs_other`.
+//'
+//' Elements that are `NA` or empty strings give `NA` in the output of
+//' `srs_query_batch()` and `FALSE` in the output of `srs_is_same_batch()`.
+//' Elements that cannot be parsed give `NA` (an error is not raised, but the
+//' GDAL error message is emitted).
+//'
+//' @param srs Character vector of SRS definitions.
+//' @param srs_other Character vector of SRS definitions to compare with, of
+//' length `1` or the same length as `srs`.
+//' @param criterion Character string. One of `"STRICT"`, `"EQUIVALENT"` or
+//' `"EQUIVALENT_EXCEPT_AXIS_ORDER_GEOGCRS"`, as for `srs_is_same()`. The
+//' default empty string uses `"EQUIVALENT_EXCEPT_AXIS_ORDER_GEOGCRS"`.
+//' @param ignore_axis_mapping Logical scalar, as for `srs_is_same()`.
+//' Defaults to `FALSE`.
+//' @param ignore_coord_epoch Logical scalar, as for `srs_is_same()`.
+//' Defaults to `FALSE`.
+//' @returns
+//' `srs_query_batch()` returns a data frame, and `srs_is_same_batch()` returns
+//' a logical vector of `length(srs)`.
+//'
+//' @seealso
+//' [srs_cache], [srs_query]
+//'
+//' @examples
+//' srs <- c("EPSG:4326", "EPSG:5070", "EPSG:26912", "EPSG:5070")
+//' srs_query_batch(srs)
+//'
+//' srs_is_same_batch(srs, "EPSG:5070")
+// [[Rcpp::export]]
+Rcpp::DataFrame srs_query_batch(const Rcpp::CharacterVector &srs) {
+    const R_xlen_t n = srs.size();
+    Rcpp::CharacterVector name_out(n, NA_STRING);
+    Rcpp::CharacterVector authority_out(n, NA_STRING);
+    Rcpp::LogicalVector is_geographic_out(n, NA_LOGICAL);
+    Rcpp::LogicalVector is_projected_out(n, NA_LOGICAL);
+    Rcpp::LogicalVector is_compound_out(n, NA_LOGICAL);
+    Rcpp::LogicalVector is_geocentric_out(n, NA_LOGICAL);
+    Rcpp::LogicalVector is_vertical_out(n, NA_LOGICAL);
+    Rcpp::LogicalVector is_local_out(n, NA_LOGICAL);
+    Rcpp::IntegerVector utm_zone_out(n, NA_INTEGER);
+
+    for (R_xlen_t i = 0; i < n; ++i) {
+        if (Rcpp::CharacterVector::is_na(srs[i]) || srs[i] == "")
+            continue;
+
+        OGRSpatialReferenceH hSRS =
+            SRSCache_::instance().get(Rcpp::as<std::string>(srs[i]));
+        if (hSRS == nullptr)
+            continue;
+
+        const char *pszName = OSRGetName(hSRS);
+        name_out[i] = pszName ? pszName : "";
+        const char *pszAuthName = OSRGetAuthorityName(hSRS, nullptr);
+        const char *pszAuthCode = OSRGetAuthorityCode(hSRS, nullptr);
+        if (pszAuthName && pszAuthCode)
+            authority_out[i] = std::string(pszAuthName) + ":" + pszAuthCode;
+        is_geographic_out[i] = OSRIsGeographic(hSRS) ? TRUE : FALSE;
+        is_projected_out[i] = OSRIsProjected(hSRS) ? TRUE : FALSE;
+        is_compound_out[i] = OSRIsCompound(hSRS) ? TRUE : FALSE;
+        is_geocentric_out[i] = OSRIsGeocentric(hSRS) ? TRUE : FALSE;
+        is_vertical_out[i] = OSRIsVertical(hSRS) ? TRUE : FALSE;
+        is_local_out[i] = OSRIsLocal(hSRS) ? TRUE : FALSE;
+        int bNorth = 0;
+        const int utm_zone = OSRGetUTMZone(hSRS, &bNorth);
+        utm_zone_out[i] = bNorth ? utm_zone : -utm_zone;
+
+        OSRDestroySpatialReference(hSRS);
+    }
+
+    return Rcpp::DataFrame::create(
+        Rcpp::Named("srs") = srs,
+        Rcpp::Named("name") = name_out,
+        Rcpp::Named("authority") = authority_out,
+        Rcpp::Named("is_geographic") = is_geographic_out,
+        Rcpp::Named("is_projected") = is_projected_out,
+        Rcpp::Named("is_compound") = is_compound_out,
+        Rcpp::Named("is_geocentric") = is_geocentric_out,
+        Rcpp::Named("is_vertical") = is_vertical_out,
+        Rcpp::Named("is_local") = is_local_out,
+        Rcpp::Named("utm_zone") = utm_zone_out);
+}
+
+//' @rdname srs_query_batch
+// [[Rcpp::export]]
+Rcpp::LogicalVector srs_is_same_batch(const Rcpp::CharacterVector &srs,
+                                      const Rcpp::CharacterVector &srs_other,
+                                      std::string criterion = "",
+                                      bool ignore_axis_mapping = false,
+                                      bool ignore_coord_epoch = false) {
+
+    const R_xlen_t n = srs.size();
+    if (srs_other.size() != 1 && srs_other.size() != n)
+        Rcpp::stop("'srs_other' must have length 1 or the same length as 'srs'");
+
+    std::vector<const char *> opt_list;
+    if (criterion != "") {
+        criterion = "CRITERION=" + criterion;
+        opt_list.push_back(criterion.c_str());
+    }
+    opt_list.push_back(ignore_axis_mapping ?
+                       "IGNORE_DATA_AXIS_TO_SRS_AXIS_MAPPING=YES" :
+                       "IGNORE_DATA_AXIS_TO_SRS_AXIS_MAPPING=NO");
+    opt_list.push_back(ignore_coord_epoch ? "IGNORE_COORDINATE_EPOCH=YES" :
+                                            "IGNORE_COORDINATE_EPOCH=NO");
+    opt_list.push_back(nullptr);
+
+    Rcpp::LogicalVector out(n, FALSE);
+    for (R_xlen_t i = 0; i < n; ++i) {
+        const R_xlen_t j = srs_other.size() == 1 ? 0 : i;
+        if (Rcpp::CharacterVector::is_na(srs[i]) || srs[i] == "" ||
+                Rcpp::CharacterVector::is_na(srs_other[j]) ||
+                srs_other[j] == "") {
+            continue;
+        }
+
+        OGRSpatialReferenceH hSRS1 =
+            SRSCache_::instance().get(Rcpp::as<std::string>(srs[i]));
+        OGRSpatialReferenceH hSRS2 =
+            SRSCache_::instance().get(Rcpp::as<std::string>(srs_other[j]));
+        if (hSRS1 == nullptr || hSRS2 == nullptr) {
+            out[i] = NA_LOGICAL;
+        }
+        else {
+            out[i] = OSRIsSameEx(hSRS1, hSRS2, opt_list.data()) ? TRUE
+                                                                : FALSE;
+        }
+        if (hSRS1 != nullptr)
+            OSRDestroySpatialReference(hSRS1);
+        if (hSRS2 != nullptr)
+            OSRDestroySpatialReference(hSRS2);
+    }
+    return out;
+}
+
 //' Obtain information about coordinate reference systems in the PROJ DB
 //'
 //' `srs_info_from_db()` returns a data frame containing descriptive information
@@ -43,6 +43,13 @@ bool srs_epsg_treats_as_lat_long(const std::string &srs);
 bool srs_epsg_treats_as_northing_easting(const std::string &srs);
 std::string srs_get_celestial_body_name(const std::string &srs);
 
+Rcpp::DataFrame srs_query_batch(const Rcpp::CharacterVector &srs);
+Rcpp::LogicalVector srs_is_same_batch(const Rcpp::CharacterVector &srs,
+                                      const Rcpp::CharacterVector &srs_other,
+                                      std::string criterion,
+                                      bool ignore_axis_mapping,
+                                      bool ignore_coord_epoch);
+
 Rcpp::DataFrame srs_info_from_db(const std::string &auth_name);
 
 #endif  // SRS_API_H_
@@ -0,0 +1,156 @@
+/* Process-wide cache of spatial reference systems parsed from user input
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include "srs_cache.h"
+
+#include <ogr_srs_api.h>
+
+#include <Rcpp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+SRSCache_ &SRSCache_::instance() {
+    // never destroyed, SRS objects are released by clear() at package unload
+    static SRSCache_ *cache = new SRSCache_();
+    return *cache;
+}
+
+void SRSCache_::trim_() {
+    while (m_entries.size() > m_max_size) {
+        Entry_ &entry = m_entries.back();
+        OSRDestroySpatialReference(entry.hSRS);
+        m_index.erase(entry.key);
+        m_entries.pop_back();
+    }
+}
+
+OGRSpatialReferenceH SRSCache_::get(const std::string &srs) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(srs);
+        if (it != m_index.end()) {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            m_hits += 1;
+            return OSRClone(it->second->hSRS);
+        }
+        m_misses += 1;
+    }
+
+    // parse without the lock held
+    OGRSpatialReferenceH hSRS = OSRNewSpatialReference(nullptr);
+    if (hSRS == nullptr)
+        return nullptr;
+    if (OSRSetFromUserInput(hSRS, srs.c_str()) != OGRERR_NONE) {
+        OSRDestroySpatialReference(hSRS);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_max_size > 0 && m_index.find(srs) == m_index.end()) {
+        Entry_ entry;
+        entry.key = srs;
+        entry.hSRS = OSRClone(hSRS);
+        if (entry.hSRS != nullptr) {
+            m_entries.push_front(std::move(entry));
+            m_index[srs] = m_entries.begin();
+            trim_();
+        }
+    }
+    return hSRS;
+}
+
+void SRSCache_::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Entry_ &entry : m_entries)
+        OSRDestroySpatialReference(entry.hSRS);
+    m_entries.clear();
+    m_index.clear();
+}
+
+void SRSCache_::setMaxSize(std::size_t max_size) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_size = max_size;
+    trim_();
+}
+
+SRSCacheStats_ SRSCache_::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SRSCacheStats_ s;
+    s.size = m_entries.size();
+    s.max_size = m_max_size;
+    s.hits = m_hits;
+    s.misses = m_misses;
+    return s;
+}
+
+
+//' Manage the cache of parsed spatial reference systems
+//'
+//' The `srs_*()` functions that take an SRS definition as text (see
+//' [srs_query], [srs_convert], [srs_query_batch()]) keep the parsed spatial
+//' reference systems in a cache for the R session, so that repeated calls with
+//' the same definition do not parse it again. Parsing can require a lookup in
+//' the PROJ database (e.g., for `"EPSG:####"` codes or CRS names). These
+//' functions return information about the cache, set its capacity and clear
+//' it.
+//'
+//' @name srs_cache
+//'
+//' @details
+//' Cached SRS are keyed by the exact text of the definition, so for example
+//' `"EPSG:4326"` and `"epsg:4326"` are separate entries. Definitions that
+//' fail to parse are not cached.
+//'
+//' `srs_cache_info()` returns information about the cache.
+//'
+//' `srs_cache_set_size()` sets the maximum number of SRS kept in the cache
+//' (`256` by default). The least recently used entries beyond this number are
+//' discarded. A size of `0` disables caching.
+//'
+//' `srs_cache_clear()` empties the cache. This should be called after
+//' changing PROJ settings that affect how definitions are resolved (e.g., the
+//' PROJ search paths or database), since cached results are not refreshed
+//' otherwise.
+//'
+//' @param max_size Integer maximum number of SRS kept in the cache.
+//' @returns
+//' `srs_cache_info()` returns a list with elements `size` (number of cached
+//' SRS), `max_size` (the cache capacity), `hits` (number of lookups served
+//' from the cache) and `misses` (number of lookups that parsed the
+//' definition).
+//'
+//' `srs_cache_set_size()` and `srs_cache_clear()` return `NULL` invisibly.
+//'
+//' @examples
+//' srs_cache_clear()
+//' for (i in 1:10)
+//'   srs_is_projected("EPSG:5070")
+//' srs_cache_info()
+// [[Rcpp::export]]
+Rcpp::List srs_cache_info() {
+    const SRSCacheStats_ s = SRSCache_::instance().stats();
+    return Rcpp::List::create(
+        Rcpp::Named("size") = static_cast<double>(s.size),
+        Rcpp::Named("max_size") = static_cast<double>(s.max_size),
+        Rcpp::Named("hits") = static_cast<double>(s.hits),
+        Rcpp::Named("misses") = static_cast<double>(s.misses));
+}
+
+//' @rdname srs_cache
+// [[Rcpp::export(invisible = true)]]
+void srs_cache_set_size(int max_size) {
+    if (max_size == NA_INTEGER || max_size < 0)
+        Rcpp::stop("'max_size' must be a single value >= 0");
+    SRSCache_::instance().setMaxSize(static_cast<std::size_t>(max_size));
+}
+
+//' @rdname srs_cache
+// [[Rcpp::export(invisible = true)]]
+void srs_cache_clear() {
+    SRSCache_::instance().clear();
+}
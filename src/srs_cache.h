@@ -0,0 +1,70 @@
+/* Process-wide cache of spatial reference systems parsed from user input
+
+   OSRSetFromUserInput() often requires a lookup in the PROJ database (e.g.,
+   for "EPSG:####" or a CRS name), which dominates the cost of the srs_*()
+   functions when they are called many times on a small number of distinct
+   SRS definitions. SRSCache_ keeps the parsed OGRSpatialReference objects
+   keyed by the exact user input string, and hands out clones of them, so
+   that callers own (and may modify) the returned object as before. Cloning
+   does not involve a database lookup. The least recently used entries beyond
+   the cache capacity are destroyed. Input that fails to parse is not cached.
+   Cache operations are guarded by a mutex.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef SRS_CACHE_H_
+#define SRS_CACHE_H_
+
+#include <ogr_srs_api.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct SRSCacheStats_ {
+    std::size_t size = 0;
+    std::size_t max_size = 0;
+    int64_t hits = 0;
+    int64_t misses = 0;
+};
+
+class SRSCache_ {
+ public:
+    static SRSCache_ &instance();
+
+    // Returns a new SRS object for the user input (to be destroyed by the
+    // caller with OSRDestroySpatialReference()), or nullptr if the input
+    // cannot be parsed by OSRSetFromUserInput().
+    OGRSpatialReferenceH get(const std::string &srs);
+
+    void clear();
+    void setMaxSize(std::size_t max_size);
+    SRSCacheStats_ stats() const;
+
+ private:
+    SRSCache_() = default;
+    SRSCache_(const SRSCache_ &) = delete;
+    SRSCache_ &operator=(const SRSCache_ &) = delete;
+
+    struct Entry_ {
+        std::string key {};
+        OGRSpatialReferenceH hSRS {nullptr};
+    };
+
+    void trim_();
+
+    mutable std::mutex m_mutex;
+    // most recently used first
+    std::list<Entry_> m_entries {};
+    std::unordered_map<std::string, std::list<Entry_>::iterator> m_index {};
+    std::size_t m_max_size {256};
+    int64_t m_hits {0};
+    int64_t m_misses {0};
+};
+
+#endif  // SRS_CACHE_H_
@@ -0,0 +1,70 @@
+/* Internal helpers for running native work on a pool of worker threads
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <cpl_conv.h>
+#include <cpl_string.h>
+
+#include <Rcpp.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "thread_util.h"
+#include "dataset_pool.h"
+#include "gdalraster.h"
+
+int resolve_num_threads_(int num_threads, std::size_t num_tasks) {
+    if (num_threads < 1)
+        num_threads = CPLGetNumCPUs();
+
+    if (num_tasks > 0 && static_cast<std::size_t>(num_threads) > num_tasks)
+        num_threads = static_cast<int>(num_tasks);
+
+    return std::max(num_threads, 1);
+}
+
+WorkerDatasets_::WorkerDatasets_(const GDALRaster *ds, int num_handles) {
+    if (ds == nullptr || !ds->isOpen() || num_handles < 1)
+        return;
+
+    GDALDatasetH hDS = ds->getGDALDatasetH_();
+    GDALDriverH hDriver = GDALGetDatasetDriver(hDS);
+    if (hDriver == nullptr || EQUAL(GDALGetDriverShortName(hDriver), "MEM"))
+        return;
+
+    std::string dsn = ds->getFilename();
+    if (dsn.empty())
+        dsn = GDALGetDescription(hDS);
+    if (dsn.empty())
+        return;
+
+    const std::vector<std::string> open_options = ds->getOpenOptions_();
+    const std::string driver = GDALGetDriverShortName(hDriver);
+
+    for (int i = 0; i < num_handles; ++i) {
+        GDALDatasetH hWorkerDS = DatasetPool_::instance().acquire(
+            dsn, true, driver, open_options);
+
+        if (hWorkerDS == nullptr) {
+            // fall back to single-threaded use of the original handle
+            for (GDALDatasetH h : m_handles)
+                DatasetPool_::instance().release(h);
+            m_handles.clear();
+            return;
+        }
+        m_handles.push_back(hWorkerDS);
+    }
+}
+
+WorkerDatasets_::~WorkerDatasets_() {
+    for (GDALDatasetH h : m_handles) {
+        if (h != nullptr)
+            DatasetPool_::instance().release(h);
+    }
+    m_handles.clear();
+}
@@ -0,0 +1,195 @@
+/* Internal helpers for running native work on a pool of worker threads
+
+   The R API is not thread-safe and GDAL dataset handles are not safe for
+   concurrent use. Work functions run by parallel_for_() must therefore not
+   call into R (including Rcpp::stop(), Rcpp::warning() and the cli_*()
+   wrappers), and each worker thread must operate on its own GDAL dataset
+   handle(s). Errors should be signaled by throwing a C++ exception, which is
+   re-thrown on the calling thread.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef THREAD_UTIL_H_
+#define THREAD_UTIL_H_
+
+#include <cpl_conv.h>
+#include <cpl_error.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gdalraster.h"
+
+// Resolve a user-requested number of threads. Values < 1 request all
+// available CPUs. The result is capped at the number of tasks (minimum 1).
+int resolve_num_threads_(int num_threads, std::size_t num_tasks);
+
+// Additional read-only handles on the dataset of a GDALRaster object, for use
+// by worker threads (one per thread). Must be created and destroyed on the
+// main thread. The handle set is empty if the dataset cannot be reopened by
+// name (e.g., a MEM dataset), in which case callers should fall back to
+// single-threaded processing on the original handle. Handles are taken from
+// DatasetPool_ (see dataset_pool.h) and given back there on destruction.
+class WorkerDatasets_ {
+ public:
+    WorkerDatasets_(const GDALRaster *ds, int num_handles);
+    ~WorkerDatasets_();
+    WorkerDatasets_(const WorkerDatasets_ &) = delete;
+    WorkerDatasets_ &operator=(const WorkerDatasets_ &) = delete;
+
+    bool empty() const { return m_handles.empty(); }
+    int size() const { return static_cast<int>(m_handles.size()); }
+    GDALDatasetH get(int i) const { return m_handles[i]; }
+    // transfer ownership of handle i to the caller, who gives it back with
+    // DatasetPool_::instance().release()
+    GDALDatasetH take(int i) {
+        GDALDatasetH h = m_handles[i];
+        m_handles[i] = nullptr;
+        return h;
+    }
+
+ private:
+    std::vector<GDALDatasetH> m_handles {};
+};
+
+// Installs the quiet GDAL error handler on the current thread for the
+// lifetime of the object. The error handler installed at package load calls
+// into R, so it must not be active on worker threads. CPLGetLastErrorMsg()
+// is still available on the thread after a failed GDAL call.
+class QuietErrorHandlerGuard_ {
+ public:
+    QuietErrorHandlerGuard_() { CPLPushErrorHandler(CPLQuietErrorHandler); }
+    ~QuietErrorHandlerGuard_() { CPLPopErrorHandler(); }
+    QuietErrorHandlerGuard_(const QuietErrorHandlerGuard_ &) = delete;
+    QuietErrorHandlerGuard_ &operator=(const QuietErrorHandlerGuard_ &) =
+        delete;
+};
+
+// Sets a thread-local GDAL configuration option for the lifetime of the
+// object, and restores the previous thread-local value (or unsets it) on
+// destruction, also if an exception is thrown.
+class ThreadLocalConfigOptionGuard_ {
+ public:
+    ThreadLocalConfigOptionGuard_(const std::string &key,
+                                  const std::string &value)
+            : m_key(key) {
+        const char *prev = CPLGetThreadLocalConfigOption(key.c_str(),
+                                                         nullptr);
+        m_had_prev = (prev != nullptr);
+        if (m_had_prev)
+            m_prev = prev;
+        CPLSetThreadLocalConfigOption(key.c_str(), value.c_str());
+    }
+    ~ThreadLocalConfigOptionGuard_() {
+        CPLSetThreadLocalConfigOption(m_key.c_str(),
+                                      m_had_prev ? m_prev.c_str() : nullptr);
+    }
+    ThreadLocalConfigOptionGuard_(const ThreadLocalConfigOptionGuard_ &) =
+        delete;
+    ThreadLocalConfigOptionGuard_ &operator=(
+        const ThreadLocalConfigOptionGuard_ &) = delete;
+
+ private:
+    std::string m_key {};
+    std::string m_prev {};
+    bool m_had_prev {false};
+};
+
+// Run fn(task_idx, thread_idx) for each task_idx in [0, num_tasks), on
+// num_threads worker threads which take tasks in order from a shared counter.
+// thread_idx is in [0, num_threads) and can be used to index per-thread
+// resources allocated by the caller. If num_threads <= 1, tasks run on the
+// calling thread. The optional progress function is always called on the
+// calling thread with the fraction of tasks completed.
+template <typename Fn>
+void parallel_for_(std::size_t num_tasks, int num_threads, Fn &&fn,
+                   const std::function<void(double)> &progress = nullptr) {
+
+    if (num_tasks == 0)
+        return;
+
+    if (num_threads <= 1) {
+        for (std::size_t i = 0; i < num_tasks; ++i) {
+            fn(i, 0);
+            if (progress)
+                progress(static_cast<double>(i + 1) / num_tasks);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next_task {0};
+    std::atomic<std::size_t> tasks_done {0};
+    std::atomic<bool> failed {false};
+    std::string err_msg {};
+    std::mutex err_mutex;
+
+    auto set_error = [&](const std::string &msg) {
+        std::lock_guard<std::mutex> lock(err_mutex);
+        if (err_msg.empty())
+            err_msg = msg.empty() ? "error in worker thread" : msg;
+        failed = true;
+    };
+
+    auto worker = [&](int thread_idx) {
+        QuietErrorHandlerGuard_ quiet_errors;
+        while (!failed) {
+            const std::size_t i = next_task.fetch_add(1);
+            if (i >= num_tasks)
+                break;
+            try {
+                fn(i, thread_idx);
+            }
+            catch (const std::exception &e) {
+                set_error(e.what());
+            }
+            catch (...) {
+                set_error("unknown error in worker thread");
+            }
+            tasks_done.fetch_add(1);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    try {
+        for (int t = 0; t < num_threads; ++t)
+            threads.emplace_back(worker, t);
+    }
+    catch (const std::exception &e) {
+        set_error(std::string("failed to start worker threads: ") +
+                  e.what());
+    }
+
+    if (progress) {
+        double last_reported = 0.0;
+        while (!failed && tasks_done < num_tasks) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            const double frac = static_cast<double>(tasks_done) / num_tasks;
+            if (frac > last_reported && frac < 1.0) {
+                progress(frac);
+                last_reported = frac;
+            }
+        }
+    }
+
+    for (auto &th : threads)
+        th.join();
+
+    if (failed)
+        throw std::runtime_error(err_msg);
+
+    if (progress)
+        progress(1.0);
+}
+
+#endif  // THREAD_UTIL_H_
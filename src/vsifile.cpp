@@ -187,6 +187,72 @@ SEXP VSIFile::read(Rcpp::NumericVector nbytes) {
     }
 }
 
+Rcpp::List VSIFile::read_multi_range(Rcpp::NumericVector offsets,
+                                     Rcpp::NumericVector sizes) {
+    if (m_fp == nullptr)
+        Rcpp::stop("the file is not open");
+
+    if (offsets.size() != sizes.size())
+        Rcpp::stop("'offsets' and 'sizes' must have the same length");
+
+    const R_xlen_t num_ranges = offsets.size();
+    const bool offsets_i64 = Rcpp::isInteger64(offsets);
+    const bool sizes_i64 = Rcpp::isInteger64(sizes);
+
+    std::vector<vsi_l_offset> offsets_in;
+    std::vector<size_t> sizes_in;
+    Rcpp::List out(num_ranges);
+    std::vector<void *> buffers;
+    for (R_xlen_t i = 0; i < num_ranges; ++i) {
+        int64_t offset = 0;
+        int64_t size = 0;
+        if (offsets_i64) {
+            offset = Rcpp::fromInteger64(offsets[i]);
+        }
+        else {
+            if (Rcpp::NumericVector::is_na(offsets[i]) ||
+                    offsets[i] > MAX_INT_AS_R_NUMERIC_) {
+                Rcpp::stop("'offsets' given as type double is out of range");
+            }
+            offset = static_cast<int64_t>(offsets[i]);
+        }
+        if (sizes_i64) {
+            size = Rcpp::fromInteger64(sizes[i]);
+        }
+        else {
+            if (Rcpp::NumericVector::is_na(sizes[i]) ||
+                    sizes[i] > MAX_INT_AS_R_NUMERIC_) {
+                Rcpp::stop("'sizes' given as type double is out of range");
+            }
+            size = static_cast<int64_t>(sizes[i]);
+        }
+        if (offset < 0 || size < 0)
+            Rcpp::stop("'offsets' and 'sizes' cannot be negative numbers");
+
+        Rcpp::RawVector raw = Rcpp::no_init(static_cast<R_xlen_t>(size));
+        out[i] = raw;
+        // zero-length ranges are returned as raw(0) and not requested
+        if (size > 0) {
+            offsets_in.push_back(static_cast<vsi_l_offset>(offset));
+            sizes_in.push_back(static_cast<size_t>(size));
+            buffers.push_back(raw.begin());
+        }
+    }
+
+    if (buffers.empty())
+        return out;
+
+    // drivers of network file systems (/vsicurl/, /vsis3/, etc.) coalesce
+    // nearby ranges and may issue the requests in parallel
+    const int ret = VSIFReadMultiRangeL(static_cast<int>(buffers.size()),
+                                        buffers.data(), offsets_in.data(),
+                                        sizes_in.data(), m_fp);
+    if (ret != 0)
+        Rcpp::stop("failed to read the requested ranges");
+
+    return out;
+}
+
 Rcpp::NumericVector VSIFile::write(const Rcpp::RawVector &object) {
     if (m_fp == nullptr)
         Rcpp::stop("the file is not open");
@@ -354,6 +420,8 @@ RCPP_MODULE(mod_VSIFile) {
         "Rewind the file pointer to the beginning of the file")
     .method("read", &VSIFile::read,
         "Read bytes from file")
+    .method("read_multi_range", &VSIFile::read_multi_range,
+        "Read several ranges of bytes from file in one request")
     .method("write", &VSIFile::write,
         "Write bytes to file")
     .const_method("eof", &VSIFile::eof,
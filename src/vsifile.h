@@ -51,6 +51,8 @@ class VSIFile {
     Rcpp::NumericVector tell() const;
     void rewind();
     SEXP read(Rcpp::NumericVector nbytes);
+    Rcpp::List read_multi_range(Rcpp::NumericVector offsets,
+                                Rcpp::NumericVector sizes);
     Rcpp::NumericVector write(const Rcpp::RawVector& object);
     bool eof() const;
     int truncate(Rcpp::NumericVector offset);
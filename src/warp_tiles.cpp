@@ -0,0 +1,501 @@
+/* Tiled multi-source warp into an existing destination raster
+
+   The destination grid is split into tiles. The footprint of each source
+   raster is computed once as a bounding box in the destination SRS, so that
+   each tile is warped from only the sources that intersect it. Tiles are
+   warped concurrently on a pool of worker threads: for each tile, a worker
+   warps its sources (in the order given) into an in-memory dataset covering
+   the tile, initialized with the existing destination content so that
+   mosaicking semantics match GDALWarp() into an existing dataset. Each worker
+   opens its own read-only handles on the source rasters, cached by filename
+   across the tiles it processes. Output for each batch of tiles is written
+   on the main thread to the destination GDALRaster, so memory use is bounded
+   by the tile size times the number of threads.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <gdal_utils.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+#include <ogr_srs_api.h>
+
+#include <Rcpp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gdalraster.h"
+#include "rcpp_util.h"
+#include "thread_util.h"
+
+// maximum number of source dataset handles kept open by each worker thread
+constexpr std::size_t WARP_TILES_MAX_OPEN_SOURCES_ = 64;
+
+// number of points along each edge used to transform source footprints
+constexpr int WARP_TILES_DENSIFY_PTS_ = 21;
+
+struct WarpSource_ {
+    std::string filename {};
+    double xmin {0};
+    double ymin {0};
+    double xmax {0};
+    double ymax {0};
+    // false if the footprint could not be computed in the destination SRS,
+    // in which case the source is tried for every tile
+    bool has_bbox {false};
+};
+
+struct WarpTile_ {
+    int xoff {0};
+    int yoff {0};
+    int xsize {0};
+    int ysize {0};
+    std::vector<std::size_t> sources {};
+};
+
+// read-only source handles of one worker thread, opened on demand
+class SourceHandleCache_ {
+ public:
+    SourceHandleCache_() = default;
+    ~SourceHandleCache_() { clear(); }
+    SourceHandleCache_(const SourceHandleCache_ &) = delete;
+    SourceHandleCache_ &operator=(const SourceHandleCache_ &) = delete;
+
+    GDALDatasetH get(const std::string &filename) {
+        auto it = m_handles.find(filename);
+        if (it != m_handles.end())
+            return it->second;
+
+        if (m_handles.size() >= WARP_TILES_MAX_OPEN_SOURCES_)
+            clear();
+
+        GDALDatasetH hDS = GDALOpenEx(filename.c_str(),
+                                      GDAL_OF_RASTER | GDAL_OF_READONLY,
+                                      nullptr, nullptr, nullptr);
+        if (hDS == nullptr) {
+            throw std::runtime_error("failed to open source raster: " +
+                                     filename);
+        }
+        m_handles[filename] = hDS;
+        return hDS;
+    }
+
+    void clear() {
+        for (auto &h : m_handles)
+            GDALReleaseDataset(h.second);
+        m_handles.clear();
+    }
+
+ private:
+    std::map<std::string, GDALDatasetH> m_handles {};
+};
+
+// bounding box of a source raster in the destination SRS, computed from
+// points along its edges
+static bool source_bbox_(GDALDatasetH hSrcDS, OGRSpatialReferenceH hDstSRS,
+                         double *bbox) {
+
+    double gt[6] = {0, 1, 0, 0, 0, 1};
+    if (GDALGetGeoTransform(hSrcDS, gt) != CE_None)
+        return false;
+
+    const int nx = GDALGetRasterXSize(hSrcDS);
+    const int ny = GDALGetRasterYSize(hSrcDS);
+
+    std::vector<double> x, y;
+    for (int i = 0; i < WARP_TILES_DENSIFY_PTS_; ++i) {
+        const double f = static_cast<double>(i) /
+                         (WARP_TILES_DENSIFY_PTS_ - 1);
+        const double px[4] = {f * nx, f * nx, 0, static_cast<double>(nx)};
+        const double ln[4] = {0, static_cast<double>(ny), f * ny, f * ny};
+        for (int k = 0; k < 4; ++k) {
+            x.push_back(gt[0] + px[k] * gt[1] + ln[k] * gt[2]);
+            y.push_back(gt[3] + px[k] * gt[4] + ln[k] * gt[5]);
+        }
+    }
+
+    const char *pszSrcWKT = GDALGetProjectionRef(hSrcDS);
+    if (pszSrcWKT != nullptr && pszSrcWKT[0] != '\0' && hDstSRS != nullptr) {
+        OGRSpatialReferenceH hSrcSRS = OSRNewSpatialReference(pszSrcWKT);
+        if (hSrcSRS == nullptr)
+            return false;
+        OSRSetAxisMappingStrategy(hSrcSRS, OAMS_TRADITIONAL_GIS_ORDER);
+
+        bool ok = true;
+        if (!OSRIsSame(hSrcSRS, hDstSRS)) {
+            OGRCoordinateTransformationH hCT =
+                OCTNewCoordinateTransformation(hSrcSRS, hDstSRS);
+            if (hCT == nullptr) {
+                ok = false;
+            }
+            else {
+                std::vector<int> success(x.size(), FALSE);
+                OCTTransformEx(hCT, static_cast<int>(x.size()), x.data(),
+                               y.data(), nullptr, success.data());
+                OCTDestroyCoordinateTransformation(hCT);
+
+                std::vector<double> x_ok, y_ok;
+                for (std::size_t i = 0; i < x.size(); ++i) {
+                    if (success[i] && std::isfinite(x[i]) &&
+                            std::isfinite(y[i])) {
+                        x_ok.push_back(x[i]);
+                        y_ok.push_back(y[i]);
+                    }
+                }
+                x.swap(x_ok);
+                y.swap(y_ok);
+                ok = !x.empty();
+            }
+        }
+        OSRDestroySpatialReference(hSrcSRS);
+        if (!ok)
+            return false;
+    }
+
+    bbox[0] = *std::min_element(x.begin(), x.end());
+    bbox[1] = *std::min_element(y.begin(), y.end());
+    bbox[2] = *std::max_element(x.begin(), x.end());
+    bbox[3] = *std::max_element(y.begin(), y.end());
+    return true;
+}
+
+//' Warp a set of source rasters into an existing raster tile by tile
+//'
+//' Called from and documented in R/warp_tiles.R
+//' @noRd
+// [[Rcpp::export(name = ".warp_tiles")]]
+Rcpp::DataFrame warp_tiles(const Rcpp::CharacterVector &src_files,
+                           GDALRaster* const &dst_ds,
+                           const Rcpp::IntegerVector &tile_size,
+                           const Rcpp::Nullable<Rcpp::CharacterVector>
+                                &cl_arg,
+                           int num_threads, bool quiet) {
+
+    dst_ds->checkAccess_(GA_Update);
+    GDALDatasetH hDstDS = dst_ds->getGDALDatasetH_();
+
+    if (src_files.size() < 1)
+        Rcpp::stop("'src_files' must contain at least one filename");
+    if (tile_size.size() != 2 || tile_size[0] < 1 || tile_size[1] < 1)
+        Rcpp::stop("'tile_size' must contain two values > 0");
+
+    const int nx = GDALGetRasterXSize(hDstDS);
+    const int ny = GDALGetRasterYSize(hDstDS);
+    const int nbands = GDALGetRasterCount(hDstDS);
+    if (nbands < 1)
+        Rcpp::stop("the destination raster has no bands");
+
+    double dst_gt[6] = {0, 1, 0, 0, 0, 1};
+    if (GDALGetGeoTransform(hDstDS, dst_gt) != CE_None)
+        Rcpp::stop("the destination raster must have a geotransform");
+    if (dst_gt[2] != 0 || dst_gt[4] != 0)
+        Rcpp::stop("rotated destination rasters are not supported");
+
+    const std::string dst_wkt = GDALGetProjectionRef(hDstDS);
+    if (dst_wkt.empty())
+        Rcpp::stop("the destination raster must have a spatial reference");
+
+    const GDALDataType dt =
+        GDALGetRasterDataType(GDALGetRasterBand(hDstDS, 1));
+    for (int b = 2; b <= nbands; ++b) {
+        if (GDALGetRasterDataType(GDALGetRasterBand(hDstDS, b)) != dt)
+            Rcpp::stop("all destination bands must have the same data type");
+    }
+    std::vector<int> has_nodata(nbands, FALSE);
+    std::vector<double> nodata(nbands, 0);
+    for (int b = 0; b < nbands; ++b) {
+        nodata[b] = GDALGetRasterNoDataValue(
+            GDALGetRasterBand(hDstDS, b + 1), &has_nodata[b]);
+    }
+
+    // options that define the output grid are given by the destination
+    std::vector<std::string> args;
+    if (cl_arg.isNotNull()) {
+        const Rcpp::CharacterVector cl_arg_in(cl_arg);
+        const std::vector<std::string> not_allowed = {
+            "-t_srs", "-te", "-te_srs", "-tr", "-ts", "-tap", "-of", "-co",
+            "-overwrite", "-ot"};
+        for (R_xlen_t i = 0; i < cl_arg_in.size(); ++i) {
+            const std::string arg = Rcpp::as<std::string>(cl_arg_in[i]);
+            if (std::find(not_allowed.begin(), not_allowed.end(), arg) !=
+                    not_allowed.end()) {
+                Rcpp::stop("'" + arg + "' is not supported in 'cl_arg', the "
+                           "output grid is given by 'dst_ds'");
+            }
+            args.push_back(arg);
+        }
+    }
+
+    std::vector<char *> argv;
+    for (std::string &arg : args)
+        argv.push_back(&arg[0]);
+    argv.push_back(nullptr);
+
+    // check the options on the main thread, workers create their own
+    GDALWarpAppOptions *psCheckOptions =
+        GDALWarpAppOptionsNew(argv.data(), nullptr);
+    if (psCheckOptions == nullptr)
+        Rcpp::stop("failed to create warp options from 'cl_arg'");
+    GDALWarpAppOptionsFree(psCheckOptions);
+
+    // source footprints in the destination SRS
+    OGRSpatialReferenceH hDstSRS = OSRNewSpatialReference(dst_wkt.c_str());
+    if (hDstSRS == nullptr)
+        Rcpp::stop("failed to import the destination spatial reference");
+    OSRSetAxisMappingStrategy(hDstSRS, OAMS_TRADITIONAL_GIS_ORDER);
+
+    std::vector<WarpSource_> sources(src_files.size());
+    for (R_xlen_t i = 0; i < src_files.size(); ++i) {
+        WarpSource_ &src = sources[i];
+        Rcpp::CharacterVector filename(1);
+        filename[0] = src_files[i];
+        src.filename = Rcpp::as<std::string>(check_gdal_filename(filename));
+
+        GDALDatasetH hSrcDS = GDALOpenEx(src.filename.c_str(),
+                                         GDAL_OF_RASTER | GDAL_OF_READONLY,
+                                         nullptr, nullptr, nullptr);
+        if (hSrcDS == nullptr) {
+            OSRDestroySpatialReference(hDstSRS);
+            Rcpp::stop("failed to open source raster: " + src.filename);
+        }
+        double bbox[4] = {0, 0, 0, 0};
+        src.has_bbox = source_bbox_(hSrcDS, hDstSRS, bbox);
+        if (src.has_bbox) {
+            src.xmin = bbox[0];
+            src.ymin = bbox[1];
+            src.xmax = bbox[2];
+            src.ymax = bbox[3];
+        }
+        GDALReleaseDataset(hSrcDS);
+    }
+    OSRDestroySpatialReference(hDstSRS);
+
+    // destination tiles and the sources intersecting each
+    std::vector<WarpTile_> tiles;
+    for (int yoff = 0; yoff < ny; yoff += tile_size[1]) {
+        for (int xoff = 0; xoff < nx; xoff += tile_size[0]) {
+            WarpTile_ tile;
+            tile.xoff = xoff;
+            tile.yoff = yoff;
+            tile.xsize = std::min(tile_size[0], nx - xoff);
+            tile.ysize = std::min(tile_size[1], ny - yoff);
+
+            const double x0 = dst_gt[0] + xoff * dst_gt[1];
+            const double x1 = dst_gt[0] + (xoff + tile.xsize) * dst_gt[1];
+            const double y0 = dst_gt[3] + yoff * dst_gt[5];
+            const double y1 = dst_gt[3] + (yoff + tile.ysize) * dst_gt[5];
+            const double txmin = std::min(x0, x1);
+            const double txmax = std::max(x0, x1);
+            const double tymin = std::min(y0, y1);
+            const double tymax = std::max(y0, y1);
+
+            for (std::size_t s = 0; s < sources.size(); ++s) {
+                const WarpSource_ &src = sources[s];
+                if (!src.has_bbox || (src.xmin < txmax && src.xmax > txmin &&
+                                      src.ymin < tymax && src.ymax > tymin)) {
+                    tile.sources.push_back(s);
+                }
+            }
+            tiles.push_back(std::move(tile));
+        }
+    }
+
+    const std::size_t num_tiles = tiles.size();
+    std::vector<std::size_t> work;
+    for (std::size_t t = 0; t < num_tiles; ++t) {
+        if (!tiles[t].sources.empty())
+            work.push_back(t);
+    }
+
+    const int nthreads = resolve_num_threads_(num_threads, work.size());
+    const int dt_size = GDALGetDataTypeSizeBytes(dt);
+    const std::size_t max_tile_bytes =
+        static_cast<std::size_t>(tile_size[0]) * tile_size[1] * nbands *
+        dt_size;
+
+    std::vector<std::vector<unsigned char>> buffers(nthreads);
+    std::vector<SourceHandleCache_> handle_caches(nthreads);
+    std::vector<double> elapsed(num_tiles, 0);
+    GDALDriverH hMemDrv = GDALGetDriverByName("MEM");
+    if (hMemDrv == nullptr)
+        Rcpp::stop("failed to get the MEM driver");
+
+    // runs on worker threads: must not call into R
+    auto warp_tile = [&](const WarpTile_ &tile,
+                         std::vector<unsigned char> &buf, int thread_idx) {
+
+        GDALDatasetH hTileDS = GDALCreate(hMemDrv, "", tile.xsize, tile.ysize,
+                                          nbands, dt, nullptr);
+        if (hTileDS == nullptr) {
+            throw std::runtime_error(std::string("failed to create tile: ") +
+                                     CPLGetLastErrorMsg());
+        }
+        double tile_gt[6] = {dst_gt[0] + tile.xoff * dst_gt[1], dst_gt[1], 0,
+                             dst_gt[3] + tile.yoff * dst_gt[5], 0, dst_gt[5]};
+        GDALSetGeoTransform(hTileDS, tile_gt);
+        GDALSetProjection(hTileDS, dst_wkt.c_str());
+        for (int b = 0; b < nbands; ++b) {
+            if (has_nodata[b]) {
+                GDALSetRasterNoDataValue(GDALGetRasterBand(hTileDS, b + 1),
+                                         nodata[b]);
+            }
+        }
+
+        CPLErr err = GDALDatasetRasterIO(
+            hTileDS, GF_Write, 0, 0, tile.xsize, tile.ysize, buf.data(),
+            tile.xsize, tile.ysize, dt, nbands, nullptr, 0, 0, 0);
+
+        std::vector<GDALDatasetH> src_hDS;
+        if (err == CE_None) {
+            try {
+                for (std::size_t s : tile.sources)
+                    src_hDS.push_back(
+                        handle_caches[thread_idx].get(sources[s].filename));
+            }
+            catch (...) {
+                GDALClose(hTileDS);
+                throw;
+            }
+
+            GDALWarpAppOptions *psOptions =
+                GDALWarpAppOptionsNew(argv.data(), nullptr);
+            if (psOptions == nullptr) {
+                err = CE_Failure;
+            }
+            else {
+                int usage_error = FALSE;
+                GDALDatasetH hOut = GDALWarp(
+                    nullptr, hTileDS, static_cast<int>(src_hDS.size()),
+                    src_hDS.data(), psOptions, &usage_error);
+                GDALWarpAppOptionsFree(psOptions);
+                if (hOut == nullptr)
+                    err = CE_Failure;
+            }
+        }
+
+        if (err == CE_None) {
+            err = GDALDatasetRasterIO(
+                hTileDS, GF_Read, 0, 0, tile.xsize, tile.ysize, buf.data(),
+                tile.xsize, tile.ysize, dt, nbands, nullptr, 0, 0, 0);
+        }
+
+        if (err != CE_None) {
+            const std::string msg = CPLGetLastErrorMsg();
+            GDALClose(hTileDS);
+            throw std::runtime_error("warp failed for tile at (" +
+                                     std::to_string(tile.xoff) + ", " +
+                                     std::to_string(tile.yoff) + "): " + msg);
+        }
+        GDALClose(hTileDS);
+    };
+
+    if (!quiet) {
+        cli_alert_info_("warping " + std::to_string(src_files.size()) +
+                        " source(s) into " + std::to_string(work.size()) +
+                        " tile(s) using " + std::to_string(nthreads) +
+                        " thread(s)...");
+        GDALTermProgressR(0.0, nullptr, nullptr);
+    }
+
+    const std::size_t num_work = work.size();
+    for (std::size_t batch_start = 0; batch_start < num_work;
+            batch_start += nthreads) {
+
+        const std::size_t batch_size =
+            std::min(static_cast<std::size_t>(nthreads),
+                     num_work - batch_start);
+
+        // the existing destination content is the starting point of each
+        // tile, as for GDALWarp() into an existing dataset
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const WarpTile_ &tile = tiles[work[batch_start + i]];
+            std::vector<unsigned char> &buf = buffers[i];
+            buf.resize(max_tile_bytes);
+            CPLErr err = GDALDatasetRasterIO(
+                hDstDS, GF_Read, tile.xoff, tile.yoff, tile.xsize, tile.ysize,
+                buf.data(), tile.xsize, tile.ysize, dt, nbands, nullptr, 0, 0,
+                0);
+            if (err != CE_None)
+                Rcpp::stop("failed to read from the destination raster");
+        }
+
+        try {
+            parallel_for_(batch_size, std::min(nthreads,
+                                               static_cast<int>(batch_size)),
+                [&](std::size_t i, int thread_idx) {
+                    // buffers are indexed by position in the batch, source
+                    // handles by thread
+                    const std::size_t t = work[batch_start + i];
+                    const auto t0 = std::chrono::steady_clock::now();
+                    warp_tile(tiles[t], buffers[i], thread_idx);
+                    const std::chrono::duration<double> dur =
+                        std::chrono::steady_clock::now() - t0;
+                    elapsed[t] = dur.count();
+                });
+        }
+        catch (const std::exception &e) {
+            Rcpp::stop(e.what());
+        }
+
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            const WarpTile_ &tile = tiles[work[batch_start + i]];
+            CPLErr err = GDALDatasetRasterIO(
+                hDstDS, GF_Write, tile.xoff, tile.yoff, tile.xsize,
+                tile.ysize, buffers[i].data(), tile.xsize, tile.ysize, dt,
+                nbands, nullptr, 0, 0, 0);
+            if (err != CE_None)
+                Rcpp::stop("failed to write to the destination raster");
+        }
+
+        if (!quiet) {
+            GDALTermProgressR(
+                static_cast<double>(batch_start + batch_size) / num_work,
+                nullptr, nullptr);
+        }
+        Rcpp::checkUserInterrupt();
+    }
+
+    if (!quiet && num_work == 0)
+        GDALTermProgressR(1.0, nullptr, nullptr);
+
+    Rcpp::IntegerVector tile_id(num_tiles), xoff(num_tiles), yoff(num_tiles),
+                        xsize(num_tiles), ysize(num_tiles),
+                        num_sources(num_tiles);
+    Rcpp::NumericVector elapsed_out(num_tiles), mpix_per_sec(num_tiles);
+    for (std::size_t t = 0; t < num_tiles; ++t) {
+        const WarpTile_ &tile = tiles[t];
+        tile_id[t] = static_cast<int>(t + 1);
+        xoff[t] = tile.xoff;
+        yoff[t] = tile.yoff;
+        xsize[t] = tile.xsize;
+        ysize[t] = tile.ysize;
+        num_sources[t] = static_cast<int>(tile.sources.size());
+        elapsed_out[t] = elapsed[t];
+        if (tile.sources.empty() || elapsed[t] <= 0) {
+            mpix_per_sec[t] = NA_REAL;
+        }
+        else {
+            mpix_per_sec[t] = static_cast<double>(tile.xsize) * tile.ysize /
+                              1e6 / elapsed[t];
+        }
+    }
+
+    return Rcpp::DataFrame::create(
+        Rcpp::Named("tile") = tile_id,
+        Rcpp::Named("xoff") = xoff,
+        Rcpp::Named("yoff") = yoff,
+        Rcpp::Named("xsize") = xsize,
+        Rcpp::Named("ysize") = ysize,
+        Rcpp::Named("num_sources") = num_sources,
+        Rcpp::Named("elapsed") = elapsed_out,
+        Rcpp::Named("mpix_per_sec") = mpix_per_sec);
+}
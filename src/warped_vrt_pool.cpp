@@ -0,0 +1,165 @@
+/* Process-wide pool of warped virtual datasets
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include "warped_vrt_pool.h"
+
+#include <gdal.h>
+
+#include <Rcpp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+WarpedVRTPool_ &WarpedVRTPool_::instance() {
+    // never destroyed, datasets are released by clear() at package unload
+    static WarpedVRTPool_ *pool = new WarpedVRTPool_();
+    return *pool;
+}
+
+GDALDatasetH WarpedVRTPool_::acquire(
+        const std::string &key,
+        const std::function<GDALDatasetH()> &create_fn) {
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GDALDatasetH hDS = m_pool.takeIdle(key);
+        if (hDS != nullptr) {
+            m_hits += 1;
+            return hDS;
+        }
+        m_misses += 1;
+    }
+
+    GDALDatasetH hDS = create_fn();
+    if (hDS == nullptr)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    HandlePoolEntry_ entry;
+    entry.key = key;
+    entry.hDS = hDS;
+    // the pool takes its own reference
+    m_pool.add(std::move(entry));
+    m_evictions += m_pool.trimIdle(m_max_idle);
+    return hDS;
+}
+
+void WarpedVRTPool_::release(GDALDatasetH hDS) {
+    if (hDS == nullptr)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    HandlePoolEntry_ *entry = m_pool.find(hDS);
+    if (entry != nullptr)
+        m_pool.giveBack(entry);
+    else
+        GDALReleaseDataset(hDS);
+    m_evictions += m_pool.trimIdle(m_max_idle);
+}
+
+void WarpedVRTPool_::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pool.clear(true);
+}
+
+void WarpedVRTPool_::setMaxIdle(std::size_t max_idle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_idle = max_idle;
+    m_evictions += m_pool.trimIdle(m_max_idle);
+}
+
+WarpedVRTPoolStats_ WarpedVRTPool_::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WarpedVRTPoolStats_ s;
+    s.size = m_pool.size();
+    s.in_use = m_pool.inUse();
+    s.max_idle = m_max_idle;
+    s.hits = m_hits;
+    s.misses = m_misses;
+    s.evictions = m_evictions;
+    return s;
+}
+
+//' Manage the pool of warped virtual datasets
+//'
+//' `autoCreateWarpedVRT()` called with `use_pool = TRUE` reuses warped
+//' virtual datasets from a pool kept for the R session, instead of creating a
+//' new one each time. These functions return information about the pool, set
+//' its capacity and clear it.
+//'
+//' @name warped_vrt_pool
+//'
+//' @details
+//' Pooled datasets are keyed by the source filename, the target and source
+//' SRS, the resampling method, the maximum approximation error and whether an
+//' alpha band is added. A pooled dataset is in use while a `GDALRaster` object
+//' returned by `autoCreateWarpedVRT()` holds it, and is returned to the pool
+//' when the object is closed. A dataset in use is never handed out again
+//' until it is returned, so each holder has exclusive use of its dataset.
+//'
+//' `warped_vrt_pool_info()` returns information about the pool.
+//'
+//' `warped_vrt_pool_set_size()` sets the maximum number of idle datasets kept
+//' in the pool (`16` by default). The least recently used idle datasets
+//' beyond this number are closed.
+//'
+//' `warped_vrt_pool_clear()` closes all idle datasets and empties the pool.
+//' Datasets in use remain valid until their `GDALRaster` object is closed.
+//'
+//' @param max_idle Integer maximum number of idle datasets kept in the pool.
+//' @returns
+//' `warped_vrt_pool_info()` returns a list with elements `size` (number of
+//' pooled datasets), `in_use` (number of pooled datasets currently held),
+//' `max_idle` (the pool capacity), `hits` (number of requests served from the
+//' pool), `misses` (number of requests that created a new dataset) and
+//' `evictions` (number of idle datasets closed to keep within capacity).
+//'
+//' `warped_vrt_pool_set_size()` and `warped_vrt_pool_clear()` return
+//' `NULL` invisibly.
+//'
+//' @seealso
+//' [autoCreateWarpedVRT()]
+//'
+//' @examples
+//' elev_file <- system.file("extdata/storml_elev.tif", package="gdalraster")
+//' ds <- new(GDALRaster, elev_file)
+//'
+//' for (i in 1:3) {
+//'   ds_warped <- autoCreateWarpedVRT(ds, epsg_to_wkt(5070), "Bilinear",
+//'                                    use_pool = TRUE)
+//'   v <- ds_warped$read(1, 0, 0, 10, 10, 10, 10)
+//'   ds_warped$close()
+//' }
+//' warped_vrt_pool_info()
+//'
+//' warped_vrt_pool_clear()
+//' ds$close()
+// [[Rcpp::export]]
+Rcpp::List warped_vrt_pool_info() {
+    const WarpedVRTPoolStats_ s = WarpedVRTPool_::instance().stats();
+    return Rcpp::List::create(
+        Rcpp::Named("size") = static_cast<double>(s.size),
+        Rcpp::Named("in_use") = static_cast<double>(s.in_use),
+        Rcpp::Named("max_idle") = static_cast<double>(s.max_idle),
+        Rcpp::Named("hits") = static_cast<double>(s.hits),
+        Rcpp::Named("misses") = static_cast<double>(s.misses),
+        Rcpp::Named("evictions") = static_cast<double>(s.evictions));
+}
+
+//' @rdname warped_vrt_pool
+// [[Rcpp::export(invisible = true)]]
+void warped_vrt_pool_set_size(int max_idle) {
+    if (max_idle == NA_INTEGER || max_idle < 0)
+        Rcpp::stop("'max_idle' must be a single value >= 0");
+    WarpedVRTPool_::instance().setMaxIdle(static_cast<std::size_t>(max_idle));
+}
+
+//' @rdname warped_vrt_pool
+// [[Rcpp::export(invisible = true)]]
+void warped_vrt_pool_clear() {
+    WarpedVRTPool_::instance().clear();
+}
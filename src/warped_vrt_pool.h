@@ -0,0 +1,82 @@
+/* Process-wide pool of warped virtual datasets
+
+   Creating a warped VRT with GDALAutoCreateWarpedVRT() computes the output
+   grid, creates the transformer and fits the approximate transformer, which
+   is a significant cost when the same warp is repeated for each request of
+   e.g. a tile server. WarpedVRTPool_ keeps the warped datasets it has
+   created, keyed by source filename, target/source SRS, resampling method,
+   approximation error and alpha band, and hands them out again instead of
+   creating a new one.
+
+   Pooled datasets are reference counted. The pool holds one reference, and
+   acquire() adds one for the caller, who gives it up with
+   GDALReleaseDataset() (e.g., by closing the GDALRaster object). A dataset is
+   idle when the pool holds the only reference, and only idle datasets are
+   handed out, so a dataset is never used by two holders at once: concurrent
+   requests for the same key get separate datasets. The least recently used
+   idle datasets beyond the pool capacity are closed. Pool operations are
+   guarded by a mutex. Holders on threads other than the main R thread must
+   return their dataset with release() rather than GDALReleaseDataset(), so
+   that reference counts are only changed under the mutex. The bookkeeping
+   of the pooled datasets is done by HandlePool_ (handle_pool.h).
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#ifndef WARPED_VRT_POOL_H_
+#define WARPED_VRT_POOL_H_
+
+#include <gdal.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "handle_pool.h"
+
+struct WarpedVRTPoolStats_ {
+    std::size_t size = 0;
+    std::size_t in_use = 0;
+    std::size_t max_idle = 0;
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t evictions = 0;
+};
+
+class WarpedVRTPool_ {
+ public:
+    static WarpedVRTPool_ &instance();
+
+    // Returns a dataset for key, either an idle pooled dataset or a new one
+    // from create_fn (which returns nullptr on error, called without the lock
+    // held). The caller owns one reference on the returned dataset.
+    GDALDatasetH acquire(const std::string &key,
+                         const std::function<GDALDatasetH()> &create_fn);
+
+    // Gives up a reference obtained from acquire().
+    void release(GDALDatasetH hDS);
+
+    // Drops the pool references on all datasets. Datasets in use stay valid
+    // until released by their holders.
+    void clear();
+
+    void setMaxIdle(std::size_t max_idle);
+    WarpedVRTPoolStats_ stats() const;
+
+ private:
+    WarpedVRTPool_() = default;
+    WarpedVRTPool_(const WarpedVRTPool_ &) = delete;
+    WarpedVRTPool_ &operator=(const WarpedVRTPool_ &) = delete;
+
+    mutable std::mutex m_mutex;
+    HandlePool_<RefCount_> m_pool {};
+    std::size_t m_max_idle {16};
+    int64_t m_hits {0};
+    int64_t m_misses {0};
+    int64_t m_evictions {0};
+};
+
+#endif  // WARPED_VRT_POOL_H_
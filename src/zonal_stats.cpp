@@ -0,0 +1,343 @@
+/* Zonal statistics for the polygons of a vector layer
+
+   Raster values are read only for the window covering the envelope of each
+   polygon, and the polygon is burned in memory using the scanline fill in
+   src/r_rasterize.h (a pixel is inside if its center is inside the polygon).
+   Polygon geometries are read from the layer on the main thread. Statistics
+   are computed for the features on a pool of worker threads, each using its
+   own read-only handle on the raster dataset.
+
+   Chris Toney <chris.toney at usda.gov>
+   Copyright (c) 2023-2025 gdalraster authors
+*/
+
+#include <gdal.h>
+#include <cpl_conv.h>
+#include <cpl_error.h>
+#include <ogr_api.h>
+#include <ogr_core.h>
+
+#include <Rcpp.h>
+#include <RcppInt64>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gdalraster.h"
+#include "gdalvector.h"
+#include "r_rasterize.h"
+#include "rcpp_util.h"
+#include "running_stats.h"
+#include "thread_util.h"
+
+// maximum number of pixels per read of a polygon window, for each thread
+constexpr int64_t ZONAL_MAX_STRIP_PIXELS_ = 4194304;
+
+struct ZonePolygon_ {
+    int64_t fid {0};
+    // raster window covering the polygon envelope
+    int xoff {0};
+    int yoff {0};
+    int xsize {0};
+    int ysize {0};
+    // ring vertices in pixel/line coordinates relative to the window
+    std::vector<int> part_sizes {};
+    std::vector<double> x {};
+    std::vector<double> y {};
+};
+
+// append the rings of a polygon as pixel/line coordinates
+static void add_polygon_rings_(OGRGeometryH hPoly, const double *inv_gt,
+                               ZonePolygon_ *zone) {
+
+    const int nRings = OGR_G_GetGeometryCount(hPoly);
+    for (int i = 0; i < nRings; ++i) {
+        OGRGeometryH hRing = OGR_G_GetGeometryRef(hPoly, i);
+        if (hRing == nullptr)
+            continue;
+        const int nPoints = OGR_G_GetPointCount(hRing);
+        if (nPoints < 3)
+            continue;
+        zone->part_sizes.push_back(nPoints);
+        for (int j = 0; j < nPoints; ++j) {
+            const double geo_x = OGR_G_GetX(hRing, j);
+            const double geo_y = OGR_G_GetY(hRing, j);
+            zone->x.push_back(inv_gt[0] + geo_x * inv_gt[1] +
+                              geo_y * inv_gt[2]);
+            zone->y.push_back(inv_gt[3] + geo_x * inv_gt[4] +
+                              geo_y * inv_gt[5]);
+        }
+    }
+}
+
+// set up the zone for a feature geometry, given the raster dimensions
+static void set_zone_geometry_(OGRGeometryH hGeom, const double *inv_gt,
+                               int raster_xsize, int raster_ysize,
+                               ZonePolygon_ *zone) {
+
+    if (hGeom == nullptr || OGR_G_IsEmpty(hGeom))
+        return;
+
+    OGRGeometryH hLinear = nullptr;
+    OGRwkbGeometryType eType = wkbFlatten(OGR_G_GetGeometryType(hGeom));
+    if (eType != wkbPolygon && eType != wkbMultiPolygon) {
+        if (OGR_GT_IsSurface(eType) ||
+                OGR_GT_IsSubClassOf(eType, wkbMultiSurface)) {
+            hLinear = OGR_G_ForceToMultiPolygon(OGR_G_Clone(hGeom));
+            if (hLinear == nullptr)
+                return;
+            hGeom = hLinear;
+            eType = wkbFlatten(OGR_G_GetGeometryType(hGeom));
+        }
+        else {
+            // not a polygon
+            return;
+        }
+    }
+
+    if (eType == wkbPolygon) {
+        add_polygon_rings_(hGeom, inv_gt, zone);
+    }
+    else if (eType == wkbMultiPolygon) {
+        for (int i = 0; i < OGR_G_GetGeometryCount(hGeom); ++i) {
+            add_polygon_rings_(OGR_G_GetGeometryRef(hGeom, i), inv_gt, zone);
+        }
+    }
+
+    if (hLinear != nullptr)
+        OGR_G_DestroyGeometry(hLinear);
+
+    if (zone->x.empty())
+        return;
+
+    const auto [minx, maxx] = std::minmax_element(zone->x.cbegin(),
+                                                  zone->x.cend());
+    const auto [miny, maxy] = std::minmax_element(zone->y.cbegin(),
+                                                  zone->y.cend());
+
+    const double xoff = std::max(0.0, std::floor(*minx));
+    const double yoff = std::max(0.0, std::floor(*miny));
+    const double xend = std::min(static_cast<double>(raster_xsize),
+                                 std::ceil(*maxx));
+    const double yend = std::min(static_cast<double>(raster_ysize),
+                                 std::ceil(*maxy));
+
+    if (xend <= xoff || yend <= yoff) {
+        // envelope does not intersect the raster
+        zone->part_sizes.clear();
+        zone->x.clear();
+        zone->y.clear();
+        return;
+    }
+
+    zone->xoff = static_cast<int>(xoff);
+    zone->yoff = static_cast<int>(yoff);
+    zone->xsize = static_cast<int>(xend - xoff);
+    zone->ysize = static_cast<int>(yend - yoff);
+
+    for (double &v : zone->x)
+        v -= xoff;
+    for (double &v : zone->y)
+        v -= yoff;
+}
+
+// compute statistics for one zone, reading the polygon window in strips
+// runs on a worker thread: must not call into R
+static RunningStatsAccum_ compute_zone_stats_(const ZonePolygon_ &zone,
+                                              GDALRasterBandH hBand,
+                                              std::vector<double> *buf) {
+
+    RunningStatsAccum_ stats;
+    if (zone.x.empty() || zone.xsize < 1 || zone.ysize < 1)
+        return stats;
+
+    int has_nodata = FALSE;
+    const double nodata = GDALGetRasterNoDataValue(hBand, &has_nodata);
+    const bool check_nodata = has_nodata && !std::isnan(nodata);
+
+    const int strip_rows = static_cast<int>(std::max<int64_t>(
+        1, std::min<int64_t>(zone.ysize,
+                             ZONAL_MAX_STRIP_PIXELS_ / zone.xsize)));
+
+    int strip_yoff = -1;
+    int strip_nrows = 0;
+
+    rasterize_polygon_scanlines_(
+        zone.xsize, zone.ysize, zone.part_sizes, zone.x.data(), zone.y.data(),
+        zone.x.size(),
+        [&](int y, int x1, int x2) {
+            if (strip_yoff < 0 || y >= strip_yoff + strip_nrows) {
+                strip_yoff = y;
+                strip_nrows = std::min(strip_rows, zone.ysize - y);
+                buf->resize(static_cast<std::size_t>(zone.xsize) *
+                            strip_nrows);
+
+                CPLErr err = GDALRasterIO(
+                    hBand, GF_Read, zone.xoff, zone.yoff + strip_yoff,
+                    zone.xsize, strip_nrows, buf->data(), zone.xsize,
+                    strip_nrows, GDT_Float64, 0, 0);
+
+                if (err != CE_None) {
+                    throw std::runtime_error(
+                        std::string("read raster failed: ") +
+                        CPLGetLastErrorMsg());
+                }
+            }
+
+            const double *row = buf->data() +
+                static_cast<std::size_t>(y - strip_yoff) * zone.xsize;
+
+            for (int x = x1; x <= x2; ++x) {
+                const double v = row[x];
+                if (std::isnan(v) || (check_nodata && v == nodata))
+                    continue;
+                stats.update(v);
+            }
+        });
+
+    return stats;
+}
+
+//' Compute zonal statistics for the polygons of a vector layer
+//'
+//' Called from and documented in R/zonal_stats.R
+//' @noRd
+// [[Rcpp::export(name = ".zonal_stats")]]
+Rcpp::DataFrame zonal_stats(const GDALVector* const &lyr,
+                            const GDALRaster* const &ds, int band,
+                            int num_threads, bool quiet) {
+
+    if (!lyr->isOpen())
+        Rcpp::stop("the vector layer is not open");
+
+    ds->checkAccess_(GA_ReadOnly);
+    ds->getBand_(band);
+
+    const int raster_xsize = static_cast<int>(ds->getRasterXSize());
+    const int raster_ysize = static_cast<int>(ds->getRasterYSize());
+
+    Rcpp::NumericVector gt = ds->getGeoTransform();
+    double inv_gt[6] = {0};
+    if (!GDALInvGeoTransform(gt.begin(), inv_gt))
+        Rcpp::stop("failed to invert the raster geotransform");
+
+    // read polygons on the main thread
+    OGRLayerH hLayer = lyr->getOGRLayerH_();
+    if (hLayer == nullptr)
+        Rcpp::stop("failed to obtain the OGRLayer handle");
+
+    if (!quiet)
+        cli_alert_info_("reading polygons...");
+
+    std::vector<ZonePolygon_> zones;
+    const GIntBig nFeatures = OGR_L_GetFeatureCount(hLayer, FALSE);
+    if (nFeatures > 0)
+        zones.reserve(static_cast<std::size_t>(nFeatures));
+
+    OGR_L_ResetReading(hLayer);
+    OGRFeatureH hFeat = nullptr;
+    while ((hFeat = OGR_L_GetNextFeature(hLayer)) != nullptr) {
+        ZonePolygon_ zone;
+        zone.fid = static_cast<int64_t>(OGR_F_GetFID(hFeat));
+        set_zone_geometry_(OGR_F_GetGeometryRef(hFeat), inv_gt, raster_xsize,
+                           raster_ysize, &zone);
+        zones.push_back(std::move(zone));
+        OGR_F_Destroy(hFeat);
+
+        if (zones.size() % 10000 == 0)
+            Rcpp::checkUserInterrupt();
+    }
+    OGR_L_ResetReading(hLayer);
+
+    const std::size_t num_zones = zones.size();
+    std::vector<RunningStatsAccum_> results(num_zones);
+
+    int nthreads = resolve_num_threads_(num_threads, num_zones);
+    std::unique_ptr<WorkerDatasets_> worker_ds = nullptr;
+    if (nthreads > 1) {
+        worker_ds = std::make_unique<WorkerDatasets_>(ds, nthreads);
+        if (worker_ds->empty()) {
+            if (!quiet)
+                cli_alert_info_("the raster dataset cannot be reopened for "
+                                "multi-threaded read, using one thread");
+            nthreads = 1;
+        }
+    }
+
+    std::vector<std::vector<double>> buffers(nthreads);
+
+    auto process_zone = [&](std::size_t i, int thread_idx) {
+        GDALDatasetH hDS = nthreads > 1 ? worker_ds->get(thread_idx)
+                                        : ds->getGDALDatasetH_();
+        GDALRasterBandH hBand = GDALGetRasterBand(hDS, band);
+        if (hBand == nullptr)
+            throw std::runtime_error("failed to access the requested band");
+
+        results[i] = compute_zone_stats_(zones[i], hBand, &buffers[thread_idx]);
+        // release the vertices as we go
+        std::vector<double>().swap(zones[i].x);
+        std::vector<double>().swap(zones[i].y);
+    };
+
+    if (!quiet) {
+        cli_alert_info_("computing statistics for " +
+                        std::to_string(num_zones) + " feature(s) using " +
+                        std::to_string(nthreads) + " thread(s)...");
+        GDALTermProgressR(0.0, nullptr, nullptr);
+    }
+
+    try {
+        parallel_for_(num_zones, nthreads, process_zone,
+            [quiet](double frac) {
+                if (!quiet)
+                    GDALTermProgressR(frac, nullptr, nullptr);
+            });
+    }
+    catch (const std::exception &e) {
+        Rcpp::stop(e.what());
+    }
+
+    std::vector<int64_t> fid(num_zones);
+    Rcpp::NumericVector count = Rcpp::no_init(num_zones);
+    Rcpp::NumericVector sum = Rcpp::no_init(num_zones);
+    Rcpp::NumericVector mean = Rcpp::no_init(num_zones);
+    Rcpp::NumericVector min = Rcpp::no_init(num_zones);
+    Rcpp::NumericVector max = Rcpp::no_init(num_zones);
+    Rcpp::NumericVector sd = Rcpp::no_init(num_zones);
+
+    for (std::size_t i = 0; i < num_zones; ++i) {
+        const RunningStatsAccum_ &s = results[i];
+        fid[i] = zones[i].fid;
+        count[i] = static_cast<double>(s.count);
+        if (s.count > 0) {
+            sum[i] = s.sum;
+            mean[i] = s.mean;
+            min[i] = s.min;
+            max[i] = s.max;
+        }
+        else {
+            sum[i] = NA_REAL;
+            mean[i] = NA_REAL;
+            min[i] = NA_REAL;
+            max[i] = NA_REAL;
+        }
+        sd[i] = s.count > 1 ? std::sqrt(s.var()) : NA_REAL;
+    }
+
+    Rcpp::DataFrame df_out = Rcpp::DataFrame::create();
+    df_out.push_back(Rcpp::wrap(fid), "FID");
+    df_out.push_back(count, "count");
+    df_out.push_back(sum, "sum");
+    df_out.push_back(mean, "mean");
+    df_out.push_back(min, "min");
+    df_out.push_back(max, "max");
+    df_out.push_back(sd, "sd");
+
+    return df_out;
+}